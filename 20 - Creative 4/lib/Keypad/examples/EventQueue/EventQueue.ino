@@ -0,0 +1,67 @@
+/* @file EventQueue.ino
+|| @description
+|| | Keeps every key event while the sketch is busy in delay(). The
+|| | keypad is scanned from yield(), which delay() calls while it waits,
+|| | and each change goes into a KeypadEventQueue. Two readers take
+|| | their own copy: one collects the keys pressed, the other logs every
+|| | state change with its time.
+|| #
+*/
+#include <Keypad.h>
+
+const byte ROWS = 4; //four rows
+const byte COLS = 3; //three columns
+char keys[ROWS][COLS] = {
+	{'1','2','3'},
+	{'4','5','6'},
+	{'7','8','9'},
+	{'*','0','#'}
+};
+byte rowPins[ROWS] = {5, 4, 3, 2}; //connect to the row pinouts of the keypad
+byte colPins[COLS] = {8, 7, 6}; //connect to the column pinouts of the keypad
+
+Keypad kpd = Keypad( makeKeymap(keys), rowPins, colPins, ROWS, COLS );
+
+KeypadEventRecord records[16];
+KeypadEventQueue events(records, 16, KEYPAD_OVERWRITE_OLDEST);
+KeypadEventReader pressedKeys(events);
+KeypadEventReader eventLog(events);
+
+// delay() runs this while it waits.
+void yield() {
+	kpd.getKeys();
+}
+
+void setup(){
+	Serial.begin(9600);
+	kpd.setEventQueue(&events);
+}
+
+void loop(){
+	kpd.getKeys();
+
+	KeypadEventRecord event;
+	while (pressedKeys.read(event)) {
+		if (event.kstate == PRESSED) {
+			Serial.print("Pressed: ");
+			Serial.println(event.kchar);
+			delay(500);		// Busy, as when playing a tone; keys pressed now are still kept.
+		}
+	}
+
+	while (eventLog.read(event)) {
+		Serial.print(event.time);
+		Serial.print(" ms ");
+		Serial.print(event.kchar);
+		switch (event.kstate) {
+			case IDLE: Serial.println(" IDLE"); break;
+			case PRESSED: Serial.println(" PRESSED"); break;
+			case HOLD: Serial.println(" HOLD"); break;
+			case RELEASED: Serial.println(" RELEASED"); break;
+		}
+	}
+	if (eventLog.lost()) {
+		Serial.print(eventLog.lost());
+		Serial.println(" events lost");
+	}
+}
@@ -0,0 +1,128 @@
+/* @file ScanBenchmark.ino
+|| @description
+|| | Counts the CPU cycles of a getKeys() scan of a 4x4 keypad, first
+|| | with the default per-pin scan, then through KeypadAvrPort and then
+|| | with a StaticKeypad on the same pins.
+|| | Timer1 runs at the CPU clock and interrupts are off while a scan
+|| | is timed, so the counts are exact. Then prints the SRAM each
+|| | keypad takes, as this build lays it out. AVR boards only.
+|| #
+*/
+#include <Keypad.h>
+#include <KeypadAvrPort.h>
+#include <StaticKeypad.h>
+
+#if !defined(__AVR__)
+#error "ScanBenchmark counts cycles with the AVR Timer1"
+#endif
+
+const byte ROWS = 4; //four rows
+const byte COLS = 4; //four columns
+char keys[ROWS][COLS] = {
+	{'1','2','3','A'},
+	{'4','5','6','B'},
+	{'7','8','9','C'},
+	{'*','0','#','D'}
+};
+byte rowPins[ROWS] = {9, 8, 7, 6}; //connect to the row pinouts of the keypad
+byte colPins[COLS] = {5, 4, 3, 2}; //connect to the column pinouts of the keypad
+
+Keypad kpd = Keypad( makeKeymap(keys), rowPins, colPins, ROWS, COLS );
+KeypadAvrPort port;
+
+const char staticKeys[ROWS][COLS] PROGMEM = {
+	{'1','2','3','A'},
+	{'4','5','6','B'},
+	{'7','8','9','C'},
+	{'*','0','#','D'}
+};
+StaticKeypad< KeypadPins<9, 8, 7, 6>, KeypadPins<5, 4, 3, 2>, staticKeys > staticKpd;
+
+bool scanKpd() { return kpd.getKeys(); }
+bool scanStaticKpd() { return staticKpd.getKeys(); }
+
+const int RUNS = 500;
+
+// Cycles of one getKeys() call that scans.
+unsigned int timeScan(bool (*scan)()) {
+	// getKeys() only scans once the debounce time has passed.
+	unsigned long start = millis();
+	while (millis() - start < 3);
+
+	uint8_t oldSREG = SREG;
+	cli();
+	TCNT1 = 0;
+	scan();
+	unsigned int cycles = TCNT1;
+	SREG = oldSREG;
+	return cycles;
+}
+
+// Cycles of reading TCNT1 back straight away, taken off every count.
+unsigned int timeNothing() {
+	uint8_t oldSREG = SREG;
+	cli();
+	TCNT1 = 0;
+	unsigned int cycles = TCNT1;
+	SREG = oldSREG;
+	return cycles;
+}
+
+unsigned long report(const char *name, bool (*scan)(), unsigned int overhead) {
+	unsigned int least = 0xFFFF;
+	unsigned int most = 0;
+	unsigned long total = 0;
+	for (int i=0; i<RUNS; i++) {
+		unsigned int cycles = timeScan(scan) - overhead;
+		least = min(least, cycles);
+		most = max(most, cycles);
+		total += cycles;
+	}
+
+	Serial.print(name);
+	Serial.print(" min ");
+	Serial.print(least);
+	Serial.print(" avg ");
+	Serial.print(total / RUNS);
+	Serial.print(" max ");
+	Serial.print(most);
+	Serial.print(" cycles, ");
+	Serial.print(total / RUNS / (F_CPU / 1000000UL));
+	Serial.println(" us");
+	return total / RUNS;
+}
+
+void setup(){
+	Serial.begin(9600);
+	kpd.setDebounceTime(1);
+	staticKpd.setDebounceTime(1);
+
+	// Timer1 counting every CPU clock
+	TCCR1A = 0;
+	TCCR1B = _BV(CS10);
+	unsigned int overhead = timeNothing();
+
+	Serial.println("getKeys() of a 4x4 keypad, no keys pressed:");
+	unsigned long pins = report("pin functions ", scanKpd, overhead);
+	kpd.setBus(&port);
+	unsigned long ports = report("KeypadAvrPort ", scanKpd, overhead);
+	unsigned long fixed = report("StaticKeypad  ", scanStaticKpd, overhead);
+
+	// All include updateList(), so the difference is mostly in the scan.
+	Serial.print("saved ");
+	Serial.print(pins - ports);
+	Serial.print(" cycles a scan with KeypadAvrPort, ");
+	Serial.print(pins - fixed);
+	Serial.println(" with StaticKeypad");
+
+	// Keypad also needs its keymap and pin arrays in SRAM, and its vtable
+	// in .data, which sizeof() can't see. StaticKeypad needs none of them.
+	Serial.print("SRAM: Keypad ");
+	Serial.print(sizeof(kpd) + sizeof(keys) + sizeof(rowPins) + sizeof(colPins));
+	Serial.print(" bytes with keymap and pins, not counting its vtable, StaticKeypad ");
+	Serial.print(sizeof(staticKpd));
+	Serial.println(" bytes");
+}
+
+void loop(){
+}
@@ -0,0 +1,30 @@
+/* @file StaticKeypad.ino
+|| @description
+|| | HelloKeypad with StaticKeypad: the pins and keymap are part of the
+|| | keypad's type, so they take no SRAM and the scan needs no pin
+|| | arrays. The keymap has to be a const array outside any function.
+|| #
+*/
+#include <StaticKeypad.h>
+
+const char keys[4][3] PROGMEM = {
+  {'1','2','3'},
+  {'4','5','6'},
+  {'7','8','9'},
+  {'*','0','#'}
+};
+
+// Row pins, then column pins, then the keymap.
+StaticKeypad< KeypadPins<5, 4, 3, 2>, KeypadPins<8, 7, 6>, keys > keypad;
+
+void setup(){
+  Serial.begin(9600);
+}
+  
+void loop(){
+  char key = keypad.getKey();
+  
+  if (key){
+    Serial.println(key);
+  }
+}
@@ -40,12 +40,8 @@ Keypad::Keypad(char *userKeymap, byte *row, byte *col, byte numRows, byte numCol
 
 	begin(userKeymap);
 
-	setDebounceTime(10);
-	setHoldTime(500);
-	keypadEventListener = 0;
-
-	startTime = 0;
-	single_key = false;
+	setDebounceSamples(0);
+	bus = 0;
 }
 
 // Let the user define a keymap - assume the same row/column count as defined in constructor
@@ -53,34 +49,36 @@ void Keypad::begin(char *userKeymap) {
     keymap = userKeymap;
 }
 
-// Returns a single key only. Retained for backwards compatibility.
-char Keypad::getKey() {
-	single_key = true;
-
-	if (getKeys() && key[0].stateChanged && (key[0].kstate==PRESSED))
-		return key[0].kchar;
-	
-	single_key = false;
-
-	return NO_KEY;
+void Keypad::setBus(KeypadBus *newBus) {
+	bus = newBus;
+	if (bus)
+		bus->begin(rowPins, sizeKpd.rows, columnPins, sizeKpd.columns);
 }
 
-// Populate the key list.
-bool Keypad::getKeys() {
-	bool keyActivity = false;
-
-	// Limit how often the keypad is scanned. This makes the loop() run 10 times as fast.
-	if ( (millis()-startTime)>debounceTime ) {
-		scanKeys();
-		keyActivity = updateList();
-		startTime = millis();
+// Private : Hardware scan
+void Keypad::scanKeys() {
+	// A bus reads all the rows of a column at once.
+	if (bus) {
+		bus->startScan();
+		for (byte c=0; c<sizeKpd.columns; c++) {
+			unsigned int closed = bus->readColumn(c);
+			for (byte r=0; r<sizeKpd.rows; r++) {
+				bitWrite(bitMap[r], c, bitRead(closed, r));
+			}
+		}
+		bus->endScan();
+	}
+	else {
+		scanPins();
 	}
 
-	return keyActivity;
+	// Per key debounce, if it's on.
+	if (debounceSamples)
+		debounceKeys();
 }
 
-// Private : Hardware scan
-void Keypad::scanKeys() {
+// Private : Scan through the pin functions.
+void Keypad::scanPins() {
 	// Re-intialize the row pins. Allows sharing these pins with other hardware.
 	for (byte r=0; r<sizeKpd.rows; r++) {
 		pin_mode(rowPins[r],INPUT_PULLUP);
@@ -99,167 +97,47 @@ void Keypad::scanKeys() {
 	}
 }
 
-// Manage the list without rearranging the keys. Returns true if any keys on the list changed state.
-bool Keypad::updateList() {
+// Private : Per key debounce. Every key counts the scans in a row it has read other than its
+// debounced state, in vertical counters: bit k of each key's count sits in debounceCount[k], at
+// the key's bit of the row, so a few ANDs and XORs count a whole row at once. lastBitMap holds
+// the debounced state of the scan before.
+void Keypad::debounceKeys() {
+	byte last = debounceSamples - 1;
 
-	bool anyActivity = false;
-
-	// Delete any IDLE keys
-	for (byte i=0; i<LIST_MAX; i++) {
-		if (key[i].kstate==IDLE) {
-			key[i].kchar = NO_KEY;
-			key[i].kcode = -1;
-			key[i].stateChanged = false;
-		}
-	}
-
-	// Add new keys to empty slots in the key list.
 	for (byte r=0; r<sizeKpd.rows; r++) {
-		for (byte c=0; c<sizeKpd.columns; c++) {
-			boolean button = bitRead(bitMap[r],c);
-			char keyChar = keymap[r * sizeKpd.columns + c];
-			int keyCode = r * sizeKpd.columns + c;
-			int idx = findInList (keyCode);
-			// Key is already on the list so set its next state.
-			if (idx > -1)	{
-				nextKeyState(idx, button);
-			}
-			// Key is NOT on the list so add it.
-			if ((idx == -1) && button) {
-				for (byte i=0; i<LIST_MAX; i++) {
-					if (key[i].kchar==NO_KEY) {		// Find an empty slot or don't add key to list.
-						key[i].kchar = keyChar;
-						key[i].kcode = keyCode;
-						key[i].kstate = IDLE;		// Keys NOT on the list have an initial state of IDLE.
-						nextKeyState (i, button);
-						break;	// Don't fill all the empty slots with the same key.
-					}
-				}
-			}
-		}
-	}
-
-	// Report if the user changed the state of any key.
-	for (byte i=0; i<LIST_MAX; i++) {
-		if (key[i].stateChanged) anyActivity = true;
-	}
-
-	return anyActivity;
-}
+		uint differ = bitMap[r] ^ lastBitMap[r];
 
-// Private
-// This function is a state machine but is also used for debouncing the keys.
-void Keypad::nextKeyState(byte idx, boolean button) {
-	key[idx].stateChanged = false;
-
-	switch (key[idx].kstate) {
-		case IDLE:
-			if (button==CLOSED) {
-				transitionTo (idx, PRESSED);
-				holdTimer = millis(); }		// Get ready for next HOLD state.
-			break;
-		case PRESSED:
-			if ((millis()-holdTimer)>holdTime)	// Waiting for a key HOLD...
-				transitionTo (idx, HOLD);
-			else if (button==OPEN)				// or for a key to be RELEASED.
-				transitionTo (idx, RELEASED);
-			break;
-		case HOLD:
-			if (button==OPEN)
-				transitionTo (idx, RELEASED);
-			break;
-		case RELEASED:
-			transitionTo (idx, IDLE);
-			break;
-	}
-}
-
-// New in 2.1
-bool Keypad::isPressed(char keyChar) {
-	for (byte i=0; i<LIST_MAX; i++) {
-		if ( key[i].kchar == keyChar ) {
-			if ( (key[i].kstate == PRESSED) && key[i].stateChanged )
-				return true;
+		// Keys that already differed for the samples-1 scans before change now.
+		uint settled = differ;
+		for (byte k=0; k<KEYPAD_DEBOUNCE_BITS; k++) {
+			settled &= bitRead(last, k) ? debounceCount[k][r] : ~debounceCount[k][r];
 		}
-	}
-	return false;	// Not pressed.
-}
 
-// Search by character for a key in the list of active keys.
-// Returns -1 if not found or the index into the list of active keys.
-int Keypad::findInList (char keyChar) {
-	for (byte i=0; i<LIST_MAX; i++) {
-		if (key[i].kchar == keyChar) {
-			return i;
+		// The rest that differ count up, the keys that read the same start again at 0.
+		uint counting = differ & ~settled;
+		uint carry = counting;
+		for (byte k=0; k<KEYPAD_DEBOUNCE_BITS; k++) {
+			uint plane = debounceCount[k][r];
+			debounceCount[k][r] = (plane ^ carry) & counting;
+			carry &= plane;
 		}
-	}
-	return -1;
-}
 
-// Search by code for a key in the list of active keys.
-// Returns -1 if not found or the index into the list of active keys.
-int Keypad::findInList (int keyCode) {
-	for (byte i=0; i<LIST_MAX; i++) {
-		if (key[i].kcode == keyCode) {
-			return i;
-		}
+		bitMap[r] = lastBitMap[r] ^ settled;
 	}
-	return -1;
-}
-
-// New in 2.0
-char Keypad::waitForKey() {
-	char waitKey = NO_KEY;
-	while( (waitKey = getKey()) == NO_KEY );	// Block everything while waiting for a keypress.
-	return waitKey;
-}
-
-// Backwards compatibility function.
-KeyState Keypad::getState() {
-	return key[0].kstate;
 }
 
-// The end user can test for any changes in state before deciding
-// if any variables, etc. needs to be updated in their code.
-bool Keypad::keyStateChanged() {
-	return key[0].stateChanged;
-}
-
-// The number of keys on the key list, key[LIST_MAX], equals the number
-// of bytes in the key list divided by the number of bytes in a Key object.
-byte Keypad::numKeys() {
-	return sizeof(key)/sizeof(Key);
-}
-
-// Minimum debounceTime is 1 mS. Any lower *will* slow down the loop().
-void Keypad::setDebounceTime(uint debounce) {
-	debounce<1 ? debounceTime=1 : debounceTime=debounce;
-}
-
-void Keypad::setHoldTime(uint hold) {
-    holdTime = hold;
-}
+// Debounce every key on its own: a key only changes once it has read the same for this many scans
+// in a row, one scan every debounceTime, so set a short debounce time with it. From 1, no
+// filtering, to 1 << KEYPAD_DEBOUNCE_BITS. 0 turns it off and leaves the debounce time to space
+// out the scans alone.
+void Keypad::setDebounceSamples(byte samples) {
+	if (samples > (1 << KEYPAD_DEBOUNCE_BITS))
+		samples = 1 << KEYPAD_DEBOUNCE_BITS;
+	debounceSamples = samples;
 
-void Keypad::addEventListener(void (*listener)(char)){
-	keypadEventListener = listener;
-}
-
-void Keypad::transitionTo(byte idx, KeyState nextState) {
-	key[idx].kstate = nextState;
-	key[idx].stateChanged = true;
-
-	// Sketch used the getKey() function.
-	// Calls keypadEventListener only when the first key in slot 0 changes state.
-	if (single_key)  {
-	  	if ( (keypadEventListener!=NULL) && (idx==0) )  {
-			keypadEventListener(key[0].kchar);
-		}
-	}
-	// Sketch used the getKeys() function.
-	// Calls keypadEventListener on any key that changes state.
-	else {
-	  	if (keypadEventListener!=NULL)  {
-			keypadEventListener(key[idx].kchar);
+	for (byte k=0; k<KEYPAD_DEBOUNCE_BITS; k++) {
+		for (byte r=0; r<MAPSIZE; r++) {
+			debounceCount[k][r] = 0;
 		}
 	}
 }
@@ -34,6 +34,9 @@
 #define KEYPAD_H
 
 #include "Key.h"
+#include "KeypadBus.h"
+#include "KeypadEventQueue.h"
+#include "KeypadList.h"
 
 // bperrybap - Thanks for a well reasoned argument and the following macro(s).
 // See http://arduino.cc/forum/index.php/topic,142041.msg1069480.html#msg1069480
@@ -70,9 +73,13 @@ typedef struct {
 #define MAPSIZE 10		// MAPSIZE is the number of rows (times 16 columns)
 #define makeKeymap(x) ((char*)x)
 
+#ifndef KEYPAD_DEBOUNCE_BITS
+#define KEYPAD_DEBOUNCE_BITS 2	// Allows up to 1 << KEYPAD_DEBOUNCE_BITS debounce samples.
+#endif
+
 
 //class Keypad : public Key, public HAL_obj {
-class Keypad : public Key {
+class Keypad : public Key, public KeypadList<Keypad, uint, MAPSIZE, LIST_MAX> {
 public:
 
 	Keypad(char *userKeymap, byte *row, byte *col, byte numRows, byte numCols);
@@ -81,39 +88,32 @@ public:
 	virtual void pin_write(byte pinNum, boolean level) { digitalWrite(pinNum, level); }
 	virtual int  pin_read(byte pinNum) { return digitalRead(pinNum); }
 
-	uint bitMap[MAPSIZE];	// 10 row x 16 column array of bits. Except Due which has 32 columns.
-	Key key[LIST_MAX];
-	unsigned long holdTimer;
+	// Scan a column at a time through bus instead of the pin functions
+	// above, or go back to them with 0. See KeypadBus.h.
+	void setBus(KeypadBus *bus);
 
-	char getKey();
-	bool getKeys();
-	KeyState getState();
+	// bitMap, the 10 row x 16 column array of bits (32 columns on the Due), the key
+	// list and the rest of the key handling come from KeypadList.
 	void begin(char *userKeymap);
-	bool isPressed(char keyChar);
-	void setDebounceTime(uint);
-	void setHoldTime(uint);
-	void addEventListener(void (*listener)(char));
-	int findInList(char keyChar);
-	int findInList(int keyCode);
-	char waitForKey();
-	bool keyStateChanged();
-	byte numKeys();
+	void setDebounceSamples(byte samples);
 
 private:
-	unsigned long startTime;
+	friend class KeypadList<Keypad, uint, MAPSIZE, LIST_MAX>;
+
 	char *keymap;
     byte *rowPins;
     byte *columnPins;
 	KeypadSize sizeKpd;
-	uint debounceTime;
-	uint holdTime;
-	bool single_key;
+	byte debounceSamples;
+	uint debounceCount[KEYPAD_DEBOUNCE_BITS][MAPSIZE];	// Vertical counters, one bit plane each.
+	KeypadBus *bus;
 
 	void scanKeys();
-	bool updateList();
-	void nextKeyState(byte n, boolean button);
-	void transitionTo(byte n, KeyState nextState);
-	void (*keypadEventListener)(char);
+	void scanPins();
+	void debounceKeys();
+	byte keyRows() { return sizeKpd.rows; }
+	byte keyColumns() { return sizeKpd.columns; }
+	char keyChar(byte r, byte c) { return keymap[r * sizeKpd.columns + c]; }
 };
 
 #endif
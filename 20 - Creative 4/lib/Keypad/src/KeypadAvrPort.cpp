@@ -0,0 +1,103 @@
+/*
+||
+|| @file KeypadAvrPort.cpp
+||
+|| @description
+|| | KeypadBus on the AVR port registers, see KeypadAvrPort.h.
+|| #
+||
+|| @license
+|| | This library is free software; you can redistribute it and/or
+|| | modify it under the terms of the GNU Lesser General Public
+|| | License as published by the Free Software Foundation; version
+|| | 2.1 of the License.
+|| |
+|| | This library is distributed in the hope that it will be useful,
+|| | but WITHOUT ANY WARRANTY; without even the implied warranty of
+|| | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+|| | Lesser General Public License for more details.
+|| |
+|| | You should have received a copy of the GNU Lesser General Public
+|| | License along with this library; if not, write to the Free Software
+|| | Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+|| #
+||
+*/
+#include <KeypadAvrPort.h>
+
+#if defined(__AVR__)
+
+#define PIN_REG(p) (*(p).pin)
+#define DDR_REG(p) ((p).pin[1])
+#define PORT_REG(p) ((p).pin[2])
+
+KeypadAvrPort::KeypadAvrPort() {
+	numRows = 0;
+	numCols = 0;
+}
+
+void KeypadAvrPort::begin(const byte *rowPins, byte rowCount, const byte *columnPins, byte colCount) {
+	numRows = rowCount < MAPSIZE ? rowCount : MAPSIZE;
+	numCols = colCount < KEYPAD_PORT_MAX_COLUMNS ? colCount : KEYPAD_PORT_MAX_COLUMNS;
+
+	for (byte r=0; r<numRows; r++) {
+		rows[r] = lookUp(rowPins[r]);
+	}
+	for (byte c=0; c<numCols; c++) {
+		columns[c] = lookUp(columnPins[c]);
+	}
+}
+
+// Rows are inputs with pull-ups: DDR bit clear, PORT bit set.
+void KeypadAvrPort::startScan() {
+	uint8_t oldSREG = SREG;
+	cli();
+	for (byte r=0; r<numRows; r++) {
+		DDR_REG(rows[r]) &= ~rows[r].mask;
+		PORT_REG(rows[r]) |= rows[r].mask;
+	}
+	SREG = oldSREG;
+}
+
+unsigned int KeypadAvrPort::readColumn(byte column) {
+	if (column >= numCols)
+		return 0;
+
+	const PortPin &col = columns[column];
+
+	// Begin column pulse output. Interrupts are off around the
+	// read-modify-writes, as digitalWrite() does, since other pins share
+	// the port.
+	uint8_t oldSREG = SREG;
+	cli();
+	DDR_REG(col) |= col.mask;
+	PORT_REG(col) &= ~col.mask;
+	SREG = oldSREG;
+
+	delayMicroseconds(KEYPAD_PORT_SETTLE_US);
+
+	unsigned int closed = 0;
+	for (byte r=0; r<numRows; r++) {
+		if (!(PIN_REG(rows[r]) & rows[r].mask))	// keypress is active low
+			closed |= 1U << r;
+	}
+
+	// Drive the column high before letting it float on its pull-up, so the
+	// rows it pulled low are back up before the next column.
+	oldSREG = SREG;
+	cli();
+	PORT_REG(col) |= col.mask;
+	DDR_REG(col) &= ~col.mask;
+	SREG = oldSREG;
+
+	return closed;
+}
+
+KeypadAvrPort::PortPin KeypadAvrPort::lookUp(byte pinNum) {
+	PortPin portPin;
+	portPin.pin = portInputRegister(digitalPinToPort(pinNum));
+	portPin.mask = digitalPinToBitMask(pinNum);
+	return portPin;
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*
+||
+|| @file KeypadAvrPort.h
+||
+|| @description
+|| | KeypadBus on the AVR port registers. The PIN, DDR and PORT
+|| | register and bit of every pin are looked up once in begin(), so a
+|| | column costs a few register writes with interrupts off and one
+|| | register read per row, against a digitalRead() of several
+|| | microseconds per key on the default scan.
+|| |
+|| | Handles up to MAPSIZE rows and KEYPAD_PORT_MAX_COLUMNS columns;
+|| | columns past that read as open.
+|| #
+||
+|| @license
+|| | This library is free software; you can redistribute it and/or
+|| | modify it under the terms of the GNU Lesser General Public
+|| | License as published by the Free Software Foundation; version
+|| | 2.1 of the License.
+|| |
+|| | This library is distributed in the hope that it will be useful,
+|| | but WITHOUT ANY WARRANTY; without even the implied warranty of
+|| | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+|| | Lesser General Public License for more details.
+|| |
+|| | You should have received a copy of the GNU Lesser General Public
+|| | License along with this library; if not, write to the Free Software
+|| | Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+|| #
+||
+*/
+
+#ifndef KEYPAD_AVR_PORT_H
+#define KEYPAD_AVR_PORT_H
+
+#if defined(__AVR__)
+
+#include "Keypad.h"
+#include "KeypadBus.h"
+
+#ifndef KEYPAD_PORT_MAX_COLUMNS
+#define KEYPAD_PORT_MAX_COLUMNS 8
+#endif
+
+// Time for a row to follow its column low through the key contact. The
+// default scan gets this for free from the time digitalRead() takes.
+#ifndef KEYPAD_PORT_SETTLE_US
+#define KEYPAD_PORT_SETTLE_US 1
+#endif
+
+class KeypadAvrPort : public KeypadBus {
+public:
+	KeypadAvrPort();
+
+	void begin(const byte *rowPins, byte numRows, const byte *columnPins, byte numCols);
+	void startScan();
+	unsigned int readColumn(byte column);
+
+private:
+	// On every AVR the DDR and PORT registers of a port follow its PIN
+	// register, so one pointer reaches all three.
+	typedef struct {
+		volatile uint8_t *pin;
+		uint8_t mask;
+	} PortPin;
+
+	PortPin rows[MAPSIZE];
+	PortPin columns[KEYPAD_PORT_MAX_COLUMNS];
+	byte numRows;
+	byte numCols;
+
+	static PortPin lookUp(byte pinNum);
+};
+
+#endif
+
+#endif
@@ -0,0 +1,53 @@
+/*
+||
+|| @file KeypadBus.h
+||
+|| @description
+|| | Bulk pin I/O for Keypad::scanKeys(). A bus pulls one column low
+|| | and returns every row of it in a single call, where the default
+|| | scan makes a pin_mode(), pin_write() or pin_read() call per pin.
+|| | Give a Keypad one with setBus(). See KeypadAvrPort.h for direct
+|| | port registers and KeypadI2CPort.h for a PCF8574 port expander.
+|| #
+||
+|| @license
+|| | This library is free software; you can redistribute it and/or
+|| | modify it under the terms of the GNU Lesser General Public
+|| | License as published by the Free Software Foundation; version
+|| | 2.1 of the License.
+|| |
+|| | This library is distributed in the hope that it will be useful,
+|| | but WITHOUT ANY WARRANTY; without even the implied warranty of
+|| | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+|| | Lesser General Public License for more details.
+|| |
+|| | You should have received a copy of the GNU Lesser General Public
+|| | License along with this library; if not, write to the Free Software
+|| | Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+|| #
+||
+*/
+
+#ifndef KEYPAD_BUS_H
+#define KEYPAD_BUS_H
+
+#include <Arduino.h>
+
+class KeypadBus {
+public:
+	// Pins as given to the Keypad constructor. Called by Keypad::setBus().
+	virtual void begin(const byte *rowPins, byte numRows, const byte *columnPins, byte numCols) = 0;
+
+	// Called before the first column of every scan. Puts the rows back to
+	// inputs with pull-ups, so they can be shared with other hardware.
+	virtual void startScan() {}
+
+	// Pulse one column low and return the rows that read closed, row r in
+	// bit r. The column is released again before returning.
+	virtual unsigned int readColumn(byte column) = 0;
+
+	// Called after the last column of every scan.
+	virtual void endScan() {}
+};
+
+#endif
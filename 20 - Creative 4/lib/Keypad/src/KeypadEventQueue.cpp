@@ -0,0 +1,94 @@
+/*
+||
+|| @file KeypadEventQueue.cpp
+||
+|| @description
+|| | Ring of timestamped key events for any number of readers, see
+|| | KeypadEventQueue.h.
+|| #
+||
+|| @license
+|| | This library is free software; you can redistribute it and/or
+|| | modify it under the terms of the GNU Lesser General Public
+|| | License as published by the Free Software Foundation; version
+|| | 2.1 of the License.
+|| |
+|| | This library is distributed in the hope that it will be useful,
+|| | but WITHOUT ANY WARRANTY; without even the implied warranty of
+|| | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+|| | Lesser General Public License for more details.
+|| |
+|| | You should have received a copy of the GNU Lesser General Public
+|| | License along with this library; if not, write to the Free Software
+|| | Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+|| #
+||
+*/
+#include <KeypadEventQueue.h>
+
+KeypadEventQueue::KeypadEventQueue(KeypadEventRecord *userRecords, byte userSize, KeypadOverflow userPolicy) {
+	records = userRecords;
+	size = userSize;
+	policy = userPolicy;
+	head = 0;
+	droppedCount = 0;
+	readers = 0;
+}
+
+bool KeypadEventQueue::push(const KeypadEventRecord &record) {
+	if (size == 0)
+		return false;
+
+	// The slowest reader decides whether there's room.
+	if (policy == KEYPAD_DROP_NEWEST) {
+		for (KeypadEventReader *reader = readers; reader; reader = reader->next) {
+			if (reader->behind >= size) {
+				droppedCount++;
+				return false;
+			}
+		}
+	}
+
+	records[head] = record;
+	head = head + 1 < size ? head + 1 : 0;
+
+	// A reader already a whole queue behind loses its oldest record.
+	for (KeypadEventReader *reader = readers; reader; reader = reader->next) {
+		if (reader->behind < size)
+			reader->behind++;
+		else
+			reader->lostCount++;
+	}
+	return true;
+}
+
+KeypadEventReader::KeypadEventReader(KeypadEventQueue &userQueue) : queue(userQueue) {
+	behind = 0;
+	lostCount = 0;
+	next = queue.readers;
+	queue.readers = this;
+}
+
+KeypadEventReader::~KeypadEventReader() {
+	KeypadEventReader **link = &queue.readers;
+	while (*link && *link != this) {
+		link = &(*link)->next;
+	}
+	if (*link)
+		*link = next;
+}
+
+byte KeypadEventReader::available() {
+	return behind;
+}
+
+bool KeypadEventReader::read(KeypadEventRecord &record) {
+	if (behind == 0)
+		return false;
+
+	// The oldest unread record is behind slots back from head.
+	byte slot = queue.head >= behind ? queue.head - behind : queue.head + queue.size - behind;
+	record = queue.records[slot];
+	behind--;
+	return true;
+}
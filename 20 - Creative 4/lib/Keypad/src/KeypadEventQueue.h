@@ -0,0 +1,104 @@
+/*
+||
+|| @file KeypadEventQueue.h
+||
+|| @description
+|| | Ring of timestamped key events for any number of readers. Give a
+|| | Keypad one with setEventQueue() and every state change of every key
+|| | on its list is recorded, not only the first key's as with getKey()
+|| | and the single-key listener. Each KeypadEventReader keeps its own
+|| | place, so one part of a sketch reading events doesn't take them
+|| | from another.
+|| |
+|| | The records live in an array the sketch passes in; nothing is
+|| | allocated. When a reader falls size records behind, the policy
+|| | decides what is lost:
+|| |   KEYPAD_OVERWRITE_OLDEST  the newest record replaces the oldest,
+|| |                            and that reader skips ahead and counts
+|| |                            what it missed in lost()
+|| |   KEYPAD_DROP_NEWEST       the new record is dropped for every
+|| |                            reader and counted in dropped()
+|| |
+|| | Events are only recorded while the keypad is scanned. To keep
+|| | scanning through delay(), call getKeys() from yield(), which the
+|| | AVR core's delay() runs while it waits (see examples/EventQueue).
+|| | Not safe to use from an interrupt.
+|| #
+||
+|| @license
+|| | This library is free software; you can redistribute it and/or
+|| | modify it under the terms of the GNU Lesser General Public
+|| | License as published by the Free Software Foundation; version
+|| | 2.1 of the License.
+|| |
+|| | This library is distributed in the hope that it will be useful,
+|| | but WITHOUT ANY WARRANTY; without even the implied warranty of
+|| | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+|| | Lesser General Public License for more details.
+|| |
+|| | You should have received a copy of the GNU Lesser General Public
+|| | License along with this library; if not, write to the Free Software
+|| | Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+|| #
+||
+*/
+
+#ifndef KEYPAD_EVENT_QUEUE_H
+#define KEYPAD_EVENT_QUEUE_H
+
+#include "Key.h"
+
+typedef struct {
+	char kchar;
+	int kcode;
+	KeyState kstate;		// State the key just went into.
+	unsigned long time;		// millis() of the scan that saw it.
+} KeypadEventRecord;
+
+typedef enum { KEYPAD_OVERWRITE_OLDEST, KEYPAD_DROP_NEWEST } KeypadOverflow;
+
+class KeypadEventReader;
+
+class KeypadEventQueue {
+public:
+	KeypadEventQueue(KeypadEventRecord *records, byte size, KeypadOverflow policy = KEYPAD_OVERWRITE_OLDEST);
+
+	// Called by Keypad. False when the record was dropped.
+	bool push(const KeypadEventRecord &record);
+
+	// Records dropped under KEYPAD_DROP_NEWEST.
+	unsigned int dropped() { return droppedCount; }
+
+private:
+	KeypadEventRecord *records;
+	byte size;
+	KeypadOverflow policy;
+	byte head;					// Slot the next record goes in.
+	unsigned int droppedCount;
+	KeypadEventReader *readers;	// Linked through KeypadEventReader::next.
+
+	friend class KeypadEventReader;
+};
+
+class KeypadEventReader {
+public:
+	// Starts with the next record pushed.
+	KeypadEventReader(KeypadEventQueue &queue);
+	~KeypadEventReader();
+
+	byte available();
+	bool read(KeypadEventRecord &record);
+
+	// Records this reader missed under KEYPAD_OVERWRITE_OLDEST.
+	unsigned int lost() { return lostCount; }
+
+private:
+	KeypadEventQueue &queue;
+	byte behind;				// Records this reader hasn't read yet, up to size.
+	unsigned int lostCount;
+	KeypadEventReader *next;
+
+	friend class KeypadEventQueue;
+};
+
+#endif
@@ -0,0 +1,96 @@
+/*
+||
+|| @file KeypadI2CPort.h
+||
+|| @description
+|| | KeypadBus on a PCF8574 I2C port expander, with the row and column
+|| | pins given as expander bits 0-7. A column is one bus transaction:
+|| | the column byte is written and the rows read back after a repeated
+|| | start. Per-pin access, as with Keypad_I2C, costs a transaction for
+|| | every pin_mode(), pin_write() and pin_read().
+|| |
+|| | Only this header uses Wire, so sketches without it don't link it.
+|| #
+||
+|| @license
+|| | This library is free software; you can redistribute it and/or
+|| | modify it under the terms of the GNU Lesser General Public
+|| | License as published by the Free Software Foundation; version
+|| | 2.1 of the License.
+|| |
+|| | This library is distributed in the hope that it will be useful,
+|| | but WITHOUT ANY WARRANTY; without even the implied warranty of
+|| | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+|| | Lesser General Public License for more details.
+|| |
+|| | You should have received a copy of the GNU Lesser General Public
+|| | License along with this library; if not, write to the Free Software
+|| | Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+|| #
+||
+*/
+
+#ifndef KEYPAD_I2C_PORT_H
+#define KEYPAD_I2C_PORT_H
+
+#include <Wire.h>
+#include "Keypad.h"
+#include "KeypadBus.h"
+
+class KeypadI2CPort : public KeypadBus {
+public:
+	// Call Wire.begin() before Keypad::setBus().
+	KeypadI2CPort(byte address, TwoWire &bus = Wire) : wire(bus), i2cAddress(address), numRows(0) {
+		columnBits[0] = 0;
+	}
+
+	void begin(const byte *rowPins, byte rowCount, const byte *columnPins, byte colCount) {
+		numRows = rowCount < MAPSIZE ? rowCount : MAPSIZE;
+		for (byte r=0; r<numRows; r++) {
+			rowBits[r] = 1 << rowPins[r];
+		}
+		for (byte c=0; c<8; c++) {
+			columnBits[c] = c < colCount ? 1 << columnPins[c] : 0;
+		}
+		release();
+	}
+
+	unsigned int readColumn(byte column) {
+		if (column >= 8 || columnBits[column] == 0)
+			return 0;
+
+		// Every other pin stays high, which is a weak pull-up on a PCF8574.
+		wire.beginTransmission(i2cAddress);
+		wire.write((byte)~columnBits[column]);
+		wire.endTransmission(false);
+
+		byte pins = 0xFF;
+		if (wire.requestFrom(i2cAddress, (byte)1) == 1)
+			pins = wire.read();
+
+		unsigned int closed = 0;
+		for (byte r=0; r<numRows; r++) {
+			if (!(pins & rowBits[r]))	// keypress is active low
+				closed |= 1U << r;
+		}
+		return closed;
+	}
+
+	// The last column stays low until here.
+	void endScan() { release(); }
+
+private:
+	TwoWire &wire;
+	byte i2cAddress;
+	byte numRows;
+	byte rowBits[MAPSIZE];
+	byte columnBits[8];
+
+	void release() {
+		wire.beginTransmission(i2cAddress);
+		wire.write((byte)0xFF);
+		wire.endTransmission();
+	}
+};
+
+#endif
@@ -0,0 +1,332 @@
+/*
+||
+|| @file KeypadList.h
+||
+|| @description
+|| | The key list and the key state machine shared by Keypad and
+|| | StaticKeypad. KEYPAD is the class that derives from it and BITS
+|| | holds a row of keys, a bit per column, for up to ROWS rows and
+|| | LIST keys on the list. The derived class provides:
+|| |
+|| |   void scanKeys();               // Fill bitMap from the hardware.
+|| |   byte keyRows();                // Rows and columns in use.
+|| |   byte keyColumns();
+|| |   char keyChar(byte r, byte c);  // The keymap entry of a key.
+|| #
+||
+|| @license
+|| | This library is free software; you can redistribute it and/or
+|| | modify it under the terms of the GNU Lesser General Public
+|| | License as published by the Free Software Foundation; version
+|| | 2.1 of the License.
+|| |
+|| | This library is distributed in the hope that it will be useful,
+|| | but WITHOUT ANY WARRANTY; without even the implied warranty of
+|| | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+|| | Lesser General Public License for more details.
+|| |
+|| | You should have received a copy of the GNU Lesser General Public
+|| | License along with this library; if not, write to the Free Software
+|| | Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+|| #
+||
+*/
+
+#ifndef KEYPAD_LIST_H
+#define KEYPAD_LIST_H
+
+#include "Key.h"
+#include "KeypadEventQueue.h"
+
+template <class KEYPAD, typename BITS, byte ROWS, byte LIST>
+class KeypadList {
+public:
+	KeypadList() {
+		setDebounceTime(10);
+		setHoldTime(500);
+		keypadEventListener = 0;
+		eventQueue = 0;
+
+		startTime = 0;
+		single_key = false;
+
+		// Nothing pressed and nothing on the list yet.
+		for (byte r=0; r<ROWS; r++) {
+			bitMap[r] = 0;
+			lastBitMap[r] = 0;
+		}
+		for (byte i=0; i<LIST; i++) {
+			key[i].kcode = -1;
+		}
+		listed = 0;
+		listFull = false;
+	}
+
+	BITS bitMap[ROWS];	// A bit per key, bit c of bitMap[r] for row r and column c.
+	Key key[LIST];
+	unsigned long holdTimer;
+
+	// Returns a single key only. Retained for backwards compatibility.
+	char getKey() {
+		single_key = true;
+
+		if (getKeys() && key[0].stateChanged && (key[0].kstate==PRESSED))
+			return key[0].kchar;
+
+		single_key = false;
+
+		return NO_KEY;
+	}
+
+	// Populate the key list.
+	bool getKeys() {
+		bool keyActivity = false;
+
+		// Limit how often the keypad is scanned. This makes the loop() run 10 times as fast.
+		if ( (millis()-startTime)>debounceTime ) {
+			self().scanKeys();
+			keyActivity = updateList();
+			startTime = millis();
+		}
+
+		return keyActivity;
+	}
+
+	// Backwards compatibility function.
+	KeyState getState() {
+		return key[0].kstate;
+	}
+
+	// The end user can test for any changes in state before deciding
+	// if any variables, etc. needs to be updated in their code.
+	bool keyStateChanged() {
+		return key[0].stateChanged;
+	}
+
+	// The number of keys on the key list.
+	byte numKeys() {
+		return LIST;
+	}
+
+	// New in 2.1
+	bool isPressed(char keyChar) {
+		for (byte i=0; i<LIST; i++) {
+			if ( key[i].kchar == keyChar ) {
+				if ( (key[i].kstate == PRESSED) && key[i].stateChanged )
+					return true;
+			}
+		}
+		return false;	// Not pressed.
+	}
+
+	// Search by character for a key in the list of active keys.
+	// Returns -1 if not found or the index into the list of active keys.
+	int findInList(char keyChar) {
+		for (byte i=0; i<LIST; i++) {
+			if (key[i].kchar == keyChar) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	// Search by code for a key in the list of active keys.
+	// Returns -1 if not found or the index into the list of active keys.
+	int findInList(int keyCode) {
+		for (byte i=0; i<LIST; i++) {
+			if (key[i].kcode == keyCode) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	// New in 2.0
+	char waitForKey() {
+		char waitKey = NO_KEY;
+		while( (waitKey = getKey()) == NO_KEY );	// Block everything while waiting for a keypress.
+		return waitKey;
+	}
+
+	// Minimum debounceTime is 1 mS. Any lower *will* slow down the loop().
+	void setDebounceTime(uint debounce) {
+		debounce<1 ? debounceTime=1 : debounceTime=debounce;
+	}
+
+	void setHoldTime(uint hold) {
+		holdTime = hold;
+	}
+
+	void addEventListener(void (*listener)(char)) {
+		keypadEventListener = listener;
+	}
+
+	// Record every key state change in queue as well, or stop with 0.
+	void setEventQueue(KeypadEventQueue *queue) {
+		eventQueue = queue;
+	}
+
+protected:
+	BITS lastBitMap[ROWS];	// bitMap of the scan before, to find what changed.
+
+private:
+	unsigned long startTime;
+	uint debounceTime;
+	uint holdTime;
+	bool single_key;
+	byte listed;				// Keys on the key list.
+	bool listFull;				// A pressed key found no free slot last scan.
+	void (*keypadEventListener)(char);
+	KeypadEventQueue *eventQueue;
+
+	KEYPAD &self() { return *static_cast<KEYPAD *>(this); }
+
+	// Manage the list without rearranging the keys. Returns true if any keys on the list changed state.
+	// Only keys that changed since the last scan and keys already on the list are visited, so a scan
+	// with nothing pressed just compares each row with the one before.
+	bool updateList() {
+		byte rows = self().keyRows();
+		byte columns = self().keyColumns();
+
+		bool anyActivity = false;
+		BITS listMap[ROWS];		// Keys on the list, a bit per key as in bitMap.
+		BITS deletedMap[ROWS];	// Keys just taken off it, which may be pressed again.
+
+		for (byte r=0; r<rows; r++) {
+			listMap[r] = 0;
+			deletedMap[r] = 0;
+		}
+
+		if (listed > 0) {
+			for (byte i=0; i<LIST; i++) {
+				if (key[i].kcode == -1)
+					continue;
+				byte r = key[i].kcode / columns;
+				byte c = key[i].kcode % columns;
+				// Delete any IDLE keys
+				if (key[i].kstate==IDLE) {
+					bitSet(deletedMap[r], c);
+					key[i].kchar = NO_KEY;
+					key[i].kcode = -1;
+					key[i].stateChanged = false;
+					listed--;
+				}
+				else {
+					bitSet(listMap[r], c);
+				}
+			}
+		}
+
+		// A key left off a full list is added as soon as there's room.
+		bool retry = listFull;
+		listFull = false;
+
+		for (byte r=0; r<rows; r++) {
+			BITS changed = bitMap[r] ^ lastBitMap[r];
+			lastBitMap[r] = bitMap[r];
+
+			// Keys on the list run their state machine every scan, for the hold
+			// timer and the step from RELEASED to IDLE. Others only when pressed.
+			BITS visit = listMap[r] | ((changed | deletedMap[r]) & bitMap[r]);
+			if (retry)
+				visit |= bitMap[r];
+
+			// Walk the set bits lowest first, the order the columns were scanned in.
+			while (visit) {
+				byte c = __builtin_ctz(visit);
+				visit &= visit - 1;
+
+				boolean button = bitRead(bitMap[r],c);
+				int keyCode = r * columns + c;
+				int idx = bitRead(listMap[r],c) ? findInList (keyCode) : -1;
+				// Key is already on the list so set its next state.
+				if (idx > -1)	{
+					nextKeyState(idx, button);
+				}
+				// Key is NOT on the list so add it.
+				if ((idx == -1) && button) {
+					byte i;
+					for (i=0; i<LIST; i++) {
+						if (key[i].kcode==-1) {		// Find an empty slot or don't add key to list.
+							key[i].kchar = self().keyChar(r, c);
+							key[i].kcode = keyCode;
+							key[i].kstate = IDLE;		// Keys NOT on the list have an initial state of IDLE.
+							listed++;
+							nextKeyState (i, button);
+							break;	// Don't fill all the empty slots with the same key.
+						}
+					}
+					if (i == LIST)
+						listFull = true;
+				}
+			}
+		}
+
+		// Report if the user changed the state of any key.
+		if (listed > 0) {
+			for (byte i=0; i<LIST; i++) {
+				if (key[i].stateChanged) anyActivity = true;
+			}
+		}
+
+		return anyActivity;
+	}
+
+	// This function is a state machine but is also used for debouncing the keys.
+	void nextKeyState(byte idx, boolean button) {
+		key[idx].stateChanged = false;
+
+		switch (key[idx].kstate) {
+			case IDLE:
+				if (button==CLOSED) {
+					transitionTo (idx, PRESSED);
+					holdTimer = millis(); }		// Get ready for next HOLD state.
+				break;
+			case PRESSED:
+				if ((millis()-holdTimer)>holdTime)	// Waiting for a key HOLD...
+					transitionTo (idx, HOLD);
+				else if (button==OPEN)				// or for a key to be RELEASED.
+					transitionTo (idx, RELEASED);
+				break;
+			case HOLD:
+				if (button==OPEN)
+					transitionTo (idx, RELEASED);
+				break;
+			case RELEASED:
+				transitionTo (idx, IDLE);
+				break;
+		}
+	}
+
+	void transitionTo(byte idx, KeyState nextState) {
+		key[idx].kstate = nextState;
+		key[idx].stateChanged = true;
+
+		// The queue gets every key, whichever of getKey() and getKeys() is used.
+		if (eventQueue) {
+			KeypadEventRecord record;
+			record.kchar = key[idx].kchar;
+			record.kcode = key[idx].kcode;
+			record.kstate = nextState;
+			record.time = millis();
+			eventQueue->push(record);
+		}
+
+		// Sketch used the getKey() function.
+		// Calls keypadEventListener only when the first key in slot 0 changes state.
+		if (single_key)  {
+			if ( (keypadEventListener!=NULL) && (idx==0) )  {
+				keypadEventListener(key[0].kchar);
+			}
+		}
+		// Sketch used the getKeys() function.
+		// Calls keypadEventListener on any key that changes state.
+		else {
+			if (keypadEventListener!=NULL)  {
+				keypadEventListener(key[idx].kchar);
+			}
+		}
+	}
+};
+
+#endif
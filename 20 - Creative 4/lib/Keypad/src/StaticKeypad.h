@@ -0,0 +1,180 @@
+/*
+||
+|| @file StaticKeypad.h
+||
+|| @description
+|| | Keypad with its pins, keymap and size fixed at compile time.
+|| |
+|| |   const char keys[4][4] PROGMEM = { ... };
+|| |   StaticKeypad< KeypadPins<9,8,7,6>, KeypadPins<5,4,3,2>, keys > kpd;
+|| |
+|| | The first KeypadPins lists the row pins and the second the column
+|| | pins, so the size of the keypad is the number of each. The keymap
+|| | stays in flash and the pin arrays aren't needed at all. bitMap has
+|| | a byte per row up to 8 columns, the key list holds no more keys
+|| | than the keypad has, up to LIST_MAX, and there is no vtable. On
+|| | the ATmega168/328 (Uno, Nano, Pro Mini) every pin access is a
+|| | single sbi, cbi or sbic instruction on its port; other boards go
+|| | through pinMode(), digitalWrite() and digitalRead() with the pin
+|| | number as a constant.
+|| |
+|| | Keys go through the same key list and state machine as Keypad,
+|| | KeypadList, so getKey(), getKeys(), waitForKey(), the event
+|| | listener and the event queue all behave the same. There is no
+|| | bus and no per key debounce (setDebounceSamples()); use Keypad
+|| | for those.
+|| #
+||
+|| @license
+|| | This library is free software; you can redistribute it and/or
+|| | modify it under the terms of the GNU Lesser General Public
+|| | License as published by the Free Software Foundation; version
+|| | 2.1 of the License.
+|| |
+|| | This library is distributed in the hope that it will be useful,
+|| | but WITHOUT ANY WARRANTY; without even the implied warranty of
+|| | MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+|| | Lesser General Public License for more details.
+|| |
+|| | You should have received a copy of the GNU Lesser General Public
+|| | License along with this library; if not, write to the Free Software
+|| | Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+|| #
+||
+*/
+
+#ifndef STATIC_KEYPAD_H
+#define STATIC_KEYPAD_H
+
+#include "Keypad.h"
+
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega168__)
+
+// One pin on the ports of the ATmega168/328. Digital 0-7 are PORTD, 8-13
+// PORTB and 14-19 (A0-A5) PORTC. The PIN, DDR and PORT registers of a port
+// are three I/O registers in a row, from 0x03 for B, 0x06 for C and 0x09 for D.
+template <byte PIN>
+struct KeypadPin {
+	static_assert(PIN < 20, "StaticKeypad pins are 0-19 on this board");
+
+	enum {
+		io = PIN < 8 ? 0x09 : PIN < 14 ? 0x03 : 0x06,
+		mask = 1 << (PIN < 8 ? PIN : PIN < 14 ? PIN - 8 : PIN - 14)
+	};
+
+	// Constant addresses and masks, so each change is one instruction and
+	// safe with interrupts on.
+	static void inputPullup() { _SFR_IO8(io + 1) &= ~mask; _SFR_IO8(io + 2) |= mask; }
+	static void input() { _SFR_IO8(io + 1) &= ~mask; _SFR_IO8(io + 2) &= ~mask; }
+	static void output() { _SFR_IO8(io + 1) |= mask; }
+	static void write(boolean level) {
+		if (level)
+			_SFR_IO8(io + 2) |= mask;
+		else
+			_SFR_IO8(io + 2) &= ~mask;
+	}
+	static boolean read() { return (_SFR_IO8(io) & mask) != 0; }
+};
+
+#else
+
+// Any other board, through the Arduino pin functions.
+template <byte PIN>
+struct KeypadPin {
+	static void inputPullup() { pinMode(PIN, INPUT_PULLUP); }
+	static void input() { pinMode(PIN, INPUT); }
+	static void output() { pinMode(PIN, OUTPUT); }
+	static void write(boolean level) { digitalWrite(PIN, level); }
+	static boolean read() { return digitalRead(PIN); }
+};
+
+#endif
+
+// The row or column pins of a StaticKeypad, in order. Each function below
+// works through the pins one after the other at compile time.
+template <byte... PINS>
+struct KeypadPins;
+
+template <>
+struct KeypadPins<> {
+	enum { count = 0 };
+
+	static void inputPullup() {}
+	template <typename BITS> static void readRows(BITS *, BITS) {}
+	template <class ROWS, typename BITS> static void scanColumns(BITS *, BITS) {}
+};
+
+template <byte PIN, byte... REST>
+struct KeypadPins<PIN, REST...> {
+	enum { count = 1 + sizeof...(REST) };
+
+	static void inputPullup() {
+		KeypadPin<PIN>::inputPullup();
+		KeypadPins<REST...>::inputPullup();
+	}
+
+	// Row pins: set bit in the rows that read LOW and clear it in the rest.
+	template <typename BITS>
+	static void readRows(BITS *rows, BITS bit) {
+		if (KeypadPin<PIN>::read())
+			*rows &= ~bit;
+		else
+			*rows |= bit;	// keypress is active low so invert to high.
+		KeypadPins<REST...>::readRows(rows + 1, bit);
+	}
+
+	// Column pins: pulse each one low in turn and read the rows, as Keypad::scanKeys() does.
+	template <class ROWS, typename BITS>
+	static void scanColumns(BITS *rows, BITS bit) {
+		KeypadPin<PIN>::output();
+		KeypadPin<PIN>::write(LOW);	// Begin column pulse output.
+		ROWS::readRows(rows, bit);
+		// Set pin to high impedance input. Effectively ends column pulse.
+		KeypadPin<PIN>::write(HIGH);
+		KeypadPin<PIN>::input();
+		KeypadPins<REST...>::template scanColumns<ROWS>(rows, BITS(bit << 1));
+	}
+};
+
+// A byte per row up to 8 columns, a word up to 16.
+template <byte COLUMNS, bool SMALL = (COLUMNS <= 8)>
+struct KeypadRowBits {
+	typedef uint16_t type;
+};
+
+template <byte COLUMNS>
+struct KeypadRowBits<COLUMNS, true> {
+	typedef uint8_t type;
+};
+
+template <class ROWPINS, class COLPINS, const char (&KEYMAP)[ROWPINS::count][COLPINS::count],
+	byte LIST = (ROWPINS::count * COLPINS::count < LIST_MAX ? ROWPINS::count * COLPINS::count : LIST_MAX)>
+class StaticKeypad : public KeypadList<StaticKeypad<ROWPINS, COLPINS, KEYMAP, LIST>,
+	typename KeypadRowBits<COLPINS::count>::type, ROWPINS::count, LIST> {
+public:
+	enum {
+		ROWS = ROWPINS::count,
+		COLUMNS = COLPINS::count
+	};
+	static_assert(ROWS > 0 && COLUMNS > 0, "A StaticKeypad needs row and column pins");
+	static_assert(COLUMNS <= 16, "A StaticKeypad has at most 16 columns");
+	static_assert(LIST > 0, "The key list holds at least one key");
+
+	typedef typename KeypadRowBits<COLUMNS>::type RowBits;
+
+private:
+	friend class KeypadList<StaticKeypad, RowBits, ROWS, LIST>;
+
+	// Private : Hardware scan
+	void scanKeys() {
+		// Re-intialize the row pins. Allows sharing these pins with other hardware.
+		ROWPINS::inputPullup();
+		COLPINS::template scanColumns<ROWPINS>(this->bitMap, RowBits(1));
+	}
+
+	byte keyRows() { return ROWS; }
+	byte keyColumns() { return COLUMNS; }
+	char keyChar(byte r, byte c) { return pgm_read_byte(&KEYMAP[r][c]); }
+};
+
+#endif
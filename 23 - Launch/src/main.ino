@@ -32,7 +32,7 @@ constexpr unsigned long COUNTDOWN_MILLISECONDS = (70UL * 1000UL);
 // -MARK: Function hoisting
 byte drawString(
   byte x, byte y,
-  const char *string
+  const __FlashStringHelper *string
 );
 
 void displayLander(
@@ -46,7 +46,8 @@ void displayCounter(unsigned long milliseconds);
 // -MARK: Setup
 void setup() {
   Serial.begin(9600);
-  Serial.println("CountdownMS: " + String(COUNTDOWN_MILLISECONDS));
+  Serial.print(F("CountdownMS: "));
+  Serial.println(COUNTDOWN_MILLISECONDS);
 
   // Configure counter display
   counter_display.setBrightness(7); // Set max brightness (0..7)
@@ -80,14 +81,14 @@ void setup() {
    */
   lander_display.firstPage();
   do {
-    const byte y_offset = drawString(0, 0, "Exploration Lander");
-    drawString(0, y_offset, "Liftoff Sequence");
+    const byte y_offset = drawString(0, 0, F("Exploration Lander"));
+    drawString(0, y_offset, F("Liftoff Sequence"));
 
     // Status on bottom line of OLED display
     drawString(
       0,
       lander_display.getDisplayHeight() - lander_display.getMaxCharHeight(),
-      "Countdown Active"
+      F("Countdown Active")
     );
     // Draw a picture of our lander int bottom right corner
     displayLander(
@@ -103,7 +104,7 @@ void setup() {
     displayCounter(COUNTDOWN_MILLISECONDS);
     delay(200);
   }
-  Serial.println("Countdown started..: ");
+  Serial.println(F("Countdown started..: "));
 }
 
 // -MARK: Loop
@@ -115,7 +116,7 @@ void setup() {
 
   // Display ending values
   if (timeRemaining == 0) {
-    Serial.println("Done!!");
+    Serial.println(F("Done!!"));
     counter_display.setSegments(DONE);
 
     // Update OLED display with ending screen using firstPage()/nextPage()
@@ -125,17 +126,17 @@ void setup() {
       // is updated to point to the next available point for drawing.
 
       // Display first two lines
-      byte y_offset = drawString(0, 0, "Exploration Lander");
-      drawString(0, y_offset, "Liftoff ABORTED");
+      byte y_offset = drawString(0, 0, F("Exploration Lander"));
+      drawString(0, y_offset, F("Liftoff ABORTED"));
 
       // Set y_offset to point four lines above bottom of display
       y_offset = lander_display.getDisplayHeight() - (4 * lander_display.getMaxCharHeight());
 
       // Display last four lines
-      y_offset = drawString(0, y_offset, "Thrusters: OFF");
-      y_offset = drawString(0, y_offset, "Systems: OFF");
-      y_offset = drawString(0, y_offset, "Confirm: OFF");
-      drawString(0, y_offset, "Countdown ABORT");
+      y_offset = drawString(0, y_offset, F("Thrusters: OFF"));
+      y_offset = drawString(0, y_offset, F("Systems: OFF"));
+      y_offset = drawString(0, y_offset, F("Confirm: OFF"));
+      drawString(0, y_offset, F("Countdown ABORT"));
 
       // Draw a picture of our lander in bottom right corner
       displayLander(
@@ -166,10 +167,12 @@ void displayCounter(const unsigned long milliseconds) {
   const byte minutes = numberOfMinutes(milliseconds);
   const byte seconds = numberOfSeconds(milliseconds);
 
-  Serial.print("ms: ");
+  Serial.print(F("ms: "));
   Serial.print(milliseconds);
-  Serial.print(" | m/s: ");
-  Serial.println(String(minutes) + "/" + String(seconds));
+  Serial.print(F(" | m/s: "));
+  Serial.print(minutes);
+  Serial.print('/');
+  Serial.println(seconds);
 
   // Display the minutes in the first two places, with colon
   counter_display.showNumberDecEx(minutes, 0b01000000, true, 2, 0);
@@ -179,11 +182,13 @@ void displayCounter(const unsigned long milliseconds) {
 
 // Draw test on our lander display at x, y, returning new y
 // value that is immediately below the new line of text.
+// Printed straight from flash, so nothing is copied to RAM.
 byte drawString(
   const byte x, const byte y,
-  const char *string
+  const __FlashStringHelper *string
 ) {
-  lander_display.drawStr(x, y, string);
+  lander_display.setCursor(x, y);
+  lander_display.print(string);
   return (y + lander_display.getMaxCharHeight());  // return new y_offset on display
 }
 
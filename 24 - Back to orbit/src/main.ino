@@ -247,8 +247,8 @@ void updateLanderDisplay(enum LIFTOFF_STATE liftoff_state,
   lander_display.firstPage();
   do {
     lander_display.setFontPosTop();
-    byte y_offset = drawString(0, 0, "Exploration Lander");
-    y_offset = drawString(0, y_offset, "Liftoff Sequence");
+    byte y_offset = drawString(0, 0, F("Exploration Lander"));
+    y_offset = drawString(0, y_offset, F("Liftoff Sequence"));
 
     if (liftoff_state == LIFTOFF) {
       const char LIFTOFF_TEXT[] = "Liftoff!";
@@ -276,13 +276,13 @@ void updateLanderDisplay(enum LIFTOFF_STATE liftoff_state,
       y_offset = lander_display.getDisplayHeight() - (4 * lander_display.getMaxCharHeight());
 
       // Display last four lines
-      y_offset = displayLeverSetting("Thrusters: ", thruster_lever, y_offset);
-      y_offset = displayLeverSetting("Systems  : ", systems_lever, y_offset);
-      y_offset = displayLeverSetting("Confirm  : ", confirm_lever, y_offset);
+      y_offset = displayLeverSetting(F("Thrusters: "), thruster_lever, y_offset);
+      y_offset = displayLeverSetting(F("Systems  : "), systems_lever, y_offset);
+      y_offset = displayLeverSetting(F("Confirm  : "), confirm_lever, y_offset);
 
       // Set y_offset to display text at bottom of display.
       y_offset = lander_display.getDisplayHeight() - lander_display.getMaxCharHeight();
-      drawString(0, y_offset, (String("Countdown ") + liftoffStateToString(liftoff_state)).c_str());
+      drawLabelValue(0, y_offset, F("Countdown "), liftoffStateToString(liftoff_state));
     }
     // Draw a picture of our lander on right side of display.  During the liftoff this
     // will be animated by changing the lander_height variable OUTSIDE the "do" loop.
@@ -311,41 +311,33 @@ void updateLanderDisplay(enum LIFTOFF_STATE liftoff_state,
 
 // Display a lever setting with a title and state.
 byte displayLeverSetting(
-  String leverName,
+  const __FlashStringHelper *leverName,
   bool leverVal,
   byte yOffset
 ) {
-  return drawString(
-    0,
-    yOffset,
-    (leverName + onOff(leverVal)).c_str()
-  );
+  return drawLabelValue(0, yOffset, leverName, onOff(leverVal));
 }
 
 // Convert bool to on/off
-String onOff(bool val) {
-  return val ? "ON" : "OFF";
+const __FlashStringHelper *onOff(bool val) {
+  return val ? F("ON") : F("OFF");
 }
 
 // "helper" function that returns a different string for each enum state.
-String liftoffStateToString(enum LIFTOFF_STATE liftoff_state) {
+const __FlashStringHelper *liftoffStateToString(enum LIFTOFF_STATE liftoff_state) {
   switch (liftoff_state) {
     case INIT:
-      return ("Init");
-      break;
+      return F("Init");
     case PENDING:
-      return ("Pending");
-      break;
+      return F("Pending");
     case COUNTDOWN:
-      return ("Active");
-      break;
+      return F("Active");
     case LIFTOFF:
-      return ("Complete");
-      break;
+      return F("Complete");
     case ABORT:
-      return ("ABORT");
-      break;
+      return F("ABORT");
   }
+  return F("");
 }
 
 // Display milliseconds on our counter as minutes:seconds (MM:SS)
@@ -362,8 +354,18 @@ void displayCounter(unsigned long milliseconds) {
 
 // Draw a line of text on our OLED display at x, y, returning new y
 // value that is immediately below the new line of text.
-byte drawString(byte x, byte y, const char *string) {
-  lander_display.drawStr(x, y, string);
+// Printed straight from flash, so nothing is copied to RAM.
+byte drawString(byte x, byte y, const __FlashStringHelper *string) {
+  lander_display.setCursor(x, y);
+  lander_display.print(string);
+  return (y + lander_display.getMaxCharHeight());  // return new y_offset on display
+}
+
+// Draw a label and its value on one line, returning new y
+byte drawLabelValue(byte x, byte y, const __FlashStringHelper *label, const __FlashStringHelper *value) {
+  lander_display.setCursor(x, y);
+  lander_display.print(label);
+  lander_display.print(value);  // Carries on from the end of the label
   return (y + lander_display.getMaxCharHeight());  // return new y_offset on display
 }
 
@@ -1,7 +1,7 @@
 #include "Arduino.h"
 #include <U8g2lib.h>  // OLED Display library
 #include <TM1637Display.h> // 7-seg display library
-#include <Keypad.h>  // 4x4 button matrix keypad library
+#include <StaticKeypad.h>  // 4x4 button matrix keypad library
 #include "landingGearBitmaps.h"
 
 
@@ -35,18 +35,23 @@ constexpr int GEAR_BITMAP_COUNT = sizeof(SWITCH_BITMAPS) / sizeof(SWITCH_BITMAPS
 constexpr byte ROWS = 4;
 constexpr byte COLS = 4;
 
-byte colPins[ROWS] = { 10, 11, 12, 13 };
-byte rowPins[COLS] = { 9, 8, 7, 6 };
+constexpr byte colPins[COLS] = { 10, 11, 12, 13 };
+constexpr byte rowPins[ROWS] = { 9, 8, 7, 6 };
 
-char buttons[ROWS][COLS] = {
+const char buttons[ROWS][COLS] PROGMEM = {
   { '1', '2', '3', 'A' },  // 1st row
   { '4', '5', '6', 'B' },  // 2nd row
   { '7', '8', '9', 'C' },  // 3rd row
   { '*', '0', '#', 'D' }   // 4th row
 };
 
-// Initialize keypad
-auto controlPad = Keypad(makeKeymap(buttons), rowPins, colPins, ROWS, COLS);
+// Initialize keypad.  Pins and keymap are part of its type (see
+// StaticKeypad.h), so neither takes RAM.
+StaticKeypad<
+  KeypadPins<rowPins[0], rowPins[1], rowPins[2], rowPins[3]>,
+  KeypadPins<colPins[0], colPins[1], colPins[2], colPins[3]>,
+  buttons
+> controlPad;
 
 
 // States
@@ -66,10 +71,16 @@ enum GEAR_STATE {
 // Function Hoisting
 byte drawString(
   byte x, byte y,
-  const char* string
+  const __FlashStringHelper* string
 );
 
-String liftoffStateToString(enum APPROACH_STATE approach_state);
+byte drawLabelValue(
+  byte x, byte y,
+  const __FlashStringHelper* label,
+  const __FlashStringHelper* value
+);
+
+const __FlashStringHelper* liftoffStateToString(enum APPROACH_STATE approach_state);
 
 void preflightDisplay(
   enum APPROACH_STATE approach_state,
@@ -92,15 +103,10 @@ void processState(
   bool confirm_lever
 );
 
-const char* showStatus(
-  String title,
-  bool status
-);
-
-String onOff(bool val);
+const __FlashStringHelper* onOff(bool val);
 
 byte displayLeverSetting(
-  const String& leverName,
+  const __FlashStringHelper* leverName,
   bool leverVal,
   byte yOffset
 );
@@ -135,11 +141,11 @@ void loop() {
   const bool confirm_lever = digitalRead(CONFIRM_LEVER);
 
   Serial.println(approach_state);
-  Serial.print("  Switches: ");
+  Serial.print(F("  Switches: "));
   Serial.print(thrust_lever);
-  Serial.print(", ");
+  Serial.print(F(", "));
   Serial.print(systems_lever);
-  Serial.print(", ");
+  Serial.print(F(", "));
   Serial.println(confirm_lever);
 
   processState(
@@ -174,7 +180,7 @@ void processState(
 ) {
   switch (approach_state) {
     case APPROACH_INIT:
-      Serial.println("case APPROACH_INIT");
+      Serial.println(F("case APPROACH_INIT"));
       // All levers off
       if (!thrust_lever && !systems_lever && !confirm_lever) {
         approach_state = APPROACH_PREFLIGHT;
@@ -182,7 +188,7 @@ void processState(
       break;
 
     case APPROACH_PREFLIGHT:
-      Serial.println("case APPROACH_PREFLIGHT");
+      Serial.println(F("case APPROACH_PREFLIGHT"));
       // All levers on
       if (thrust_lever && systems_lever && confirm_lever) {
         approach_state = APPROACH_FINAL;
@@ -190,7 +196,7 @@ void processState(
       break;
 
     case APPROACH_FINAL:
-      Serial.println("case APPROACH_FINAL");
+      Serial.println(F("case APPROACH_FINAL"));
       const char customKey = controlPad.getKey();
       if (customKey && customKey != last_key) {
         Serial.println(customKey);
@@ -207,7 +213,7 @@ void processState(
     gear_state = GEAR_IDLE;
   }
 
-  Serial.print("Gear: ");
+  Serial.print(F("Gear: "));
   Serial.println(current_gear_bitmap);
   Serial.println(gear_state);
 }
@@ -241,35 +247,36 @@ void preflightDisplay(
   landerDisplay.setFontPosTop();
 
   // Display headers
-  byte y_offset = drawString(0, 0, "Exploration Lander");
-  drawString(0, y_offset, "Approach Sequence");
+  byte y_offset = drawString(0, 0, F("Exploration Lander"));
+  drawString(0, y_offset, F("Approach Sequence"));
 
   // Set y_offset to point four lines above bottom of display
   y_offset = landerDisplay.getDisplayHeight() - (4 * landerDisplay.getMaxCharHeight());
 
   // Display statuses
   y_offset = displayLeverSetting(
-    "Thrusters: ",
+    F("Thrusters: "),
     thruster_lever,
     y_offset
   );
 
   y_offset = displayLeverSetting(
-    "Systems  : ",
+    F("Systems  : "),
     systems_lever,
     y_offset
   );
 
   y_offset = displayLeverSetting(
-    "Confirm  : ",
+    F("Confirm  : "),
     confirm_lever,
     y_offset
   );
 
   // Display countdown state
-  drawString(
+  drawLabelValue(
     0, y_offset,
-    (String("Countdown ") + liftoffStateToString(approach_state)).c_str()
+    F("Countdown "),
+    liftoffStateToString(approach_state)
   );
 }
 
@@ -293,42 +300,52 @@ void finalDisplay(
 }
 
 // Return a different string for each enum state.
-String liftoffStateToString(enum APPROACH_STATE approach_state) {
+const __FlashStringHelper* liftoffStateToString(enum APPROACH_STATE approach_state) {
   switch (approach_state) {
     case APPROACH_INIT:
-      return ("Init");
+      return F("Init");
     case APPROACH_PREFLIGHT:
-      return ("Preflight");
+      return F("Preflight");
     case APPROACH_FINAL:
-      return("Final");
+      return F("Final");
   }
 
-  return "";
+  return F("");
 }
 
-// Draw a line of text on our OLED display at x, y, returning new y
+// Draw a line of text on our OLED display at x, y, returning new y.
+// Printed straight from flash, so nothing is copied to RAM.
 byte drawString(
   byte x, byte y,
-  const char* string
+  const __FlashStringHelper* string
 ) {
-  landerDisplay.drawStr(x, y, string);
+  landerDisplay.setCursor(x, y);
+  landerDisplay.print(string);
+  return (y + landerDisplay.getMaxCharHeight());  // return new y_offset on display
+}
+
+// Draw a label and its value as one line of text at x, y, returning new y
+byte drawLabelValue(
+  byte x, byte y,
+  const __FlashStringHelper* label,
+  const __FlashStringHelper* value
+) {
+  landerDisplay.setCursor(x, y);
+  landerDisplay.print(label);
+  landerDisplay.print(value);  // Carries on from the end of the label
   return (y + landerDisplay.getMaxCharHeight());  // return new y_offset on display
 }
 
 // Display a lever setting with a title and state.
 byte displayLeverSetting(
-  const String& leverName,
+  const __FlashStringHelper* leverName,
   bool leverVal,
   byte yOffset
 ) {
-  return drawString(
-    0,
-    yOffset,
-    (leverName + onOff(leverVal)).c_str()
-  );
+  return drawLabelValue(0, yOffset, leverName, onOff(leverVal));
 }
 
 // Convert bool to on/off
-String onOff(bool val) {
-  return val ? "ON" : "OFF";
+const __FlashStringHelper* onOff(bool val) {
+  return val ? F("ON") : F("OFF");
 }
@@ -0,0 +1,115 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// On-device OLED benchmark.  Draws each lander screen through LanderScreen
+// in the buffer mode the env was built with and prints, over Serial, the
+// static RAM of the build and the frame time and peak stack of every screen.
+//
+//   pio run -e oledbench_2 -t upload && pio device monitor
+//
+// Run oledbench_1, oledbench_2 and oledbench_f and compare the tables to
+// pick OLED_BUFFER in LanderConfig.h.
+
+#include "Arduino.h"
+#include "LanderConfig.h"
+#include "LanderDisplay.h"
+#include "LanderHardware.h"
+#include "endingBitmaps.h"
+
+namespace {
+
+constexpr byte FRAMES = 32;
+constexpr byte STACK_PAINT = 0xA5;
+
+extern "C" char __data_start;
+extern "C" char __bss_end;
+extern "C" char __heap_start;
+extern "C" char* __brkval;
+
+char* heapTop() {
+    return __brkval != nullptr ? __brkval : &__heap_start;
+}
+
+// Fill the free RAM below the current stack frame so the deepest point a
+// screen reaches shows up as overwritten paint
+void paintStack() {
+    char here;
+    for (char* p = heapTop(); p < &here - 8; p++) {
+        *p = STACK_PAINT;
+    }
+}
+
+unsigned int peakStack() {
+    const char* p = heapTop();
+    while (p <= reinterpret_cast<const char*>(RAMEND) && *p == STACK_PAINT) {
+        p++;
+    }
+    return RAMEND + 1 - reinterpret_cast<uintptr_t>(p);
+}
+
+template <typename Draw>
+void benchScreen(const __FlashStringHelper* name, const Draw& draw) {
+    unsigned long total = 0;
+    unsigned long longest = 0;
+
+    paintStack();
+    for (byte i = 0; i < FRAMES; i++) {
+        const unsigned long started = micros();
+        LanderScreen::render(landerDisplay, draw);
+        const unsigned long frame = micros() - started;
+
+        total += frame;
+        if (frame > longest) {
+            longest = frame;
+        }
+    }
+    const unsigned int stack = peakStack();
+
+    Serial.print(name);
+    Serial.print(F("\tavg "));
+    Serial.print(total / FRAMES);
+    Serial.print(F("us\tmax "));
+    Serial.print(longest);
+    Serial.print(F("us\tstack "));
+    Serial.println(stack);
+}
+
+}  // namespace
+
+void setup() {
+    Serial.begin(9600);
+    LanderHardware::init();
+
+    Serial.print(F("oled buffer "));
+    Serial.print(LanderScreen::BUFFER_BYTES);
+    Serial.print(F(" bytes, "));
+    Serial.print(LanderScreen::PASSES);
+    Serial.println(F(" passes per frame"));
+
+    Serial.print(F("static ram "));
+    Serial.print(&__bss_end - &__data_start);
+    Serial.print(F(" bytes, free "));
+    Serial.println(LanderHardware::freeMemory());
+
+    InputFrame levers = {};
+    levers.thrust_lever = true;
+    levers.confirm_lever = true;
+
+    benchScreen(F("preflight"), [&] {
+        LanderDisplay::displayPreFlight(APPROACH_PREFLIGHT, levers);
+    });
+    benchScreen(F("in-flight"), [] {
+        LanderDisplay::displayInFlight(INITIAL_DISTANCE / 2, 12, -7, 5);
+    });
+    benchScreen(F("final"), [] {
+        LanderDisplay::displayFinal(1, 1, LanderRatio::fromInt(1));
+        LanderDisplay::displayInFlight(INITIAL_DISTANCE / 20, 2, 1, -1);
+    });
+    benchScreen(F("ending"), [] {
+        LanderDisplay::displayEnding("   7.600 Sec", ENDING_BITMAP_SUCCESS);
+    });
+}
+
+void loop() {
+}
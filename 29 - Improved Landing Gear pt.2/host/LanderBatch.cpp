@@ -0,0 +1,242 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#include "LanderBatch.h"
+#include "LanderConfig.h"
+#include "LanderRandom.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+static_assert(
+    THRUST_STEP == LanderSpeed::fromInt(1) && DRAG == LanderRatio() && TICK_SCALE == LanderRatio::fromInt(1),
+    "LanderBatch models the whole-unit physics defaults only"
+);
+
+constexpr int16_t GEAR_DOWN_INDEX = 3;  // Last of the four gear bitmaps
+constexpr int16_t GEAR_LOWERING_STEP = GEAR_LOWERING;
+constexpr int16_t GEAR_RAISING_STEP = GEAR_RAISING;
+
+// What happened to each lander in a step, used to look up its reward.
+// 0 means it had already landed.
+constexpr int16_t REWARD_TICK = 1;    // Still flying
+constexpr int16_t REWARD_ENDING = 2;  // Landed this step, plus its ENDING_OUTCOME
+constexpr int16_t FINAL_DISTANCE = INITIAL_DISTANCE / 10;
+constexpr int16_t MAX_SAFE_SPEED = MAX_LANDING_SPEED.floor();  // Speeds are whole units here
+constexpr int16_t BAY_HALF_WIDTH = (MAX_MOTHER_SHIP_WIDTH + 1) / 2;
+constexpr int16_t BAY_HALF_HEIGHT = (MAX_MOTHER_SHIP_HEIGHT + 1) / 2;
+
+// Branch-free version of LanderGame::update() for the in-flight states.
+// Every rule is a compare turned into 0/1 and blended with a select.  The
+// arrays come in as restrict parameters because GCC only trusts restrict
+// there, and it won't vectorize without knowing they never alias.
+__attribute__((noinline)) void stepKernel(
+    const size_t count,
+    const uint8_t* __restrict act,
+    const uint8_t driftControl,
+    int16_t* __restrict dist,
+    int16_t* __restrict spd,
+    int16_t* __restrict xs,
+    int16_t* __restrict ys,
+    int16_t* __restrict gears,
+    int16_t* __restrict gearStates,
+    int16_t* __restrict finals,
+    int16_t* __restrict ages,
+    int16_t* __restrict starts,
+    int16_t* __restrict elapsed,
+    int16_t* __restrict landed,
+    int16_t* __restrict outcomes,
+    int16_t* __restrict events,
+    uint32_t* __restrict states,
+    const uint32_t* __restrict gammas
+) {
+    // Masks are 0 or all ones (-1) so selects become and/or blends
+    for (size_t i = 0; i < count; i++) {
+        const int16_t a = act[i];
+        const int16_t keep = -static_cast<int16_t>(landed[i] != 0);  // Landed landers keep their final state
+
+        // processSpeedState
+        const int16_t raise = a == RAISE_SPEED;
+        const int16_t lower = (a == LOWER_SPEED) & (spd[i] > 0);
+        const int16_t newSpeed = spd[i] + raise - lower;
+        const int16_t newAge = ages[i] + 1;
+        const int16_t firstThrust = -static_cast<int16_t>(raise & (starts[i] < 0));
+        const int16_t newStart = (newAge & firstThrust) | (starts[i] & ~firstThrust);
+
+        // processGearState; lowering only works once already on final
+        const int16_t lowerGear = -static_cast<int16_t>((a == LOWER_GEAR) & (finals[i] != 0) & (gears[i] != GEAR_DOWN_INDEX));
+        const int16_t raiseGear = -static_cast<int16_t>((a == RAISE_GEAR) & (gears[i] != 0));
+        int16_t gearState = (gearStates[i] & ~(lowerGear | raiseGear)) | (lowerGear & GEAR_LOWERING_STEP) | raiseGear;
+
+        // processSteeringState
+        const int16_t steerX =
+            ((a == STEER_LEFT) | (a == STEER_UP_LEFT) | (a == STEER_DOWN_LEFT)) -
+            ((a == STEER_RIGHT) | (a == STEER_UP_RIGHT) | (a == STEER_DOWN_RIGHT));
+        const int16_t steerY =
+            ((a == STEER_UP) | (a == STEER_UP_LEFT) | (a == STEER_UP_RIGHT)) -
+            ((a == STEER_DOWN) | (a == STEER_DOWN_LEFT) | (a == STEER_DOWN_RIGHT));
+
+        // processApproachInFlight checks for final before the distance moves
+        const int16_t finalApproach = finals[i] | (dist[i] < FINAL_DISTANCE);
+
+        // updateGearAnimation
+        const int16_t gear = gears[i] + gearState;
+        gearState &= -static_cast<int16_t>((gear != 0) & (gear != GEAR_DOWN_INDEX));
+
+        // updateMotherShipDrift, LanderRandom::nextDrift() spelled out on the arrays
+        const uint32_t state = states[i] + gammas[i];
+        const uint32_t bits = LanderRandom::mix(state);
+        const int16_t driftX = LanderRandom::drift(static_cast<uint16_t>(bits), driftControl);
+        const int16_t driftY = LanderRandom::drift(static_cast<uint16_t>(bits >> 16), driftControl);
+
+        const int16_t x = std::min<int16_t>(std::max<int16_t>(xs[i] + steerX + driftX, -MAX_DRIFT), MAX_DRIFT);
+        const int16_t y = std::min<int16_t>(std::max<int16_t>(ys[i] + steerY + driftY, -MAX_DRIFT), MAX_DRIFT);
+
+        // updateDistance, then the getOutcome() checks.  The outcome values are
+        // ordered so the highest priority failure is also the largest number.
+        const int16_t newDistance = dist[i] - newSpeed;
+        const int16_t touchdown = newDistance <= 0;
+
+        const int16_t inBay = (std::abs(x) < BAY_HALF_WIDTH) & (std::abs(y) < BAY_HALF_HEIGHT);
+        const int16_t ending = std::max<int16_t>(
+            std::max<int16_t>((1 - inBay) * ENDING_MISSED_MOTHER_SHIP, (newSpeed > MAX_SAFE_SPEED) * ENDING_TOO_FAST),
+            (gear != GEAR_DOWN_INDEX) * ENDING_NO_GEAR
+        );
+
+        dist[i] = (newDistance & ~keep) | (dist[i] & keep);
+        spd[i] = (newSpeed & ~keep) | (spd[i] & keep);
+        xs[i] = (x & ~keep) | (xs[i] & keep);
+        ys[i] = (y & ~keep) | (ys[i] & keep);
+        gears[i] = (gear & ~keep) | (gears[i] & keep);
+        gearStates[i] = (gearState & ~keep) | (gearStates[i] & keep);
+        finals[i] = (finalApproach & ~keep) | (finals[i] & keep);
+        ages[i] = (newAge & ~keep) | (ages[i] & keep);
+        starts[i] = (newStart & ~keep) | (starts[i] & keep);
+        elapsed[i] = (((newAge - newStart) & ~(newStart >> 15)) & ~keep) | (elapsed[i] & keep);
+        outcomes[i] = (ending & ~keep) | (outcomes[i] & keep);
+        landed[i] = (touchdown & ~keep) | (landed[i] & keep);
+        events[i] = (keep + 1) * (REWARD_TICK + touchdown * (REWARD_ENDING + ending - REWARD_TICK));
+        states[i] = state;
+    }
+}
+
+// Float math in the kernel stops GCC if-converting it (a multiply "could
+// trap"), so rewards are looked up from the step events in a second pass.
+void rewardKernel(
+    const size_t count,
+    const LanderBatch::Rewards& rewards,
+    const int16_t* __restrict events,
+    float* __restrict rewardOut
+) {
+    const float table[REWARD_ENDING + 4] = {
+        0.0f,
+        rewards.tick,
+        rewards.tick + rewards.outcome[ENDING_SUCCESS],
+        rewards.tick + rewards.outcome[ENDING_NO_GEAR],
+        rewards.tick + rewards.outcome[ENDING_TOO_FAST],
+        rewards.tick + rewards.outcome[ENDING_MISSED_MOTHER_SHIP],
+    };
+
+    for (size_t i = 0; i < count; i++) {
+        rewardOut[i] = table[events[i]];
+    }
+}
+
+}  // namespace
+
+LanderBatch::LanderBatch(const size_t count, const uint32_t seed, const int drift_control) :
+    count(count),
+    drift_control(drift_control),
+    distance(count),
+    speed(count),
+    x_offset(count),
+    y_offset(count),
+    gear_index(count),
+    gear_state(count),
+    final_approach(count),
+    age(count),
+    start(count),
+    elapsed_ticks(count),
+    done(count),
+    outcome(count),
+    events(count),
+    reward(count),
+    rng_state(count),
+    rng_gamma(count)
+{
+    reset(seed);
+}
+
+LanderBatch::Observation LanderBatch::reset(const uint32_t seed) {
+    for (size_t i = 0; i < count; i++) {
+        const LanderRandom random(seed, static_cast<uint32_t>(i));
+        rng_state[i] = random.getState();
+        rng_gamma[i] = random.getGamma();
+        resetLander(i);
+    }
+    return observe();
+}
+
+void LanderBatch::resetDone() {
+    for (size_t i = 0; i < count; i++) {
+        if (done[i]) {
+            resetLander(i);
+        }
+    }
+}
+
+void LanderBatch::resetLander(const size_t i) {
+    distance[i] = INITIAL_DISTANCE;
+    speed[i] = 0;
+    x_offset[i] = 0;
+    y_offset[i] = 0;
+    gear_index[i] = 0;
+    gear_state[i] = GEAR_IDLE;
+    final_approach[i] = 0;
+    age[i] = 0;
+    start[i] = -1;
+    elapsed_ticks[i] = 0;
+    done[i] = 0;
+    outcome[i] = 0;
+    reward[i] = 0.0f;
+}
+
+LanderBatch::Observation LanderBatch::step(const uint8_t* actions) {
+    stepKernel(
+        count, actions, static_cast<uint8_t>(drift_control),
+        distance.data(), speed.data(), x_offset.data(), y_offset.data(),
+        gear_index.data(), gear_state.data(), final_approach.data(),
+        age.data(), start.data(), elapsed_ticks.data(),
+        done.data(), outcome.data(), events.data(), rng_state.data(), rng_gamma.data()
+    );
+    rewardKernel(count, rewards, events.data(), reward.data());
+    return observe();
+}
+
+LanderBatch::Observation LanderBatch::observe() const {
+    Observation observation;
+    observation.count = count;
+    observation.distance = distance.data();
+    observation.speed = speed.data();
+    observation.x_offset = x_offset.data();
+    observation.y_offset = y_offset.data();
+    observation.gear_index = gear_index.data();
+    observation.gear_state = gear_state.data();
+    observation.final_approach = final_approach.data();
+    observation.elapsed_ticks = elapsed_ticks.data();
+    observation.done = done.data();
+    observation.outcome = outcome.data();
+    observation.reward = reward.data();
+    return observation;
+}
+
+size_t LanderBatch::doneCount() const {
+    size_t landedCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        landedCount += done[i];
+    }
+    return landedCount;
+}
@@ -0,0 +1,90 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_BATCH_H
+#define LANDER_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "LanderTypes.h"
+
+// Gym-style environment that flies N landers at once under the LanderGame
+// rules (speed, gear, steering, drift, distance and the ending checks).
+// State is kept as one array per field so step() runs as a flat loop the
+// compiler vectorizes; build with -O3 -march=native to get AVX2.
+//
+// Every lander starts in APPROACH_IN_FLIGHT; the lever preflight has no
+// decisions in it.  A lander that lands is frozen until reset().
+class LanderBatch {
+public:
+  // Read-only views straight into the state arrays, valid until the next
+  // reset(count) that changes the batch size.
+  struct Observation {
+    size_t count;
+    const int16_t* distance;
+    const int16_t* speed;
+    const int16_t* x_offset;
+    const int16_t* y_offset;
+    const int16_t* gear_index;
+    const int16_t* gear_state;
+    const int16_t* final_approach;  // 1 once on final, gear can be lowered
+    const int16_t* elapsed_ticks;   // Ticks since first RAISE_SPEED
+    const int16_t* done;            // 1 once landed
+    const int16_t* outcome;         // ENDING_OUTCOME, valid once done
+    const float* reward;            // Reward from the last step()
+  };
+
+  // Reward per tick spent flying, and on landing per ENDING_OUTCOME
+  struct Rewards {
+    float tick = -1.0f;
+    float outcome[4] = { 1000.0f, -200.0f, -1000.0f, -1000.0f };
+  };
+
+  explicit LanderBatch(size_t count, uint32_t seed = 1, int drift_control = 3);
+
+  // Put every lander back at the start of the approach
+  Observation reset(uint32_t seed);
+
+  // Restart only the landers that are done, leaving the rest in flight
+  void resetDone();
+
+  // One tick for every lander.  actions holds a LANDER_CONTROLS per lander.
+  Observation step(const uint8_t* actions);
+
+  Observation observe() const;
+  size_t size() const { return count; }
+  size_t doneCount() const;
+
+  Rewards rewards;
+
+  // Lander i draws its drift from LanderRandom(seed, i), with both drifts
+  // from one draw as in LanderRandom::nextDrift().
+
+private:
+  size_t count;
+  int drift_control;
+
+  std::vector<int16_t> distance;
+  std::vector<int16_t> speed;
+  std::vector<int16_t> x_offset;
+  std::vector<int16_t> y_offset;
+  std::vector<int16_t> gear_index;
+  std::vector<int16_t> gear_state;
+  std::vector<int16_t> final_approach;
+  std::vector<int16_t> age;          // Ticks since reset
+  std::vector<int16_t> start;        // Age at first RAISE_SPEED, -1 until then
+  std::vector<int16_t> elapsed_ticks;
+  std::vector<int16_t> done;
+  std::vector<int16_t> outcome;
+  std::vector<int16_t> events;       // Reward lookup per lander for the last step
+  std::vector<float> reward;
+  std::vector<uint32_t> rng_state;   // Per-lander LanderRandom, split in two
+  std::vector<uint32_t> rng_gamma;   // arrays so the step loop vectorizes
+
+  void resetLander(size_t i);
+};
+
+#endif // LANDER_BATCH_H
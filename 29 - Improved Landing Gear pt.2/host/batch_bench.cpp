@@ -0,0 +1,163 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Throughput benchmark and rules check for LanderBatch.
+//
+//   pio run -e batch && .pio/build/batch/program [--landers N] [--steps N]
+//   .pio/build/batch/program --verify
+//
+// --verify flies the same actions and drift through LanderBatch and through
+// one LanderGame per lander and stops at the first field that differs.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "LanderBatch.h"
+#include "LanderConfig.h"
+#include "LanderGame.h"
+#include "LanderRandom.h"
+
+namespace {
+
+constexpr int ACTION_COUNT = LOWER_SPEED + 1;
+constexpr int ACTION_BUFFERS = 16;
+
+// Actions biased towards thrust so landers actually reach the mother ship
+uint8_t randomAction(std::mt19937& random) {
+    const uint32_t roll = random() % 100;
+    if (roll < 30) {
+        return RAISE_SPEED;
+    }
+    if (roll < 40) {
+        return LOWER_SPEED;
+    }
+    return static_cast<uint8_t>(random() % ACTION_COUNT);
+}
+
+int verify(const size_t landers, const uint32_t seed) {
+    LanderBatch batch(landers, seed);
+    std::vector<LanderGame> games(landers);
+    std::vector<LanderRandom> streams;
+    std::vector<uint8_t> actions(landers);
+    std::mt19937 random(seed);
+
+    // Take every game through the lever preflight so it is in flight like the batch
+    InputFrame frame = {};
+    for (size_t i = 0; i < landers; i++) {
+        games[i].update(frame, 0);
+        frame.thrust_lever = frame.systems_lever = frame.confirm_lever = true;
+        games[i].update(frame, 0);
+        frame.thrust_lever = frame.systems_lever = frame.confirm_lever = false;
+        streams.emplace_back(seed, static_cast<uint32_t>(i));
+    }
+
+    frame.thrust_lever = frame.systems_lever = frame.confirm_lever = true;
+    size_t steps = 0;
+
+    while (batch.doneCount() < landers) {
+        for (size_t i = 0; i < landers; i++) {
+            actions[i] = randomAction(random);
+        }
+
+        const LanderBatch::Observation obs = batch.step(actions.data());
+        steps++;
+
+        for (size_t i = 0; i < landers; i++) {
+            LanderGame& game = games[i];
+            if (game.isGameOver()) {
+                continue;
+            }
+
+            streams[i].nextDrift(DRIFT_CONTROL, frame.drift_x, frame.drift_y);
+            frame.key = static_cast<LANDER_CONTROLS>(actions[i]);
+            game.update(frame, steps * SIMULATION_TICK_MS);
+
+            const bool same =
+                obs.distance[i] == game.getLanderDistance() &&
+                obs.speed[i] == game.getLanderSpeed() &&
+                obs.x_offset[i] == game.getMotherShipXOffset() &&
+                obs.y_offset[i] == game.getMotherShipYOffset() &&
+                obs.gear_index[i] == game.getCurrentGearBitmapIndex() &&
+                obs.gear_state[i] == game.getGearState() &&
+                // Touchdown moves LanderGame on to APPROACH_ENDING
+                obs.final_approach[i] == (game.getApproachState() >= APPROACH_FINAL) &&
+                obs.done[i] == game.isGameOver() &&
+                (!game.isGameOver() || obs.outcome[i] == game.getOutcome());
+
+            if (!same) {
+                fprintf(stderr, "lander %zu differs at step %zu\n", i, steps);
+                return 1;
+            }
+        }
+    }
+
+    printf("verify: %zu landers agree with LanderGame for %zu steps\n", landers, steps);
+    return 0;
+}
+
+void benchmark(const size_t landers, const size_t steps, const uint32_t seed) {
+    LanderBatch batch(landers, seed);
+    std::mt19937 random(seed);
+
+    std::vector<std::vector<uint8_t>> actions(ACTION_BUFFERS, std::vector<uint8_t>(landers));
+    for (auto& buffer : actions) {
+        for (auto& action : buffer) {
+            action = randomAction(random);
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    size_t landed = 0;
+
+    for (size_t step = 0; step < steps; step++) {
+        batch.step(actions[step % ACTION_BUFFERS].data());
+
+        // Recycle landed landers now and then so the batch stays busy
+        if (step % 256 == 255) {
+            landed += batch.doneCount();
+            batch.resetDone();
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double rate = static_cast<double>(landers) * steps / seconds;
+
+    printf("%zu landers x %zu steps in %.3f s: %.1fM lander-steps/s (%zu landings)\n",
+           landers, steps, seconds, rate / 1e6, landed);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t landers = 4096;
+    size_t steps = 20000;
+    uint32_t seed = 1;
+    bool check = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--verify") == 0) {
+            check = true;
+        } else if (strcmp(argv[i], "--landers") == 0 && i + 1 < argc) {
+            landers = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+            steps = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else {
+            fprintf(stderr, "usage: %s [--verify] [--landers N] [--steps N] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (check) {
+        return verify(landers, seed);
+    }
+
+    benchmark(landers, steps, seed);
+    return 0;
+}
@@ -0,0 +1,365 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Keypad debounce on synthetic bounce traces: the library's old scan gate
+// (one scan per debounce time) against per-key vertical counter debouncing
+// (Keypad::setDebounceSamples()).
+//
+//   pio run -e debounce && .pio/build/debounce/program [--trials N] [--bounce MS] [--glitch MS] [--seed S] [--verify]
+//
+// Each trial presses one key of a 4x4 matrix and lets it go.  The contact
+// chatters for up to --bounce ms after every press and release, and short
+// glitches close other keys now and then, as a noisy line would.  The
+// matrix is read through a KeypadBus, and loop() calls getKeys() every
+// LOOP_US of simulated time.  For every setting it prints how long a press
+// and a release take to come out as events, and how many events come out
+// that no press made: extra presses from bounce, and presses from glitches.
+//
+// --verify checks the vertical counters against a plain per-key counter on
+// random matrix readings.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <Keypad.h>
+
+// The Arduino core, on a simulated clock
+namespace {
+unsigned long now_us = 0;
+}
+
+unsigned long millis() { return now_us / 1000; }
+unsigned long micros() { return now_us; }
+void delay(const unsigned long ms) { now_us += ms * 1000; }
+void delayMicroseconds(const unsigned int us) { now_us += us; }
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+int digitalRead(uint8_t) { return HIGH; }
+
+namespace {
+
+constexpr byte ROWS = 4;
+constexpr byte COLS = 4;
+constexpr byte KEYS = ROWS * COLS;
+constexpr unsigned long LOOP_US = 100;        // Time between getKeys() calls
+constexpr unsigned long CHATTER_MIN_US = 50;  // Contact chatter step range
+constexpr unsigned long CHATTER_MAX_US = 400;
+constexpr unsigned long GLITCH_EVERY_US = 250000;  // Mean time between glitches
+
+char keymap[ROWS][COLS] = {
+    {'1', '2', '3', 'A'},
+    {'4', '5', '6', 'B'},
+    {'7', '8', '9', 'C'},
+    {'*', '0', '#', 'D'},
+};
+byte rowPins[ROWS] = {0, 1, 2, 3};
+byte colPins[COLS] = {4, 5, 6, 7};
+
+// One contact change of a key
+struct Change {
+    unsigned long at;
+    byte key;
+    bool closed;
+};
+
+// The whole run's contact changes, in time order, played back as time passes
+class Trace {
+public:
+    std::vector<Change> changes;
+
+    void rewind() {
+        next = 0;
+        memset(closed, 0, sizeof(closed));
+    }
+
+    void advanceTo(const unsigned long time) {
+        while (next < changes.size() && changes[next].at <= time) {
+            closed[changes[next].key] = changes[next].closed;
+            next++;
+        }
+    }
+
+    bool isClosed(const byte key) const { return closed[key]; }
+
+private:
+    size_t next = 0;
+    bool closed[KEYS] = {};
+};
+
+Trace trace;
+
+// Reads the trace instead of pins
+class TraceBus : public KeypadBus {
+public:
+    void begin(const byte*, byte, const byte*, byte) override {}
+
+    unsigned int readColumn(const byte column) override {
+        unsigned int closed = 0;
+        for (byte row = 0; row < ROWS; row++) {
+            if (trace.isClosed(row * COLS + column)) {
+                closed |= 1U << row;
+            }
+        }
+        return closed;
+    }
+};
+
+struct Options {
+    int trials = 2000;
+    unsigned long bounce_us = 5000;
+    unsigned long glitch_us = 1000;
+    unsigned int seed = 1;
+    bool verify = false;
+};
+
+// A press of one key, from first contact to the end of the release bounce
+struct Trial {
+    byte key;
+    unsigned long pressed;
+    unsigned long released;
+    unsigned long settled;
+};
+
+// Contact chatter from at for up to bounce_us, ending on closed
+void addBounce(std::vector<Change>& changes, std::mt19937& rng, const byte key,
+               const unsigned long at, const unsigned long bounce_us, const bool closed) {
+    const unsigned long end = at + std::uniform_int_distribution<unsigned long>(0, bounce_us)(rng);
+    std::uniform_int_distribution<unsigned long> step(CHATTER_MIN_US, CHATTER_MAX_US);
+    bool state = closed;
+    for (unsigned long t = at; t < end; t += step(rng)) {
+        changes.push_back({t, key, state});
+        state = !state;
+    }
+    changes.push_back({end, key, closed});
+}
+
+std::vector<Trial> makeTrace(const Options& options, std::mt19937& rng) {
+    std::vector<Trial> trials;
+    std::uniform_int_distribution<int> anyKey(0, KEYS - 1);
+    std::uniform_int_distribution<unsigned long> hold(40000, 300000);
+    std::uniform_int_distribution<unsigned long> gap(60000, 300000);
+
+    trace.changes.clear();
+    unsigned long t = 100000;
+    for (int i = 0; i < options.trials; i++) {
+        Trial trial;
+        trial.key = static_cast<byte>(anyKey(rng));
+        trial.pressed = t;
+        trial.released = t + hold(rng);
+        trial.settled = trial.released + options.bounce_us;
+        addBounce(trace.changes, rng, trial.key, trial.pressed, options.bounce_us, true);
+        addBounce(trace.changes, rng, trial.key, trial.released, options.bounce_us, false);
+        trials.push_back(trial);
+        t = trial.settled + gap(rng);
+    }
+
+    // Glitches on keys other than the one being pressed at the time
+    if (options.glitch_us > 0) {
+        std::exponential_distribution<double> wait(1.0 / GLITCH_EVERY_US);
+        std::uniform_int_distribution<unsigned long> length(options.glitch_us / 4, options.glitch_us);
+        size_t current = 0;
+        for (double g = wait(rng); g < t; g += wait(rng)) {
+            const auto at = static_cast<unsigned long>(g);
+            while (current + 1 < trials.size() && trials[current].settled < at) {
+                current++;
+            }
+            byte key;
+            do {
+                key = static_cast<byte>(anyKey(rng));
+            } while (key == trials[current].key);
+            trace.changes.push_back({at, key, true});
+            trace.changes.push_back({at + length(rng), key, false});
+        }
+    }
+
+    std::stable_sort(trace.changes.begin(), trace.changes.end(),
+                     [](const Change& a, const Change& b) { return a.at < b.at; });
+    return trials;
+}
+
+struct Setting {
+    const char* name;
+    unsigned int debounceTime;
+    byte samples;
+};
+
+struct Stats {
+    std::vector<double> pressMs;
+    std::vector<double> releaseMs;
+    int missed = 0;
+    int bouncePresses = 0;
+    int glitchPresses = 0;
+};
+
+double percentile(std::vector<double> values, const double p) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[static_cast<size_t>(p * (values.size() - 1))];
+}
+
+Stats run(const Setting& setting, const std::vector<Trial>& trials) {
+    Keypad keypad(makeKeymap(keymap), rowPins, colPins, ROWS, COLS);
+    TraceBus bus;
+    keypad.setBus(&bus);
+    keypad.setDebounceTime(setting.debounceTime);
+    keypad.setDebounceSamples(setting.samples);
+
+    KeypadEventRecord records[32];
+    KeypadEventQueue queue(records, 32);
+    KeypadEventReader reader(queue);
+    keypad.setEventQueue(&queue);
+
+    Stats stats;
+    trace.rewind();
+    now_us = 0;
+
+    const unsigned long end = trials.back().settled + 100000;
+    size_t current = 0;
+    bool sawPress = false;
+    bool sawRelease = false;
+
+    for (; now_us < end; now_us += LOOP_US) {
+        trace.advanceTo(now_us);
+        keypad.getKeys();
+
+        // Move on to the next trial once this one is over
+        while (current + 1 < trials.size() && now_us >= trials[current + 1].pressed) {
+            stats.missed += !sawPress;
+            current++;
+            sawPress = false;
+            sawRelease = false;
+        }
+        const Trial& trial = trials[current];
+
+        KeypadEventRecord event;
+        while (reader.read(event)) {
+            if (event.kcode != trial.key) {
+                stats.glitchPresses += event.kstate == PRESSED;
+                continue;
+            }
+            if (event.kstate == PRESSED) {
+                if (sawPress) {
+                    stats.bouncePresses++;
+                } else {
+                    stats.pressMs.push_back((now_us - trial.pressed) / 1000.0);
+                    sawPress = true;
+                }
+            } else if (event.kstate == RELEASED && !sawRelease && now_us >= trial.released) {
+                stats.releaseMs.push_back((now_us - trial.released) / 1000.0);
+                sawRelease = true;
+            }
+        }
+    }
+    stats.missed += !sawPress;
+    return stats;
+}
+
+void print(const Setting& setting, const Stats& stats) {
+    printf("%-22s press p50 %5.1f p99 %5.1f max %5.1f  release p50 %5.1f p99 %5.1f  "
+           "missed %3d  bounce %4d  glitch %4d\n",
+           setting.name,
+           percentile(stats.pressMs, 0.5), percentile(stats.pressMs, 0.99), percentile(stats.pressMs, 1.0),
+           percentile(stats.releaseMs, 0.5), percentile(stats.releaseMs, 0.99),
+           stats.missed, stats.bouncePresses, stats.glitchPresses);
+}
+
+// The vertical counters against a counter per key, on random readings
+bool verify(std::mt19937& rng) {
+    bool ok = true;
+    for (byte samples = 1; samples <= (1 << KEYPAD_DEBOUNCE_BITS); samples++) {
+        Keypad keypad(makeKeymap(keymap), rowPins, colPins, ROWS, COLS);
+        TraceBus bus;
+        keypad.setBus(&bus);
+        keypad.setDebounceTime(1);
+        keypad.setDebounceSamples(samples);
+
+        bool debounced[KEYS] = {};
+        byte count[KEYS] = {};
+        int mismatches = 0;
+        std::bernoulli_distribution flip(0.3);
+
+        trace.changes.clear();
+        trace.rewind();
+        for (int scan = 0; scan < 100000; scan++) {
+            for (byte key = 0; key < KEYS; key++) {
+                if (flip(rng)) {
+                    trace.changes.push_back({now_us, key, !trace.isClosed(key)});
+                }
+            }
+            trace.advanceTo(now_us);
+            now_us += 2000;  // Past the debounce time, so every call scans
+            keypad.getKeys();
+
+            for (byte key = 0; key < KEYS; key++) {
+                if (trace.isClosed(key) == debounced[key]) {
+                    count[key] = 0;
+                } else if (++count[key] == samples) {
+                    debounced[key] = !debounced[key];
+                    count[key] = 0;
+                }
+                const bool bit = bitRead(keypad.bitMap[key / COLS], key % COLS);
+                mismatches += bit != debounced[key];
+            }
+        }
+        printf("verify %d samples: %d mismatches\n", samples, mismatches);
+        ok = ok && mismatches == 0;
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--trials") == 0 && i + 1 < argc) {
+            options.trials = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--bounce") == 0 && i + 1 < argc) {
+            options.bounce_us = static_cast<unsigned long>(atof(argv[++i]) * 1000);
+        } else if (strcmp(argv[i], "--glitch") == 0 && i + 1 < argc) {
+            options.glitch_us = static_cast<unsigned long>(atof(argv[++i]) * 1000);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--verify") == 0) {
+            options.verify = true;
+        } else {
+            fprintf(stderr, "usage: %s [--trials N] [--bounce MS] [--glitch MS] [--seed S] [--verify]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (options.trials < 1) {
+        fprintf(stderr, "--trials must be at least 1\n");
+        return 2;
+    }
+
+    std::mt19937 rng(options.seed);
+    if (options.verify) {
+        return verify(rng) ? 0 : 1;
+    }
+
+    const std::vector<Trial> trials = makeTrace(options, rng);
+    printf("%d presses, bounce up to %.1f ms, glitches up to %.1f ms, getKeys() every %lu us\n",
+           options.trials, options.bounce_us / 1000.0, options.glitch_us / 1000.0, LOOP_US);
+    printf("latencies in ms; bounce and glitch count presses no press made\n");
+
+    // getKeys() scans once more than debounceTime ms have passed
+    const Setting settings[] = {
+        {"scan gate 10 ms", 10, 0},
+        {"scan gate 1 ms", 1, 0},
+        {"1 ms, 2 samples", 1, 2},
+        {"1 ms, 3 samples", 1, 3},
+        {"1 ms, 4 samples", 1, 4},
+    };
+    for (const Setting& setting : settings) {
+        print(setting, run(setting, trials));
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Checks KeypadEventQueue from the repo's Keypad library past the point
+// where a 16-bit count of pushed records would wrap, with a queue size
+// that doesn't divide 65536.
+//
+//   pio run -e event_queue && .pio/build/event_queue/program [--pushes N] [--size N]
+//
+// Every record carries in time how many records the queue took before it.
+// One reader reads after every push and must see them all in order.
+// Another only reads now and then, and must see them in order apart from
+// the ones counted in lost().  Records dropped under KEYPAD_DROP_NEWEST
+// aren't numbered, so they leave no gap.  Exits 1 on any mismatch.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include <KeypadEventQueue.h>
+
+namespace {
+
+struct Options {
+    unsigned long pushes = 200000;
+    int size = 5;
+};
+
+// Reads everything available, checking the push numbers follow on from
+// expected.  skipped is how many records the reader was told it missed.
+bool drain(KeypadEventReader& reader, unsigned long& expected, const unsigned long skipped,
+           unsigned long& got, const char* name) {
+    KeypadEventRecord record;
+    bool ok = true;
+    bool first = true;
+    while (reader.read(record)) {
+        const unsigned long want = first ? expected + skipped : expected;
+        if (record.time != want) {
+            printf("%s read push %lu, expected %lu\n", name, record.time, want);
+            ok = false;
+        }
+        expected = record.time + 1;
+        first = false;
+        got++;
+    }
+    return ok;
+}
+
+bool check(const Options& options, const KeypadOverflow policy) {
+    KeypadEventRecord records[255];
+    KeypadEventQueue queue(records, options.size, policy);
+    KeypadEventReader fast(queue);
+    KeypadEventReader slow(queue);
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> every(1, 3 * options.size);
+
+    unsigned long fastNext = 0, fastGot = 0;
+    unsigned long slowNext = 0, slowGot = 0;
+    unsigned long slowLost = 0;
+    unsigned long pushed = 0;
+    bool ok = true;
+    int untilSlow = every(rng);
+
+    for (unsigned long i = 0; i < options.pushes; i++) {
+        KeypadEventRecord record = {'1', 0, PRESSED, pushed};
+        if (queue.push(record)) {
+            pushed++;
+        }
+        ok = drain(fast, fastNext, 0, fastGot, "fast") && ok;
+
+        if (--untilSlow == 0) {
+            const unsigned long lostNow = slow.lost() - slowLost;
+            slowLost = slow.lost();
+            ok = drain(slow, slowNext, lostNow, slowGot, "slow") && ok;
+            untilSlow = every(rng);
+        }
+    }
+    ok = drain(slow, slowNext, slow.lost() - slowLost, slowGot, "slow") && ok;
+
+    const char* name = policy == KEYPAD_OVERWRITE_OLDEST ? "overwrite oldest" : "drop newest";
+    printf("%-16s size %d: pushed %lu, fast read %lu, slow read %lu lost %u, dropped %u\n",
+           name, options.size, pushed, fastGot, slowGot, slow.lost(), queue.dropped());
+
+    if (fastGot != pushed || fast.lost() != 0) {
+        printf("fast reader missed records\n");
+        ok = false;
+    }
+    if (slowGot + slow.lost() != pushed) {
+        printf("slow reader's reads and losses don't add up to the pushes\n");
+        ok = false;
+    }
+    if (pushed + queue.dropped() != options.pushes) {
+        printf("pushes and drops don't add up\n");
+        ok = false;
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--pushes") == 0 && i + 1 < argc) {
+            options.pushes = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            options.size = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--pushes N] [--size N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (options.size < 1 || options.size > 255) {
+        fprintf(stderr, "--size must be 1 to 255\n");
+        return 2;
+    }
+
+    const bool overwrite = check(options, KEYPAD_OVERWRITE_OLDEST);
+    const bool drop = check(options, KEYPAD_DROP_NEWEST);
+    printf("%s\n", overwrite && drop ? "ok" : "FAILED");
+    return overwrite && drop ? 0 : 1;
+}
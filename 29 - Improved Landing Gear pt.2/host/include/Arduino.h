@@ -0,0 +1,32 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Host stand-in for the parts of Arduino.h the game logic uses, so the
+// pure game code (LanderGame etc.) builds for the native host tools.
+// Hardware classes (LanderHardware, LanderDisplay) are never built here.
+
+#ifndef LANDER_HOST_ARDUINO_H
+#define LANDER_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// Flash storage is ordinary memory on the host
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(address) (*reinterpret_cast<const uint8_t*>(address))
+#define pgm_read_word(address) (*reinterpret_cast<const uint16_t*>(address))
+#define pgm_read_ptr(address) (*reinterpret_cast<const void* const*>(address))
+
+// Uno analog pin numbers, used by LanderConfig.h
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+
+#endif // LANDER_HOST_ARDUINO_H
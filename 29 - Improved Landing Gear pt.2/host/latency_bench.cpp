@@ -0,0 +1,496 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Input-to-photon latency on a simulated Uno (see host/sim/LanderSim.h).
+// Runs the real setup() and loop() from Main.cpp, with the real Keypad,
+// LanderGame, LanderDisplay and scheduler, and times:
+//
+//   lever -> OLED  a lever on A0-A2 flips on the preflight screen, until
+//                  the first I2C byte that changes that lever's text
+//   key -> OLED    RAISE_SPEED is pressed on the matrix in flight, until the
+//                  first I2C byte that changes the speed readout
+//   key -> 7seg    the same press, until the TM1637 digit that shows the
+//                  distance starting to fall
+//   restart -> OLED  all levers turn off on the ending screen, until the
+//                  first I2C byte of the preflight screen of the new game
+//
+// The levers only change the approach state, never the number on the
+// 7-segment display, so that path is timed from the thrust key instead.
+// Each stimulus lands at a random time, so the results spread over the
+// tick, render and refresh phases.  Which pixels a stimulus changes is
+// worked out by drawing the screen before and after with LanderDisplay.
+//
+// Then two keys are tapped with one press inside the other, RAISE_SPEED
+// around RAISE_GEAR, and both have to take effect.
+//
+// Last, the gear is lowered and raised on final approach for a whole
+// scheduler report period, and the device's own report of that period
+// (CPU load, frames per second) is printed.  Build latency_interpolate
+// to compare with INTERPOLATE on.
+//
+//   pio run -e latency && .pio/build/latency/program [--trials N] [--bounce MS] [--seed S] [--csv]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "LanderSim.h"
+#include "LanderConfig.h"
+#include "LanderDisplay.h"
+#include "LanderGame.h"
+#include "LanderHardware.h"
+
+// From Main.cpp and LanderHardware.cpp
+extern LanderGame game;
+extern unsigned long simulation_time;
+void setup();
+void loop();
+
+namespace {
+
+constexpr unsigned long TIMEOUT_US = 2000000;   // Give up on a stimulus after this
+constexpr unsigned long SETTLE_US = 500000;     // Let the screens catch up between trials
+constexpr unsigned long PHASE_SPREAD_US = 200000;  // Stimuli land anywhere in this window
+
+typedef byte Image[U8G2::PAGES][U8G2::WIDTH];
+
+// A stimulus being timed on one output
+struct Probe {
+    bool armed = false;
+    unsigned long started = 0;
+    Image mask = {};  // OLED bits the stimulus changes
+    std::vector<unsigned long>* samples = nullptr;
+
+    void arm(const unsigned long at, std::vector<unsigned long>& into) {
+        armed = true;
+        started = at;
+        samples = &into;
+    }
+
+    void hit(const unsigned long time) {
+        if (armed && static_cast<long>(time - started) >= 0) {
+            samples->push_back(time - started);
+            armed = false;
+        }
+    }
+};
+
+Probe oledProbe;
+Probe segmentProbe;
+
+// Everything the device prints on Serial
+std::string serialOutput;
+
+struct Options {
+    int trials = 200;
+    unsigned long bounce_us = 2000;
+    unsigned int seed = 1;
+    bool csv = false;
+};
+
+void runFor(const unsigned long us) {
+    const unsigned long end = LanderSim::now() + us;
+    while (static_cast<long>(LanderSim::now() - end) < 0) {
+        loop();
+    }
+}
+
+// Run until both probes fired or timed out.  False on a timeout.
+bool runUntilSeen(const unsigned long started) {
+    while (oledProbe.armed || segmentProbe.armed) {
+        if (LanderSim::now() - started > TIMEOUT_US) {
+            oledProbe.armed = false;
+            segmentProbe.armed = false;
+            return false;
+        }
+        loop();
+    }
+    return true;
+}
+
+template <typename Draw>
+void capture(Image& image, const Draw& draw) {
+    landerDisplay.capture(image, draw);
+}
+
+void makeMask(Image& mask, const Image& before, const Image& after) {
+    for (byte page = 0; page < U8G2::PAGES; page++) {
+        for (byte column = 0; column < U8G2::WIDTH; column++) {
+            mask[page][column] = before[page][column] ^ after[page][column];
+        }
+    }
+}
+
+bool findKey(const LANDER_CONTROLS key, byte& row, byte& column) {
+    for (row = 0; row < CONTROL_ROW_COUNT; row++) {
+        for (column = 0; column < CONTROL_COLUMN_COUNT; column++) {
+            if (pgm_read_byte(&control_buttons[row][column]) == key) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+InputFrame leverFrame(const bool thrust, const bool systems, const bool confirm) {
+    InputFrame frame = {};
+    frame.thrust_lever = thrust;
+    frame.systems_lever = systems;
+    frame.confirm_lever = confirm;
+    return frame;
+}
+
+// Flip the systems or confirm lever on the preflight screen, never both on
+// with thrust so the game stays in preflight
+int leverTrials(const Options& options, std::mt19937& rng, std::vector<unsigned long>& samples) {
+    int timeouts = 0;
+    bool levers[2] = {false, false};
+    const byte pins[2] = {SYSTEMS_LEVER, CONFIRM_LEVER};
+
+    for (int trial = 0; trial < options.trials; trial++) {
+        const int which = static_cast<int>(rng() % 2);
+
+        Image before;
+        Image after;
+        capture(before, [&] {
+            LanderDisplay::displayPreFlight(APPROACH_PREFLIGHT, leverFrame(false, levers[0], levers[1]));
+        });
+        levers[which] = !levers[which];
+        capture(after, [&] {
+            LanderDisplay::displayPreFlight(APPROACH_PREFLIGHT, leverFrame(false, levers[0], levers[1]));
+        });
+        makeMask(oledProbe.mask, before, after);
+
+        const unsigned long at = LanderSim::now() + rng() % PHASE_SPREAD_US;
+        LanderSim::setLever(pins[which], levers[which], at);
+        oledProbe.arm(at, samples);
+
+        runFor(at - LanderSim::now());
+        timeouts += !runUntilSeen(at);
+        runFor(SETTLE_US);
+    }
+
+    return timeouts;
+}
+
+// Press RAISE_SPEED from a standstill in flight, hold it for a while, then
+// put the game back as it was
+int keyTrials(const Options& options, std::mt19937& rng,
+              std::vector<unsigned long>& oledSamples, std::vector<unsigned long>& segmentSamples) {
+    byte row;
+    byte column;
+    if (!findKey(RAISE_SPEED, row, column)) {
+        fprintf(stderr, "RAISE_SPEED is not on the keypad\n");
+        exit(1);
+    }
+
+    const LanderSnapshot standstill = game.save();
+    int timeouts = 0;
+
+    for (int trial = 0; trial < options.trials; trial++) {
+        game.restore(standstill, simulation_time);
+        runFor(SETTLE_US);
+
+        Image before;
+        Image after;
+        const int distance = game.getLanderDistance();
+        const int x = game.getMotherShipXOffset();
+        const int y = game.getMotherShipYOffset();
+        capture(before, [&] { LanderDisplay::displayInFlight(distance, 0, x, y); });
+        capture(after, [&] { LanderDisplay::displayInFlight(distance, THRUST_STEP.floor(), x, y); });
+        makeMask(oledProbe.mask, before, after);
+
+        const unsigned long at = LanderSim::now() + rng() % PHASE_SPREAD_US;
+        const unsigned long hold = 50000 + rng() % 150000;
+        LanderSim::setKey(row, column, true, at, options.bounce_us);
+        oledProbe.arm(at, oledSamples);
+        segmentProbe.arm(at, segmentSamples);
+
+        runFor(at - LanderSim::now());
+        LanderSim::setKey(row, column, false, at + hold, options.bounce_us);
+        timeouts += !runUntilSeen(at);
+        runFor(hold);
+    }
+
+    return timeouts;
+}
+
+// A snapshot of the game moved on to another approach state
+LanderSnapshot inState(LanderSnapshot snapshot, const APPROACH_STATE state) {
+    snapshot.packed = (snapshot.packed & ~(0x07UL << LanderSnapshot::APPROACH_SHIFT)) |
+                      static_cast<uint32_t>(state) << LanderSnapshot::APPROACH_SHIFT;
+    return snapshot;
+}
+
+void setLevers(const bool on, const unsigned long at) {
+    LanderSim::setLever(THRUST_LEVER, on, at);
+    LanderSim::setLever(SYSTEMS_LEVER, on, at);
+    LanderSim::setLever(CONFIRM_LEVER, on, at);
+}
+
+// Touch down, let the ending splash come up, then turn every lever off to
+// start a new game.  The levers go back on afterwards to take off for the
+// next trial.
+int restartTrials(const Options& options, std::mt19937& rng, std::vector<unsigned long>& samples) {
+    int timeouts = 0;
+
+    for (int trial = 0; trial < options.trials; trial++) {
+        // One tick from touchdown
+        LanderSnapshot landing = inState(game.save(), APPROACH_FINAL);
+        landing.distance_raw = LanderDistance::fromInt(1).toRaw();
+        landing.speed_raw = LanderSpeed::fromInt(1).toRaw();
+        game.restore(landing, simulation_time);
+        runFor(SETTLE_US);
+        if (!game.isGameOver() || !game.isShowingEndingSplash()) {
+            fprintf(stderr, "game did not land on the ending splash\n");
+            exit(1);
+        }
+
+        Image before;
+        Image after;
+        for (byte page = 0; page < U8G2::PAGES; page++) {
+            for (byte column = 0; column < U8G2::WIDTH; column++) {
+                before[page][column] = landerDisplay.panelByte(page, column);
+            }
+        }
+        capture(after, [] { LanderDisplay::displayPreFlight(APPROACH_PREFLIGHT, leverFrame(false, false, false)); });
+        makeMask(oledProbe.mask, before, after);
+
+        const unsigned long at = LanderSim::now() + rng() % PHASE_SPREAD_US;
+        setLevers(false, at);
+        oledProbe.arm(at, samples);
+
+        runFor(at - LanderSim::now());
+        timeouts += !runUntilSeen(at);
+        setLevers(true, LanderSim::now());
+        runFor(SETTLE_US);
+        if (game.getApproachState() != APPROACH_IN_FLIGHT) {
+            fprintf(stderr, "game did not restart and take off\n");
+            exit(1);
+        }
+    }
+
+    return timeouts;
+}
+
+// On final approach at a standstill with the gear down, press RAISE_SPEED,
+// then press and release RAISE_GEAR, then release RAISE_SPEED.  Returns the
+// trials where either tap was lost.
+int overlapTrials(const Options& options, std::mt19937& rng) {
+    byte speedRow;
+    byte speedColumn;
+    byte gearRow;
+    byte gearColumn;
+    if (!findKey(RAISE_SPEED, speedRow, speedColumn) || !findKey(RAISE_GEAR, gearRow, gearColumn)) {
+        fprintf(stderr, "RAISE_SPEED or RAISE_GEAR is not on the keypad\n");
+        exit(1);
+    }
+
+    LanderSnapshot gearDown = inState(game.save(), APPROACH_FINAL);
+    gearDown.distance_raw = LanderDistance::fromInt(INITIAL_DISTANCE / 20).toRaw();
+    gearDown.speed_raw = 0;
+    gearDown.packed = (gearDown.packed & ~(0x0FUL << LanderSnapshot::GEAR_INDEX_SHIFT)) |
+                      3UL << LanderSnapshot::GEAR_INDEX_SHIFT |  // Last gear bitmap, gear down
+                      static_cast<uint32_t>(GEAR_IDLE + 1) << LanderSnapshot::GEAR_STATE_SHIFT;
+
+    int lost = 0;
+
+    for (int trial = 0; trial < options.trials; trial++) {
+        game.restore(gearDown, simulation_time);
+        runFor(SETTLE_US);
+
+        // Each gap outlasts the 10 ms scan debounce, and the four edges take
+        // 25-55 ms, so they often all land in one tick
+        const unsigned long at = LanderSim::now() + rng() % PHASE_SPREAD_US;
+        const unsigned long before = 5000 + rng() % 10000;
+        const unsigned long hold = 15000 + rng() % 10000;
+        const unsigned long after = 5000 + rng() % 10000;
+        LanderSim::tapKey(speedRow, speedColumn, at, before + hold + after, options.bounce_us);
+        LanderSim::tapKey(gearRow, gearColumn, at + before, hold, options.bounce_us);
+
+        runFor(at - LanderSim::now() + before + hold + after + SETTLE_US);
+        const bool sped = game.getLanderSpeedFixed() > LanderSpeed();
+        const bool raised = game.getCurrentGearBitmapIndex() < 3;
+        lost += !sped || !raised;
+    }
+
+    return lost;
+}
+
+// Lower the gear on final approach and raise it again, over and over, until
+// the device has reported on a whole period of it.  Returns that report.
+std::string gearReport() {
+    byte lowerRow;
+    byte lowerColumn;
+    byte raiseRow;
+    byte raiseColumn;
+    if (!findKey(LOWER_GEAR, lowerRow, lowerColumn) || !findKey(RAISE_GEAR, raiseRow, raiseColumn)) {
+        fprintf(stderr, "LOWER_GEAR or RAISE_GEAR is not on the keypad\n");
+        exit(1);
+    }
+
+    // Standing still at half the final approach distance, gear up
+    LanderSnapshot final = inState(game.save(), APPROACH_FINAL);
+    final.distance_raw = LanderDistance::fromInt(INITIAL_DISTANCE / 20).toRaw();
+    final.speed_raw = 0;
+    game.restore(final, simulation_time);
+
+    constexpr unsigned long TAP_US = 150000;
+    constexpr unsigned long CYCLE_US = 1000000;  // Long enough for the gear to go all the way
+    serialOutput.clear();
+    bool lower = true;
+
+    while (true) {
+        const unsigned long at = LanderSim::now();
+        const byte row = lower ? lowerRow : raiseRow;
+        const byte column = lower ? lowerColumn : raiseColumn;
+        LanderSim::setKey(row, column, true, at, 0);
+        LanderSim::setKey(row, column, false, at + TAP_US, 0);
+        lower = !lower;
+
+        // The first report covers time before the gear started moving.  A
+        // report is printed within one loop(), so the second is whole.
+        while (LanderSim::now() - at < CYCLE_US) {
+            loop();
+            const size_t first = serialOutput.find("sched ");
+            const size_t second = first == std::string::npos ? first : serialOutput.find("sched ", first + 1);
+            if (second != std::string::npos) {
+                return serialOutput.substr(second);
+            }
+        }
+    }
+}
+
+unsigned long percentile(const std::vector<unsigned long>& sorted, const double share) {
+    const size_t index = static_cast<size_t>(share * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+void printDistribution(const char* name, std::vector<unsigned long> samples, const int timeouts) {
+    printf("%-15s", name);
+    if (samples.empty()) {
+        printf(" no samples, %d timed out\n", timeouts);
+        return;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    printf(" n %4zu  min %6.1f  p50 %6.1f  p90 %6.1f  p99 %6.1f  max %6.1f ms",
+           samples.size(), samples.front() / 1000.0,
+           percentile(samples, 0.50) / 1000.0, percentile(samples, 0.90) / 1000.0,
+           percentile(samples, 0.99) / 1000.0, samples.back() / 1000.0);
+    if (timeouts > 0) {
+        printf("  (%d timed out)", timeouts);
+    }
+    printf("\n");
+
+    // 10 ms buckets, scaled to 40 columns
+    constexpr unsigned long BUCKET_US = 10000;
+    std::vector<size_t> buckets(samples.back() / BUCKET_US + 1);
+    for (const unsigned long sample : samples) {
+        buckets[sample / BUCKET_US]++;
+    }
+    const size_t tallest = *std::max_element(buckets.begin(), buckets.end());
+    for (size_t bucket = samples.front() / BUCKET_US; bucket < buckets.size(); bucket++) {
+        printf("  %4zu-%4zu ms %5zu %s\n", bucket * 10, bucket * 10 + 10, buckets[bucket],
+               std::string(buckets[bucket] * 40 / tallest, '#').c_str());
+    }
+}
+
+void printCsv(const char* name, const std::vector<unsigned long>& samples) {
+    for (const unsigned long sample : samples) {
+        printf("%s,%lu\n", name, sample);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--trials") == 0 && i + 1 < argc) {
+            options.trials = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--bounce") == 0 && i + 1 < argc) {
+            options.bounce_us = static_cast<unsigned long>(atof(argv[++i]) * 1000);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            options.csv = true;
+        } else {
+            fprintf(stderr, "usage: %s [--trials N] [--bounce MS] [--seed S] [--csv]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    srand(options.seed);
+    std::mt19937 rng(options.seed);
+
+    landerDisplay.setByteObserver([](const unsigned long time, byte page, byte column, const byte previous, const byte value) {
+        if ((previous ^ value) & oledProbe.mask[page][column]) {
+            oledProbe.hit(time);
+        }
+    });
+    distanceDisplay.setDigitObserver([](const unsigned long time, byte, const byte previous, const byte segments) {
+        if (previous != segments) {
+            segmentProbe.hit(time);
+        }
+    });
+
+    // The sampler interrupt LanderHardware::init() starts on the Uno
+    LanderSim::setTimerInterrupt(LanderHardware::sampleKeypad);
+    Serial.setWriteObserver([](const uint8_t value) { serialOutput += static_cast<char>(value); });
+
+    // All levers off, so the game goes through init to preflight
+    setup();
+    runFor(SETTLE_US);
+    if (game.getApproachState() != APPROACH_PREFLIGHT) {
+        fprintf(stderr, "game did not reach preflight\n");
+        return 1;
+    }
+
+    std::vector<unsigned long> leverOled;
+    std::vector<unsigned long> keyOled;
+    std::vector<unsigned long> keySegments;
+    const int leverTimeouts = leverTrials(options, rng, leverOled);
+
+    // Every lever on for the flight, then settle before the key trials
+    setLevers(true, LanderSim::now());
+    runFor(SETTLE_US);
+    if (game.getApproachState() != APPROACH_IN_FLIGHT) {
+        fprintf(stderr, "game did not take off\n");
+        return 1;
+    }
+    const int keyTimeouts = keyTrials(options, rng, keyOled, keySegments);
+    std::vector<unsigned long> restartOled;
+    const int restartTimeouts = restartTrials(options, rng, restartOled);
+    const int overlapLost = overlapTrials(options, rng);
+    const std::string report = SCHEDULER_REPORT_MS > 0 ? gearReport() : std::string();
+
+    if (options.csv) {
+        printf("path,latency_us\n");
+        printCsv("lever_oled", leverOled);
+        printCsv("key_oled", keyOled);
+        printCsv("key_7seg", keySegments);
+        printCsv("restart_oled", restartOled);
+        return 0;
+    }
+
+    printf("tick %lu ms, oled every %lu ms in %u passes, 7seg every %lu ms, bounce %.1f ms, %.1f s simulated\n\n",
+           SIMULATION_TICK_MS, RENDER_PERIOD_MS, LanderScreen::PASSES, DISTANCE_PERIOD_MS,
+           options.bounce_us / 1000.0, LanderSim::now() / 1e6);
+    printDistribution("lever -> OLED", leverOled, leverTimeouts);
+    printDistribution("key -> OLED", keyOled, keyTimeouts);
+    printDistribution("key -> 7seg", keySegments, keyTimeouts);
+    printDistribution("restart -> OLED", restartOled, restartTimeouts);
+    printf("overlapping taps n %4d  lost %d\n", options.trials, overlapLost);
+    if (!report.empty()) {
+        printf("\ngear lowering and raising on final approach, %s:\n%s",
+               INTERPOLATE ? "interpolated" : "not interpolated", report.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,337 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Monte Carlo outcome analyzer.  Flies millions of complete approaches
+// through the real LanderGame code with a scripted pilot, spread over every
+// core, and tallies how each one ends and how long it took.  Used to tune
+// DRIFT_CONTROL (--drift-control) without flying each change.
+// INITIAL_DISTANCE and MAX_DRIFT are compiled into LanderGame, so trying
+// other values means changing LanderConfig.h and rebuilding.
+//
+//   pio run -e montecarlo && .pio/build/montecarlo/program --runs 10000000
+//
+// Every chunk of runs gets its own RNG stream seeded from (seed, chunk), so
+// the results for a seed are identical whatever the thread count.
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "LanderConfig.h"
+#include "LanderGame.h"
+#include "LanderRandom.h"
+
+namespace {
+
+constexpr int OUTCOME_COUNT = 5;         // ENDING_OUTCOME values plus a timeout
+constexpr int OUTCOME_TIMEOUT = 4;
+constexpr unsigned long MAX_TICKS = 4096;  // Give up on a pilot that never lands
+constexpr uint64_t CHUNK_RUNS = 4096;
+
+const char* const OUTCOME_NAMES[OUTCOME_COUNT] = {
+    "success", "no gear", "too fast", "missed", "timeout"
+};
+
+// Scripted pilot.  Brakes when the remaining distance gets close to what it
+// needs to slow to landing speed, keeps the gear and the ship lined up, and
+// otherwise accelerates to cruise speed.
+struct Policy {
+    int cruise_speed = 12;
+    int landing_speed = 2;
+    int deadzone = 1;           // Offset tolerated before steering
+    double brake_margin = 1.2;  // Multiplier on the stopping distance
+    double reaction = 1.0;      // Chance per tick that the pilot acts at all
+    int drift_control = DRIFT_CONTROL;
+};
+
+struct Config {
+    Policy policy;
+    uint64_t runs = 1000000;
+    uint32_t seed = 1;
+    unsigned threads = std::thread::hardware_concurrency();
+    bool scaling = false;
+};
+
+bool chance(LanderRandom& random, const double probability) {
+    return random.next() < probability * 4294967296.0;
+}
+
+// Distance flown while slowing one step per tick from speed down to landing_speed
+int stoppingDistance(const int speed, const int landing_speed) {
+    int distance = 0;
+    for (int s = landing_speed; s <= speed; s++) {
+        distance += s;
+    }
+    return distance;
+}
+
+LANDER_CONTROLS steerToCenter(const int x, const int y, const int deadzone) {
+    // STEER_LEFT raises the x offset and STEER_UP raises y
+    const int dx = x > deadzone ? -1 : (x < -deadzone ? 1 : 0);
+    const int dy = y > deadzone ? -1 : (y < -deadzone ? 1 : 0);
+
+    static const LANDER_CONTROLS STEERING[3][3] = {
+        // dy = -1          dy = 0       dy = 1
+        { STEER_DOWN_RIGHT, STEER_RIGHT, STEER_UP_RIGHT },  // dx = -1
+        { STEER_DOWN,       UNUSED,      STEER_UP },        // dx = 0
+        { STEER_DOWN_LEFT,  STEER_LEFT,  STEER_UP_LEFT },   // dx = 1
+    };
+    return STEERING[dx + 1][dy + 1];
+}
+
+LANDER_CONTROLS choose(const Policy& policy, const LanderGame& game, LanderRandom& rng) {
+    if (!chance(rng, policy.reaction)) {
+        return UNUSED;
+    }
+
+    const int speed = game.getLanderSpeed();
+    const int distance = game.getLanderDistance();
+    const double braking = policy.brake_margin * stoppingDistance(speed, policy.landing_speed);
+
+    if (speed > policy.landing_speed && distance <= braking) {
+        return LOWER_SPEED;
+    }
+
+    if (game.getApproachState() == APPROACH_FINAL &&
+        game.getCurrentGearBitmapIndex() == 0 && game.getGearState() == GEAR_IDLE) {
+        return LOWER_GEAR;
+    }
+
+    const LANDER_CONTROLS steer = steerToCenter(
+        game.getMotherShipXOffset(), game.getMotherShipYOffset(), policy.deadzone);
+    if (steer != UNUSED) {
+        return steer;
+    }
+
+    const double nextBraking = policy.brake_margin * stoppingDistance(speed + 1, policy.landing_speed);
+    if (speed < policy.cruise_speed && distance > nextBraking + speed + 1) {
+        return RAISE_SPEED;
+    }
+
+    return UNUSED;
+}
+
+// Per-thread tallies, merged into the shared results once per chunk
+struct Tally {
+    uint64_t outcomes[OUTCOME_COUNT] = {};
+    uint64_t elapsed[OUTCOME_COUNT][MAX_TICKS] = {};
+};
+
+// Shared results.  Workers only ever add to them, so plain atomic adds are
+// enough and no lock is taken.
+struct Results {
+    std::atomic<uint64_t> nextChunk{0};
+    std::atomic<uint64_t> outcomes[OUTCOME_COUNT] = {};
+    std::atomic<uint64_t> elapsed[OUTCOME_COUNT][MAX_TICKS] = {};
+};
+
+void flyApproach(const Policy& policy, LanderRandom& rng, Tally& tally) {
+    LanderGame game;
+    InputFrame frame = {};
+    unsigned long now = 0;
+    unsigned long tick = 0;
+
+    while (!game.isGameOver() && tick < MAX_TICKS) {
+        // Levers off to leave INIT, then on to launch
+        const bool levers = game.getApproachState() != APPROACH_INIT;
+        frame.thrust_lever = levers;
+        frame.systems_lever = levers;
+        frame.confirm_lever = levers;
+
+        const APPROACH_STATE state = game.getApproachState();
+        frame.key = (state == APPROACH_IN_FLIGHT || state == APPROACH_FINAL) ? choose(policy, game, rng) : UNUSED;
+        rng.nextDrift(policy.drift_control, frame.drift_x, frame.drift_y);
+
+        now += SIMULATION_TICK_MS;
+        game.update(frame, now);
+        tick++;
+    }
+
+    const int outcome = game.isGameOver() ? game.getOutcome() : OUTCOME_TIMEOUT;
+    unsigned long elapsedTicks = game.getElapsedTime() / SIMULATION_TICK_MS;
+    if (elapsedTicks >= MAX_TICKS) {
+        elapsedTicks = MAX_TICKS - 1;
+    }
+
+    tally.outcomes[outcome]++;
+    tally.elapsed[outcome][elapsedTicks]++;
+}
+
+void worker(const Config& config, Results& results) {
+    const uint64_t chunks = (config.runs + CHUNK_RUNS - 1) / CHUNK_RUNS;
+    auto* tally = new Tally;
+
+    for (;;) {
+        const uint64_t chunk = results.nextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= chunks) {
+            break;
+        }
+
+        LanderRandom rng(config.seed, static_cast<uint32_t>(chunk));
+        const uint64_t end = std::min(config.runs, (chunk + 1) * CHUNK_RUNS);
+
+        for (uint64_t run = chunk * CHUNK_RUNS; run < end; run++) {
+            flyApproach(config.policy, rng, *tally);
+        }
+
+        // Flush the non-zero buckets and start the next chunk clean
+        for (int o = 0; o < OUTCOME_COUNT; o++) {
+            if (!tally->outcomes[o]) {
+                continue;
+            }
+            results.outcomes[o].fetch_add(tally->outcomes[o], std::memory_order_relaxed);
+            for (unsigned long t = 0; t < MAX_TICKS; t++) {
+                if (tally->elapsed[o][t]) {
+                    results.elapsed[o][t].fetch_add(tally->elapsed[o][t], std::memory_order_relaxed);
+                }
+            }
+        }
+        *tally = Tally();
+    }
+
+    delete tally;
+}
+
+double runPool(const Config& config, Results& results, const unsigned threads) {
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; i++) {
+        pool.emplace_back(worker, std::cref(config), std::ref(results));
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Elapsed time (seconds) below which the given fraction of runs finished
+double percentile(const std::atomic<uint64_t>* histogram, const uint64_t count, const double fraction) {
+    const uint64_t target = static_cast<uint64_t>(std::ceil(fraction * count));
+    uint64_t seen = 0;
+
+    for (unsigned long t = 0; t < MAX_TICKS; t++) {
+        seen += histogram[t].load(std::memory_order_relaxed);
+        if (seen >= target && seen > 0) {
+            return t * SIMULATION_TICK_MS / 1000.0;
+        }
+    }
+    return NAN;
+}
+
+void printResults(const Config& config, const Results& results, const double seconds) {
+    const Policy& policy = config.policy;
+
+    printf("INITIAL_DISTANCE %d  DRIFT_CONTROL %d  MAX_DRIFT %d\n",
+           INITIAL_DISTANCE, policy.drift_control, MAX_DRIFT);
+    printf("pilot: cruise %d landing %d deadzone %d brake margin %.2f reaction %.2f\n\n",
+           policy.cruise_speed, policy.landing_speed, policy.deadzone,
+           policy.brake_margin, policy.reaction);
+
+    printf("%-9s %11s %7s %8s %8s %8s %8s\n", "outcome", "runs", "share", "p5 s", "p50 s", "p95 s", "p99 s");
+    for (int o = 0; o < OUTCOME_COUNT; o++) {
+        const uint64_t count = results.outcomes[o].load();
+        printf("%-9s %11llu %6.2f%%", OUTCOME_NAMES[o],
+               static_cast<unsigned long long>(count), 100.0 * count / config.runs);
+        if (count) {
+            printf(" %8.1f %8.1f %8.1f %8.1f",
+                   percentile(results.elapsed[o], count, 0.05),
+                   percentile(results.elapsed[o], count, 0.50),
+                   percentile(results.elapsed[o], count, 0.95),
+                   percentile(results.elapsed[o], count, 0.99));
+        }
+        printf("\n");
+    }
+
+    printf("\n%llu runs on %u threads in %.2f s, %.0f runs/s\n",
+           static_cast<unsigned long long>(config.runs), config.threads,
+           seconds, config.runs / seconds);
+}
+
+bool parseArguments(const int argc, char** argv, Config& config) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (strcmp(arg, "--scaling") == 0) {
+            config.scaling = true;
+            continue;
+        }
+        if (!value) {
+            return false;
+        }
+        i++;
+
+        if (strcmp(arg, "--runs") == 0) {
+            config.runs = strtoull(value, nullptr, 10);
+        } else if (strcmp(arg, "--seed") == 0) {
+            config.seed = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        } else if (strcmp(arg, "--threads") == 0) {
+            config.threads = static_cast<unsigned>(strtoul(value, nullptr, 10));
+        } else if (strcmp(arg, "--cruise") == 0) {
+            config.policy.cruise_speed = atoi(value);
+        } else if (strcmp(arg, "--landing") == 0) {
+            config.policy.landing_speed = atoi(value);
+        } else if (strcmp(arg, "--deadzone") == 0) {
+            config.policy.deadzone = atoi(value);
+        } else if (strcmp(arg, "--brake-margin") == 0) {
+            config.policy.brake_margin = atof(value);
+        } else if (strcmp(arg, "--reaction") == 0) {
+            config.policy.reaction = atof(value);
+        } else if (strcmp(arg, "--drift-control") == 0) {
+            config.policy.drift_control = atoi(value);
+        } else {
+            return false;
+        }
+    }
+
+    return config.runs > 0 && config.threads > 0 && config.policy.drift_control > 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Config config;
+    if (config.threads == 0) {
+        config.threads = 1;
+    }
+
+    if (!parseArguments(argc, argv, config)) {
+        fprintf(stderr,
+                "usage: %s [--runs N] [--seed N] [--threads N] [--scaling]\n"
+                "          [--cruise N] [--landing N] [--deadzone N] [--brake-margin X]\n"
+                "          [--reaction P] [--drift-control N]\n", argv[0]);
+        return 2;
+    }
+
+    // Throughput at 1, 2, 4 ... threads to check the pool scales with cores
+    if (config.scaling) {
+        double single = 0;
+        for (unsigned threads = 1; threads <= config.threads; threads *= 2) {
+            auto* results = new Results;
+            const double seconds = runPool(config, *results, threads);
+            const double rate = config.runs / seconds;
+            if (threads == 1) {
+                single = rate;
+            }
+            printf("%3u threads  %12.0f runs/s  speedup %5.2f  efficiency %5.1f%%\n",
+                   threads, rate, rate / single, 100.0 * rate / single / threads);
+            delete results;
+        }
+        return 0;
+    }
+
+    auto* results = new Results;
+    const double seconds = runPool(config, *results, config.threads);
+    printResults(config, *results, seconds);
+    delete results;
+    return 0;
+}
@@ -0,0 +1,179 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Cost of the fixed-point speed and distance model against the original
+// whole-unit int model, per game update.
+//
+//   pio run -e physics && .pio/build/physics/program [--updates N]
+//
+// Each model flies the same key stream.  "integer" is the old
+// processSpeedState()/updateDistance() pair on plain ints, "fixed" is the
+// LanderFixed version with the LanderConfig.h constants, "fixed+drag" adds
+// drag and a 50 ms tick, and "LanderGame" is a whole update() through the
+// real game.  Cycles come from the TSC on x86 and are host cycles, not AVR
+// ones; they show the relative cost.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define LANDER_HAVE_TSC 1
+#endif
+
+#include "LanderConfig.h"
+#include "LanderGame.h"
+
+namespace {
+
+constexpr size_t KEY_COUNT = 4096;
+
+uint64_t cycles() {
+#ifdef LANDER_HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// Original model, as LanderGame was before LanderFixed
+struct IntegerModel {
+    int speed = 0;
+    int distance = INITIAL_DISTANCE;
+
+    void update(const LANDER_CONTROLS key) {
+        if (key == RAISE_SPEED) {
+            speed++;
+        } else if (key == LOWER_SPEED && speed > 0) {
+            speed--;
+        }
+        distance -= speed;
+    }
+
+    bool done() const { return distance <= 0; }
+};
+
+// Same steps as LanderGame::processSpeedState() and updateDistance()
+struct FixedModel {
+    LanderSpeed speed;
+    LanderDistance distance = LanderDistance::fromInt(INITIAL_DISTANCE);
+    LanderSpeed thrust;
+    LanderRatio tickScale;
+    LanderRatio tickDrag;
+
+    FixedModel(const LanderSpeed thrust, const LanderRatio drag, const LanderRatio tickScale) :
+        thrust(thrust), tickScale(tickScale), tickDrag(drag * tickScale) {}
+
+    void update(const LANDER_CONTROLS key) {
+        if (key == RAISE_SPEED) {
+            speed += thrust;
+        } else if (key == LOWER_SPEED) {
+            speed = speed > thrust ? speed - thrust : LanderSpeed();
+        }
+        distance -= (speed * tickScale).to<LanderDistance>();
+        speed -= speed * tickDrag;
+    }
+
+    bool done() const { return distance <= LanderDistance(); }
+};
+
+struct GameModel {
+    LanderGame game;
+    InputFrame frame = {};
+    unsigned long now = 0;
+
+    GameModel() {
+        game.update(frame, 0);
+        frame.thrust_lever = frame.systems_lever = frame.confirm_lever = true;
+        game.update(frame, 0);
+    }
+
+    void update(const LANDER_CONTROLS key) {
+        frame.key = key;
+        game.update(frame, now += SIMULATION_TICK_MS);
+    }
+
+    bool done() const { return game.isGameOver(); }
+};
+
+// Keys that climb to cruise, hold and brake, so speeds stay realistic
+std::vector<LANDER_CONTROLS> makeKeys(const uint32_t seed) {
+    std::mt19937 random(seed);
+    std::vector<LANDER_CONTROLS> keys(KEY_COUNT);
+    for (size_t i = 0; i < KEY_COUNT; i++) {
+        const uint32_t roll = random() % 100;
+        const bool braking = (i / 64) % 2 == 1;
+        if (roll < 20) {
+            keys[i] = braking ? LOWER_SPEED : RAISE_SPEED;
+        } else if (roll < 25) {
+            keys[i] = braking ? RAISE_SPEED : LOWER_SPEED;
+        } else {
+            keys[i] = static_cast<LANDER_CONTROLS>(STEER_UP + random() % 8);
+        }
+    }
+    return keys;
+}
+
+template <typename Model, typename Make>
+void run(const char* name, const Make& make, const std::vector<LANDER_CONTROLS>& keys, const uint64_t updates) {
+    Model model = make();
+    long landings = 0;
+    size_t key = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t startCycles = cycles();
+
+    for (uint64_t i = 0; i < updates; i++) {
+        model.update(keys[key]);
+        key = (key + 1) % KEY_COUNT;
+        if (model.done()) {
+            model = make();
+            landings++;
+        }
+    }
+
+    const uint64_t spentCycles = cycles() - startCycles;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%-12s %7.2f ns/update", name, seconds * 1e9 / updates);
+#ifdef LANDER_HAVE_TSC
+    printf("  %7.2f cycles/update", static_cast<double>(spentCycles) / updates);
+#else
+    (void) spentCycles;
+#endif
+    printf("  (%ld landings)\n", landings);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    uint64_t updates = 100000000;
+    uint32_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--updates") == 0 && i + 1 < argc) {
+            updates = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else {
+            fprintf(stderr, "usage: %s [--updates N] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const std::vector<LANDER_CONTROLS> keys = makeKeys(seed);
+
+    run<IntegerModel>("integer", [] { return IntegerModel(); }, keys, updates);
+    run<FixedModel>("fixed", [] { return FixedModel(THRUST_STEP, DRAG, TICK_SCALE); }, keys, updates);
+    run<FixedModel>("fixed+drag", [] {
+        return FixedModel(LanderSpeed::fromRatio(1, 2), LanderRatio::fromRatio(1, 50), LanderRatio::fromRatio(50, PHYSICS_REFERENCE_MS));
+    }, keys, updates);
+    run<GameModel>("LanderGame", [] { return GameModel(); }, keys, updates / 10);
+    return 0;
+}
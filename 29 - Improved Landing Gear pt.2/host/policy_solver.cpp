@@ -0,0 +1,786 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Optimal landing policy solver.  Enumerates every in-flight LanderGame
+// state and finds, by dynamic programming, the key to press in each one so
+// the expected approach time is as short as possible while still landing
+// with ENDING_SUCCESS.  The mother ship drift from LanderRandom::drift() is
+// treated as a random transition, so the policy is optimal on average.
+//
+//   pio run -e solver && .pio/build/solver/program [--out include/LanderAutopilotPolicy.h]
+//
+// Every tick costs 1 and a landing that isn't a success costs --penalty, so
+// with the default penalty the solver gives up at most 1e-4 of success
+// chance per tick saved.  The policy is then checked by flying the real
+// LanderGame with it, squeezed into the LanderAutopilot table and flown again.
+//
+// State space.  Distance only ever goes down, so the states are solved one
+// distance at a time from the mother ship outwards: a state at distance d
+// only leads to distances below d, apart from speed 0 where it stays at d.
+// The speed 0 states are solved by value iteration, then every other speed
+// in a single pass.  Only the last max-speed + 1 distance layers of values
+// are ever needed, so they live in a small ring instead of a full table.
+// Drift is symmetric, so the offsets are folded to their absolute value.
+// The gear and approach state fold into one gear phase, and phases other
+// than gear up only exist inside the final approach distance.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "LanderAutopilot.h"
+#include "LanderConfig.h"
+#include "LanderGame.h"
+#include "LanderRandom.h"
+
+namespace {
+
+static_assert(
+    THRUST_STEP == LanderSpeed::fromInt(1) && DRAG == LanderRatio() && TICK_SCALE == LanderRatio::fromInt(1),
+    "The solver's states are whole speed and distance units"
+);
+
+constexpr int FINAL_DISTANCE = INITIAL_DISTANCE / 10;
+constexpr int OFFSETS = MAX_DRIFT + 1;  // Folded offsets 0..MAX_DRIFT
+constexpr int OFFSET_STATES = OFFSETS * OFFSETS;
+constexpr int PHASES = LanderAutopilot::GEAR_PHASE_COUNT;
+constexpr int ACTIONS = LanderAutopilot::ACTION_COUNT;
+constexpr int BAY_HALF_WIDTH = (MAX_MOTHER_SHIP_WIDTH + 1) / 2;
+constexpr int BAY_HALF_HEIGHT = (MAX_MOTHER_SHIP_HEIGHT + 1) / 2;
+constexpr int MAX_SAFE_SPEED = MAX_LANDING_SPEED.floor();  // Speeds are whole units here
+constexpr int MAX_SWEEPS = 1000;
+constexpr float SWEEP_TOLERANCE = 1e-3f;
+constexpr unsigned long MAX_TICKS = 4096;
+constexpr uint64_t CHUNK_RUNS = 1024;
+constexpr int OUTCOME_COUNT = 5;  // ENDING_OUTCOME values plus a timeout
+constexpr int OUTCOME_TIMEOUT = 4;
+
+const char* const OUTCOME_NAMES[OUTCOME_COUNT] = {
+    "success", "no gear", "too fast", "missed", "timeout"
+};
+
+struct Config {
+    int max_speed = 40;
+    float penalty = 10000.0f;
+    uint64_t runs = 200000;
+    int rounds = 8;
+    uint32_t seed = 1;
+    unsigned threads = std::thread::hardware_concurrency();
+    const char* out = nullptr;
+};
+
+// Persistent workers, so the many short per-layer jobs don't pay for
+// starting threads every time.  The calling thread works too.
+class WorkerPool {
+public:
+    explicit WorkerPool(const unsigned threads) {
+        for (unsigned i = 1; i < threads; i++) {
+            workers.emplace_back(&WorkerPool::worker, this);
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : workers) {
+            thread.join();
+        }
+    }
+
+    // Calls work(i) for every i below count and returns once all are done
+    void run(const size_t count, const std::function<void(size_t)>& work) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &work;
+            jobCount = count;
+            next = 0;
+            busy = workers.size();
+            generation++;
+        }
+        wake.notify_all();
+        drain();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return busy == 0; });
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    const std::function<void(size_t)>* job = nullptr;
+    size_t jobCount = 0;
+    std::atomic<size_t> next{0};
+    size_t busy = 0;
+    unsigned generation = 0;
+    bool stopping = false;
+
+    void drain() {
+        for (size_t i = next.fetch_add(1); i < jobCount; i = next.fetch_add(1)) {
+            (*job)(i);
+        }
+    }
+
+    void worker() {
+        unsigned seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+            }
+            drain();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                busy--;
+            }
+            finished.notify_one();
+        }
+    }
+};
+
+// Drift odds of LanderRandom::drift(): random(-1, DRIFT_CONTROL) with
+// anything over 1 folded to 0.  Index 0, 1 and 2 hold drift -1, 0 and 1.
+struct DriftOdds {
+    float p[3] = {};
+
+    DriftOdds() {
+        for (int value = -1; value < DRIFT_CONTROL; value++) {
+            p[(value > 1 ? 0 : value) + 1] += 1.0f / (DRIFT_CONTROL + 1);
+        }
+    }
+};
+
+// What a folded action does: speed change, steering and the gear key
+struct ActionEffect {
+    int speed;
+    int steer_x;
+    int steer_y;
+    bool lower_gear;
+};
+
+ActionEffect actionEffect(const int action) {
+    ActionEffect effect = {0, 0, 0, false};
+    switch (action) {
+        case LanderAutopilot::ACTION_NONE:
+            break;
+        case LanderAutopilot::ACTION_RAISE_SPEED:
+            effect.speed = 1;
+            break;
+        case LanderAutopilot::ACTION_LOWER_SPEED:
+            effect.speed = -1;
+            break;
+        case LanderAutopilot::ACTION_LOWER_GEAR:
+            effect.lower_gear = true;
+            break;
+        default: {
+            int cell = action - LanderAutopilot::ACTION_STEER_FIRST;
+            cell += cell >= 4;
+            effect.steer_x = cell / 3 - 1;
+            effect.steer_y = cell % 3 - 1;
+            break;
+        }
+    }
+    return effect;
+}
+
+int nextPhase(const int phase, const bool lowerGear, const int distance) {
+    switch (phase) {
+        case LanderAutopilot::GEAR_PHASE_UP:
+            // Final is only checked against the distance before this tick's move
+            return distance < FINAL_DISTANCE ? LanderAutopilot::GEAR_PHASE_UP_FINAL : LanderAutopilot::GEAR_PHASE_UP;
+        case LanderAutopilot::GEAR_PHASE_UP_FINAL:
+            return lowerGear ? LanderAutopilot::GEAR_PHASE_LOWERING_1 : LanderAutopilot::GEAR_PHASE_UP_FINAL;
+        case LanderAutopilot::GEAR_PHASE_LOWERING_1:
+            return LanderAutopilot::GEAR_PHASE_LOWERING_2;
+        default:
+            return LanderAutopilot::GEAR_PHASE_DOWN;
+    }
+}
+
+int clampOffset(const int offset) {
+    return std::min(std::max(offset, -static_cast<int>(MAX_DRIFT)), static_cast<int>(MAX_DRIFT));
+}
+
+class Solver {
+public:
+    Solver(const Config& config, WorkerPool& pool) :
+        config(config),
+        pool(pool),
+        speeds(config.max_speed + 1),
+        layerSize(static_cast<size_t>(speeds) * PHASES * OFFSET_STATES),
+        values(layerSize * speeds),
+        scratch(PHASES * OFFSET_STATES),
+        rowDelta(PHASES * OFFSETS),
+        layerStart(INITIAL_DISTANCE + 2)
+    {
+        // Policy layers only hold the phases that exist at their distance
+        layerStart[0] = 0;
+        for (int d = 1; d <= INITIAL_DISTANCE; d++) {
+            layerStart[d + 1] = layerStart[d] + static_cast<size_t>(speeds) * phases(d) * OFFSET_STATES;
+        }
+        policy.resize(layerStart[INITIAL_DISTANCE + 1]);
+    }
+
+    void solve() {
+        for (int d = 1; d <= INITIAL_DISTANCE; d++) {
+            solveLayer(d);
+        }
+        startValue = layer(INITIAL_DISTANCE)[valueIndex(0, 0, 0, 0)];
+    }
+
+    // Best folded action for a game state, offsets may be signed
+    int action(const int distance, const int speed, const int phase, const int x, const int y) const {
+        const int d = std::min(std::max(distance, 1), static_cast<int>(INITIAL_DISTANCE));
+        const int v = std::min(speed, config.max_speed);
+        const int p = phases(d) == 1 ? 0 : phase;
+        return policy[layerStart[d] + policyIndex(d, v, p, std::abs(x), std::abs(y))];
+    }
+
+    static int phases(const int distance) {
+        return distance < FINAL_DISTANCE ? PHASES : 1;
+    }
+
+    size_t states() const { return policy.size(); }
+    size_t valueBytes() const { return values.size() * sizeof(float); }
+    long sweeps() const { return totalSweeps; }
+    float expectedCost() const { return startValue; }
+
+private:
+    const Config& config;
+    WorkerPool& pool;
+    const DriftOdds drift;
+    const int speeds;
+    const size_t layerSize;
+    std::vector<float> values;    // Ring of the last `speeds` distance layers
+    std::vector<float> scratch;   // Next sweep of the speed 0 states
+    std::vector<float> rowDelta;  // Largest change per row in a sweep
+    std::vector<size_t> layerStart;
+    std::vector<uint8_t> policy;  // One action per state, every distance
+    long totalSweeps = 0;
+    float startValue = 0.0f;
+
+    float* layer(const int distance) {
+        return &values[(distance % speeds) * layerSize];
+    }
+
+    static size_t valueIndex(const int speed, const int phase, const int x, const int y) {
+        return ((static_cast<size_t>(speed) * PHASES + phase) * OFFSETS + x) * OFFSETS + y;
+    }
+
+    static size_t policyIndex(const int distance, const int speed, const int phase, const int x, const int y) {
+        return ((static_cast<size_t>(speed) * phases(distance) + phase) * OFFSETS + x) * OFFSETS + y;
+    }
+
+    bool allowed(const int action, const int speed, const int phase) const {
+        switch (action) {
+            case LanderAutopilot::ACTION_RAISE_SPEED:
+                return speed < config.max_speed;
+            case LanderAutopilot::ACTION_LOWER_SPEED:
+                return speed > 0;
+            case LanderAutopilot::ACTION_LOWER_GEAR:
+                return phase == LanderAutopilot::GEAR_PHASE_UP_FINAL;
+            default:
+                return true;
+        }
+    }
+
+    // Expected cost of pressing action in a state, from the layers solved so far
+    float actionValue(const int distance, const int speed, const int phase, const int x, const int y, const int action) {
+        const ActionEffect effect = actionEffect(action);
+        const int newSpeed = speed + effect.speed;
+        const int newPhase = nextPhase(phase, effect.lower_gear, distance);
+        const int newDistance = distance - newSpeed;
+        const float* next = newDistance > 0 ? layer(newDistance) : nullptr;
+        const bool safe = newSpeed <= MAX_SAFE_SPEED && newPhase == LanderAutopilot::GEAR_PHASE_DOWN;
+
+        float expected = 0.0f;
+        for (int dx = 0; dx < 3; dx++) {
+            if (drift.p[dx] == 0.0f) {
+                continue;
+            }
+            const int newX = std::abs(clampOffset(x + effect.steer_x + dx - 1));
+            float row = 0.0f;
+
+            for (int dy = 0; dy < 3; dy++) {
+                if (drift.p[dy] == 0.0f) {
+                    continue;
+                }
+                const int newY = std::abs(clampOffset(y + effect.steer_y + dy - 1));
+                float value;
+                if (next) {
+                    value = next[valueIndex(newSpeed, newPhase, newX, newY)];
+                } else {
+                    const bool success = safe && newX < BAY_HALF_WIDTH && newY < BAY_HALF_HEIGHT;
+                    value = success ? 0.0f : config.penalty;
+                }
+                row += drift.p[dy] * value;
+            }
+            expected += drift.p[dx] * row;
+        }
+        return 1.0f + expected;
+    }
+
+    // Cheapest action, the first one listed wins a tie
+    float bestAction(const int distance, const int speed, const int phase, const int x, const int y, uint8_t& best) {
+        float bestValue = 0.0f;
+        for (int action = 0; action < ACTIONS; action++) {
+            if (!allowed(action, speed, phase)) {
+                continue;
+            }
+            const float value = actionValue(distance, speed, phase, x, y, action);
+            if (action == 0 || value < bestValue) {
+                bestValue = value;
+                best = static_cast<uint8_t>(action);
+            }
+        }
+        return bestValue;
+    }
+
+    void solveLayer(const int d) {
+        float* current = layer(d);
+        uint8_t* actions = &policy[layerStart[d]];
+        const int layerPhases = phases(d);
+        const size_t zeroRows = static_cast<size_t>(layerPhases) * OFFSETS;
+
+        // Speed 0 can stay at this distance.  Start from raising the speed
+        // straight away, which never depends on this layer, and sweep until
+        // nothing improves.
+        pool.run(zeroRows, [&](const size_t row) {
+            const int p = static_cast<int>(row / OFFSETS);
+            const int x = static_cast<int>(row % OFFSETS);
+            for (int y = 0; y < OFFSETS; y++) {
+                current[valueIndex(0, p, x, y)] = actionValue(d, 0, p, x, y, LanderAutopilot::ACTION_RAISE_SPEED);
+            }
+        });
+
+        for (int sweep = 0; sweep < MAX_SWEEPS; sweep++) {
+            totalSweeps++;
+            pool.run(zeroRows, [&](const size_t row) {
+                const int p = static_cast<int>(row / OFFSETS);
+                const int x = static_cast<int>(row % OFFSETS);
+                float delta = 0.0f;
+                for (int y = 0; y < OFFSETS; y++) {
+                    uint8_t best = 0;
+                    const float value = bestAction(d, 0, p, x, y, best);
+                    delta = std::max(delta, current[valueIndex(0, p, x, y)] - value);
+                    scratch[(p * OFFSETS + x) * OFFSETS + y] = value;
+                    actions[policyIndex(d, 0, p, x, y)] = best;
+                }
+                rowDelta[row] = delta;
+            });
+
+            for (int p = 0; p < layerPhases; p++) {
+                std::copy_n(&scratch[p * OFFSET_STATES], OFFSET_STATES, &current[valueIndex(0, p, 0, 0)]);
+            }
+            if (*std::max_element(rowDelta.begin(), rowDelta.begin() + zeroRows) < SWEEP_TOLERANCE) {
+                break;
+            }
+        }
+
+        // Every other speed only leads to smaller distances or to speed 0 here
+        pool.run(static_cast<size_t>(config.max_speed) * layerPhases, [&](const size_t row) {
+            const int v = static_cast<int>(row / layerPhases) + 1;
+            const int p = static_cast<int>(row % layerPhases);
+            for (int x = 0; x < OFFSETS; x++) {
+                for (int y = 0; y < OFFSETS; y++) {
+                    uint8_t best = 0;
+                    current[valueIndex(v, p, x, y)] = bestAction(d, v, p, x, y, best);
+                    actions[policyIndex(d, v, p, x, y)] = best;
+                }
+            }
+        });
+    }
+};
+
+struct Evaluation {
+    uint64_t outcomes[OUTCOME_COUNT] = {};
+    uint64_t elapsed_ticks = 0;  // Summed over successful landings
+};
+
+byte gearPhase(const LanderGame& game) {
+    return LanderAutopilot::gearPhase(game.getCurrentGearBitmapIndex(), game.getApproachState() == APPROACH_FINAL);
+}
+
+// Fly complete approaches through the real LanderGame.  pilot maps a game
+// to a folded action, called once per in-flight tick.
+Evaluation evaluate(
+    WorkerPool& pool, const Config& config,
+    const std::function<int(const LanderGame&)>& pilot,
+    const std::function<void(const LanderGame&, int)>& visit = nullptr
+) {
+    const uint64_t chunks = (config.runs + CHUNK_RUNS - 1) / CHUNK_RUNS;
+    std::vector<Evaluation> results(chunks);
+    std::mutex visitMutex;
+
+    pool.run(chunks, [&](const size_t chunk) {
+        LanderRandom rng(config.seed, static_cast<uint32_t>(chunk));
+        Evaluation& result = results[chunk];
+        const uint64_t first = chunk * CHUNK_RUNS;
+        const uint64_t last = std::min(first + CHUNK_RUNS, config.runs);
+
+        for (uint64_t run = first; run < last; run++) {
+            LanderGame game;
+            InputFrame frame = {};
+            unsigned long tick = 0;
+
+            // Levers off, then on, takes the game into flight
+            game.update(frame, ++tick * SIMULATION_TICK_MS);
+            frame.thrust_lever = frame.systems_lever = frame.confirm_lever = true;
+
+            while (!game.isGameOver() && tick < MAX_TICKS) {
+                if (game.getApproachState() >= APPROACH_IN_FLIGHT) {
+                    const int action = pilot(game);
+                    if (visit) {
+                        std::lock_guard<std::mutex> lock(visitMutex);
+                        visit(game, action);
+                    }
+                    frame.key = LanderAutopilot::toControl(
+                        action, game.getMotherShipXOffset(), game.getMotherShipYOffset()
+                    );
+                }
+                rng.nextDrift(DRIFT_CONTROL, frame.drift_x, frame.drift_y);
+                game.update(frame, ++tick * SIMULATION_TICK_MS);
+            }
+
+            if (!game.isGameOver()) {
+                result.outcomes[OUTCOME_TIMEOUT]++;
+                continue;
+            }
+            const ENDING_OUTCOME outcome = game.getOutcome();
+            result.outcomes[outcome]++;
+            if (outcome == ENDING_SUCCESS) {
+                result.elapsed_ticks += game.getElapsedTime() / SIMULATION_TICK_MS;
+            }
+        }
+    });
+
+    Evaluation total;
+    for (const Evaluation& result : results) {
+        for (int i = 0; i < OUTCOME_COUNT; i++) {
+            total.outcomes[i] += result.outcomes[i];
+        }
+        total.elapsed_ticks += result.elapsed_ticks;
+    }
+    return total;
+}
+
+void printEvaluation(const char* name, const Evaluation& evaluation, const uint64_t runs) {
+    printf("%-10s", name);
+    for (int i = 0; i < OUTCOME_COUNT; i++) {
+        printf("  %s %.4f%%", OUTCOME_NAMES[i], 100.0 * evaluation.outcomes[i] / runs);
+    }
+    const uint64_t landed = evaluation.outcomes[ENDING_SUCCESS];
+    printf("  mean time %.2f s\n",
+           landed ? evaluation.elapsed_ticks * SIMULATION_TICK_MS / 1000.0 / landed : 0.0);
+}
+
+// Table in the LanderAutopilot::lookup() layout
+struct PolicyTable {
+    std::vector<uint8_t> cells;       // (pattern, cell count) pairs
+    std::vector<uint16_t> runStarts;  // First cell of every RUN_STRIDE-th run
+    std::vector<uint8_t> patterns;    // Row number per x offset class
+    std::vector<uint8_t> rows;        // ROW_BYTES per row
+    size_t patternCount = 0;
+    size_t rowCount = 0;
+};
+
+using Pattern = std::array<uint8_t, LanderAutopilot::PATTERN_SIZE>;
+using Row = std::array<uint8_t, LanderAutopilot::OFFSET_CLASSES>;
+
+// Each table entry covers many solver states.  Entries the optimal policy
+// reaches in flight take the action it used there most.  The rest are
+// free: a cell reuses any pattern that agrees on its flown entries, and a
+// cell never flown through repeats the pattern before it to extend the run.
+// New patterns fill their free entries with the most common action over
+// all of the entry's states, so the autopilot still copes reasonably when
+// switched on mid-approach.
+bool encodeTable(const std::vector<uint64_t>& votes, const std::vector<uint64_t>& flownVotes, PolicyTable& table) {
+    constexpr int PATTERN_SIZE = LanderAutopilot::PATTERN_SIZE;
+
+    std::vector<Pattern> patterns;
+    std::vector<size_t> cellPattern(LanderAutopilot::CELL_COUNT);
+
+    for (size_t cell = 0; cell < cellPattern.size(); cell++) {
+        Pattern wanted;
+        bool flown[PATTERN_SIZE];
+        bool anyFlown = false;
+
+        for (int offset = 0; offset < PATTERN_SIZE; offset++) {
+            const size_t entry = (cell * PATTERN_SIZE + offset) * ACTIONS;
+            flown[offset] = std::any_of(&flownVotes[entry], &flownVotes[entry + ACTIONS], [](uint64_t n) { return n > 0; });
+            const uint64_t* tally = flown[offset] ? &flownVotes[entry] : &votes[entry];
+            wanted[offset] = static_cast<uint8_t>(std::max_element(tally, tally + ACTIONS) - tally);
+            anyFlown |= flown[offset];
+        }
+
+        const auto fits = [&](const Pattern& pattern) {
+            for (int offset = 0; offset < PATTERN_SIZE; offset++) {
+                if (flown[offset] && pattern[offset] != wanted[offset]) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        if (cell > 0 && fits(patterns[cellPattern[cell - 1]])) {
+            cellPattern[cell] = cellPattern[cell - 1];
+            continue;
+        }
+        const auto match = anyFlown ? std::find_if(patterns.begin(), patterns.end(), fits) : patterns.end();
+        if (match != patterns.end()) {
+            cellPattern[cell] = match - patterns.begin();
+        } else {
+            cellPattern[cell] = patterns.size();
+            patterns.push_back(wanted);
+        }
+    }
+
+    table = PolicyTable();
+    std::vector<Row> rows;
+    for (const Pattern& pattern : patterns) {
+        for (int x = 0; x < LanderAutopilot::OFFSET_CLASSES; x++) {
+            Row row;
+            std::copy_n(&pattern[x * LanderAutopilot::OFFSET_CLASSES], row.size(), row.begin());
+            const auto match = std::find(rows.begin(), rows.end(), row);
+            table.patterns.push_back(static_cast<uint8_t>(match - rows.begin()));
+            if (match == rows.end()) {
+                rows.push_back(row);
+            }
+        }
+    }
+
+    if (patterns.size() > 256 || rows.size() > 256) {
+        fprintf(stderr, "%zu patterns or %zu rows don't fit byte numbers\n", patterns.size(), rows.size());
+        return false;
+    }
+
+    for (const Row& row : rows) {
+        for (size_t y = 0; y < row.size(); y += 2) {
+            table.rows.push_back(static_cast<uint8_t>(row[y] << 4 | row[y + 1]));
+        }
+    }
+    table.patternCount = patterns.size();
+    table.rowCount = rows.size();
+
+    for (size_t cell = 0; cell < cellPattern.size();) {
+        size_t length = 1;
+        while (length < 255 && cell + length < cellPattern.size() && cellPattern[cell + length] == cellPattern[cell]) {
+            length++;
+        }
+        if (table.cells.size() / 2 % LanderAutopilot::RUN_STRIDE == 0) {
+            table.runStarts.push_back(static_cast<uint16_t>(cell));
+        }
+        table.cells.push_back(static_cast<uint8_t>(cellPattern[cell]));
+        table.cells.push_back(static_cast<uint8_t>(length));
+        cell += length;
+    }
+    return true;
+}
+
+size_t tableEntry(const LanderGame& game) {
+    const uint16_t cell = LanderAutopilot::cellIndex(game.getLanderDistance(), game.getLanderSpeed(), gearPhase(game));
+    const byte offset = LanderAutopilot::offsetIndex(game.getMotherShipXOffset(), game.getMotherShipYOffset());
+    return static_cast<size_t>(cell) * LanderAutopilot::PATTERN_SIZE + offset;
+}
+
+int solverPilot(const Solver& solver, const LanderGame& game) {
+    return solver.action(game.getLanderDistance(), game.getLanderSpeed(), gearPhase(game),
+                         game.getMotherShipXOffset(), game.getMotherShipYOffset());
+}
+
+int tablePilot(const PolicyTable& table, const LanderGame& game) {
+    const size_t entry = tableEntry(game);
+    return LanderAutopilot::lookup(
+        table.cells.data(), table.runStarts.data(), static_cast<uint16_t>(table.runStarts.size()),
+        table.patterns.data(), table.rows.data(),
+        static_cast<uint16_t>(entry / LanderAutopilot::PATTERN_SIZE),
+        static_cast<byte>(entry % LanderAutopilot::PATTERN_SIZE)
+    );
+}
+
+// The table flies into states the optimal policy never visits, where its
+// free entries may be wrong.  So fly the table, record what the optimal
+// policy would have pressed in every state it reached, and rebuild until
+// it stops failing more often than the optimal policy, keeping the best.
+bool buildTable(
+    WorkerPool& pool, const Config& config, const Solver& solver,
+    const Evaluation& optimal, PolicyTable& table, Evaluation& result
+) {
+    const size_t entries = static_cast<size_t>(LanderAutopilot::CELL_COUNT) * LanderAutopilot::PATTERN_SIZE;
+    std::vector<uint64_t> votes(entries * ACTIONS);
+    std::vector<uint64_t> flownVotes(entries * ACTIONS);
+
+    for (int d = 1; d <= INITIAL_DISTANCE; d++) {
+        for (int v = 0; v <= config.max_speed; v++) {
+            for (int p = 0; p < Solver::phases(d); p++) {
+                for (int x = 0; x < OFFSETS; x++) {
+                    for (int y = 0; y < OFFSETS; y++) {
+                        const size_t entry = static_cast<size_t>(LanderAutopilot::cellIndex(d, v, p)) * LanderAutopilot::PATTERN_SIZE +
+                                             LanderAutopilot::offsetIndex(x, y);
+                        votes[entry * ACTIONS + solver.action(d, v, p, x, y)]++;
+                    }
+                }
+            }
+        }
+    }
+
+    const auto record = [&](const LanderGame& game, int) {
+        flownVotes[tableEntry(game) * ACTIONS + solverPilot(solver, game)]++;
+    };
+    evaluate(pool, config, [&](const LanderGame& game) { return solverPilot(solver, game); }, record);
+
+    PolicyTable candidate;
+    for (int round = 1; round <= config.rounds; round++) {
+        if (!encodeTable(votes, flownVotes, candidate)) {
+            // Every round pins more entries; stop once it no longer fits
+            return round > 1;
+        }
+        const Evaluation flown =
+            evaluate(pool, config, [&](const LanderGame& game) { return tablePilot(candidate, game); }, record);
+
+        printf("round %d: ", round);
+        printEvaluation("table", flown, config.runs);
+        if (round == 1 || flown.outcomes[ENDING_SUCCESS] > result.outcomes[ENDING_SUCCESS]) {
+            table = candidate;
+            result = flown;
+        }
+        if (flown.outcomes[ENDING_SUCCESS] >= optimal.outcomes[ENDING_SUCCESS]) {
+            break;
+        }
+    }
+    return true;
+}
+
+bool writeTable(const char* path, const PolicyTable& table, const Config& config, const Evaluation& evaluation) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        perror(path);
+        return false;
+    }
+
+    fprintf(file,
+        "//\n// Created by ash on 6/15/25.\n//\n\n"
+        "// Generated by host/policy_solver.cpp, do not edit.\n"
+        "//   --max-speed %d --penalty %g --runs %llu --seed %llu\n"
+        "// Flown %llu times: %.4f%% success, mean time %.2f s.\n"
+        "// Only included by LanderAutopilot.cpp.\n\n"
+        "#ifndef LANDER_AUTOPILOT_POLICY_H\n#define LANDER_AUTOPILOT_POLICY_H\n\n"
+        "#include \"Arduino.h\"\n#include \"LanderAutopilot.h\"\n\n",
+        config.max_speed, config.penalty,
+        static_cast<unsigned long long>(config.runs), static_cast<unsigned long long>(config.seed),
+        static_cast<unsigned long long>(config.runs), 100.0 * evaluation.outcomes[ENDING_SUCCESS] / config.runs,
+        evaluation.outcomes[ENDING_SUCCESS]
+            ? evaluation.elapsed_ticks * SIMULATION_TICK_MS / 1000.0 / evaluation.outcomes[ENDING_SUCCESS]
+            : 0.0);
+
+    fprintf(file, "const uint8_t AUTOPILOT_CELLS[%zu] PROGMEM = {", table.cells.size());
+    for (size_t i = 0; i < table.cells.size(); i++) {
+        fprintf(file, "%s%u%s", i % 16 ? " " : "\n  ", table.cells[i], i + 1 < table.cells.size() ? "," : "");
+    }
+    fprintf(file, "\n};\n\n");
+
+    fprintf(file, "const uint16_t AUTOPILOT_RUN_STARTS[%zu] PROGMEM = {", table.runStarts.size());
+    for (size_t i = 0; i < table.runStarts.size(); i++) {
+        fprintf(file, "%s%u%s", i % 16 ? " " : "\n  ", table.runStarts[i], i + 1 < table.runStarts.size() ? "," : "");
+    }
+    fprintf(file, "\n};\n\n");
+
+    fprintf(file, "const uint8_t AUTOPILOT_PATTERNS[%zu * LanderAutopilot::OFFSET_CLASSES] PROGMEM = {", table.patternCount);
+    for (size_t i = 0; i < table.patterns.size(); i++) {
+        fprintf(file, "%s%u%s", i % 16 ? " " : "\n  ", table.patterns[i], i + 1 < table.patterns.size() ? "," : "");
+    }
+    fprintf(file, "\n};\n\n");
+
+    fprintf(file, "const uint8_t AUTOPILOT_ROWS[%zu * LanderAutopilot::ROW_BYTES] PROGMEM = {", table.rowCount);
+    for (size_t i = 0; i < table.rows.size(); i++) {
+        fprintf(file, "%s0x%02X%s", i % 16 ? " " : "\n  ", table.rows[i], i + 1 < table.rows.size() ? "," : "");
+    }
+    fprintf(file, "\n};\n\n#endif // LANDER_AUTOPILOT_POLICY_H\n");
+
+    return fclose(file) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Config config;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--max-speed") == 0 && i + 1 < argc) {
+            config.max_speed = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--penalty") == 0 && i + 1 < argc) {
+            config.penalty = static_cast<float>(atof(argv[++i]));
+        } else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            config.runs = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+            config.rounds = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            config.seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            config.threads = static_cast<unsigned>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            config.out = argv[++i];
+        } else {
+            fprintf(stderr,
+                "usage: %s [--max-speed N] [--penalty COST] [--runs N] [--rounds N] [--seed N] [--threads N] [--out FILE]\n",
+                argv[0]);
+            return 2;
+        }
+    }
+
+    if (config.max_speed < 1 || config.max_speed > 120 || config.runs == 0) {
+        fprintf(stderr, "max speed must be 1-120 and runs at least 1\n");
+        return 2;
+    }
+    config.threads = std::max(config.threads, 1u);
+
+    WorkerPool pool(config.threads);
+    Solver solver(config, pool);
+
+    const auto start = std::chrono::steady_clock::now();
+    solver.solve();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("solved %zu states in %.2f s on %u threads (%ld speed 0 sweeps, %zu KB of values)\n",
+           solver.states(), seconds, config.threads, solver.sweeps(), solver.valueBytes() / 1024);
+    printf("expected cost from the start: %.3f ticks\n", solver.expectedCost());
+
+    const Evaluation optimal = evaluate(pool, config, [&](const LanderGame& game) { return solverPilot(solver, game); });
+    printEvaluation("optimal", optimal, config.runs);
+
+    PolicyTable table;
+    Evaluation compressed;
+    if (!buildTable(pool, config, solver, optimal, table, compressed)) {
+        return 1;
+    }
+    const size_t indexBytes = table.runStarts.size() * sizeof(uint16_t);
+    printf("table: %u cells in %zu run bytes and %zu index bytes, %zu patterns in %zu bytes, "
+           "%zu rows in %zu bytes: %zu bytes of PROGMEM\n",
+           LanderAutopilot::CELL_COUNT, table.cells.size(), indexBytes, table.patternCount, table.patterns.size(),
+           table.rowCount, table.rows.size(),
+           table.cells.size() + indexBytes + table.patterns.size() + table.rows.size());
+
+    if (config.out && !writeTable(config.out, table, config, compressed)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Prints the frame stage timings dumped by LanderProfiler.
+//
+//   pio run -e profile && .pio/build/profile/program capture.bin [--buckets]
+//
+// The capture is whatever came over Serial after sending PROFILER_DUMP_COMMAND,
+// so it can hold scheduler reports or several dumps as well; every dump
+// found in it is decoded in turn.  Percentiles are interpolated inside the
+// log2 buckets, so they are estimates within a factor of two at worst.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "LanderProfileRecord.h"
+
+namespace {
+
+constexpr uint8_t BUCKET_COUNT = LanderProfileRecord::BUCKET_COUNT;
+
+const char* stageName(const uint8_t stage) {
+    switch (stage) {
+        case PROFILE_INPUT:
+            return "input";
+        case PROFILE_UPDATE:
+            return "update";
+        case PROFILE_DRAW:
+            return "oled draw";
+        case PROFILE_SEND:
+            return "oled send";
+        case PROFILE_DISTANCE:
+            return "7seg";
+        case PROFILE_IDLE:
+            return "idle";
+        default:
+            return "?";
+    }
+}
+
+struct StageHistogram {
+    uint16_t counts[BUCKET_COUNT];
+    uint16_t longest;
+};
+
+uint16_t readWord(const uint8_t* bytes) {
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+// Duration below which share of the samples fall, spreading each bucket's
+// samples evenly over its range.  The last bucket is open, so it ends at
+// the longest sample.
+double percentile(const StageHistogram& stage, const uint32_t total, const double share) {
+    const double target = share * total;
+    double seen = 0;
+
+    for (uint8_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+        const uint16_t count = stage.counts[bucket];
+        if (count == 0) {
+            continue;
+        }
+        if (seen + count >= target) {
+            const double low = LanderProfileRecord::bucketStart(bucket);
+            double high = bucket + 1 < BUCKET_COUNT ? LanderProfileRecord::bucketStart(bucket + 1) : stage.longest;
+            if (high > stage.longest) {
+                high = stage.longest;
+            }
+            if (high < low) {
+                high = low;
+            }
+            return low + (high - low) * (target - seen) / count;
+        }
+        seen += count;
+    }
+    return stage.longest;
+}
+
+void printDump(const std::vector<StageHistogram>& stages, const size_t offset, const bool buckets) {
+    printf("dump at byte %zu\n", offset);
+    printf("%-10s %8s %8s %8s %8s %8s\n", "stage", "samples", "p50 us", "p90 us", "p99 us", "max us");
+
+    for (size_t i = 0; i < stages.size(); i++) {
+        const StageHistogram& stage = stages[i];
+        uint32_t total = 0;
+        for (const uint16_t count : stage.counts) {
+            total += count;
+        }
+
+        if (total == 0) {
+            printf("%-10s %8u\n", stageName(i), 0U);
+            continue;
+        }
+
+        printf("%-10s %8u %8.0f %8.0f %8.0f %8u\n",
+               stageName(i), total,
+               percentile(stage, total, 0.50), percentile(stage, total, 0.90), percentile(stage, total, 0.99),
+               stage.longest);
+
+        if (buckets) {
+            for (uint8_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+                if (stage.counts[bucket] != 0) {
+                    printf("%12s>= %6u us  %u\n", "", LanderProfileRecord::bucketStart(bucket), stage.counts[bucket]);
+                }
+            }
+        }
+    }
+    printf("\n");
+}
+
+// Decode one dump starting at the magic, or return 0 if it is not one
+size_t decode(const std::vector<uint8_t>& data, const size_t offset, const bool buckets) {
+    const uint8_t* header = &data[offset];
+    if (data.size() - offset < LanderProfileRecord::HEADER_SIZE ||
+        header[0] != LanderProfileRecord::MAGIC_0 || header[1] != LanderProfileRecord::MAGIC_1 ||
+        header[2] != LanderProfileRecord::VERSION || header[4] != BUCKET_COUNT) {
+        return 0;
+    }
+
+    const uint8_t stageCount = header[3];
+    const size_t size = LanderProfileRecord::HEADER_SIZE + stageCount * LanderProfileRecord::STAGE_SIZE;
+    if (data.size() - offset < size) {
+        fprintf(stderr, "dump at byte %zu is cut short\n", offset);
+        return 0;
+    }
+
+    std::vector<StageHistogram> stages(stageCount);
+    const uint8_t* bytes = header + LanderProfileRecord::HEADER_SIZE;
+    for (StageHistogram& stage : stages) {
+        for (uint16_t& count : stage.counts) {
+            count = readWord(bytes);
+            bytes += 2;
+        }
+        stage.longest = readWord(bytes);
+        bytes += 2;
+    }
+
+    printDump(stages, offset, buckets);
+    return size;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    bool buckets = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--buckets") == 0) {
+            buckets = true;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    if (!path) {
+        fprintf(stderr, "usage: %s <capture|-> [--buckets]\n", argv[0]);
+        return 2;
+    }
+
+    FILE* file = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        return 1;
+    }
+
+    std::vector<uint8_t> data;
+    uint8_t chunk[4096];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + read);
+    }
+    if (file != stdin) {
+        fclose(file);
+    }
+
+    size_t dumps = 0;
+    for (size_t offset = 0; offset < data.size();) {
+        const size_t size = decode(data, offset, buckets);
+        if (size > 0) {
+            dumps++;
+            offset += size;
+        } else {
+            offset++;
+        }
+    }
+
+    if (dumps == 0) {
+        fprintf(stderr, "%s: no profiler dump found\n", path);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,178 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Cost and odds of the mother ship drift generators.
+//
+//   pio run -e random && .pio/build/random/program [--draws N] [--seed N]
+//
+// "avr-libc" replays what the game used to do every tick: two calls of the
+// Arduino random(-1, DRIFT_CONTROL), each a Park-Miller random() (a 32-bit
+// division by 127773) and a 32-bit modulo, with values over 1 folded to 0.
+// "LanderRandom" is one next() split into both drifts.  Cycles come from
+// the TSC on x86 and are host cycles; the AVR has no divider, so its
+// software division makes the gap there far wider than shown here.
+//
+// After timing, the drift histograms of both are printed side by side, and
+// jump() and split() are checked against plain next() calls.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define LANDER_HAVE_TSC 1
+#endif
+
+#include "LanderConfig.h"
+#include "LanderRandom.h"
+
+namespace {
+
+uint64_t cycles() {
+#ifdef LANDER_HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// avr-libc random() and the Arduino random(min, max) wrapper around it
+class AvrRandom {
+public:
+    explicit AvrRandom(const uint32_t seed) : next(seed) {}
+
+    long random(const long low, const long high) {
+        if (low >= high) {
+            return low;
+        }
+        return doRandom() % (high - low) + low;
+    }
+
+    void nextDrift(const uint8_t driftControl, int8_t& driftX, int8_t& driftY) {
+        driftX = fold(random(-1, driftControl));
+        driftY = fold(random(-1, driftControl));
+    }
+
+private:
+    uint32_t next;
+
+    // Park-Miller "minimal standard", as in avr-libc random.c
+    long doRandom() {
+        long x = static_cast<long>(next % 0x7FFFFFFEUL) + 1;
+        const long hi = x / 127773;
+        const long lo = x % 127773;
+        x = 16807 * lo - 2836 * hi;
+        if (x < 0) {
+            x += 0x7FFFFFFF;
+        }
+        next = static_cast<uint32_t>(x) - 1;
+        return static_cast<long>(next);
+    }
+
+    static int8_t fold(const long value) { return static_cast<int8_t>(value > 1 ? 0 : value); }
+};
+
+struct Histogram {
+    uint64_t counts[3][3] = {};
+
+    void add(const int8_t x, const int8_t y) { counts[x + 1][y + 1]++; }
+};
+
+template <typename Random>
+Histogram run(const char* name, Random random, const uint64_t draws) {
+    Histogram histogram;
+
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t startCycles = cycles();
+
+    for (uint64_t i = 0; i < draws; i++) {
+        int8_t driftX;
+        int8_t driftY;
+        random.nextDrift(DRIFT_CONTROL, driftX, driftY);
+        histogram.add(driftX, driftY);
+    }
+
+    const uint64_t spentCycles = cycles() - startCycles;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%-14s %6.2f ns/tick", name, seconds * 1e9 / draws);
+#ifdef LANDER_HAVE_TSC
+    printf("  %6.2f cycles/tick", static_cast<double>(spentCycles) / draws);
+#else
+    (void) spentCycles;
+#endif
+    printf("\n");
+    return histogram;
+}
+
+void printOdds(const Histogram& avr, const Histogram& lander, const uint64_t draws) {
+    printf("\ndrift (x, y)   avr-libc  LanderRandom\n");
+    for (int x = 0; x < 3; x++) {
+        for (int y = 0; y < 3; y++) {
+            printf(
+                "(%2d, %2d)       %7.4f%%  %7.4f%%\n", x - 1, y - 1,
+                100.0 * avr.counts[x][y] / draws, 100.0 * lander.counts[x][y] / draws
+            );
+        }
+    }
+}
+
+bool checkJump(const uint32_t seed) {
+    for (uint32_t steps = 0; steps < 1000; steps += 37) {
+        LanderRandom stepped(seed, steps);
+        LanderRandom jumped(seed, steps);
+        for (uint32_t i = 0; i < steps; i++) {
+            stepped.next();
+        }
+        jumped.jump(steps);
+        if (stepped.next() != jumped.next()) {
+            printf("jump(%u) differs from %u calls of next()\n", steps, steps);
+            return false;
+        }
+    }
+    printf("\njump(n) matches n calls of next()\n");
+    return true;
+}
+
+void showSplit(const uint32_t seed) {
+    LanderRandom parent(seed);
+    LanderRandom first = parent.split();
+    LanderRandom second = parent.split();
+    printf("split streams:");
+    for (int i = 0; i < 4; i++) {
+        printf("  %08x/%08x/%08x", parent.next(), first.next(), second.next());
+    }
+    printf("\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    uint64_t draws = 100000000;
+    uint32_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--draws") == 0 && i + 1 < argc) {
+            draws = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else {
+            fprintf(stderr, "usage: %s [--draws N] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const Histogram avr = run("avr-libc", AvrRandom(seed), draws);
+    const Histogram lander = run("LanderRandom", LanderRandom(seed), draws);
+    printOdds(avr, lander, draws);
+
+    if (!checkJump(seed)) {
+        return 1;
+    }
+    showSplit(seed);
+    return 0;
+}
@@ -0,0 +1,277 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Replays an input log recorded by LanderInputLog through the real
+// LanderGame code, headless and as fast as the host allows.
+//
+//   pio run -e replay && .pio/build/replay/program game.bin [--trace] [--repeat N]
+//
+// A ring dump that starts mid-game carries the game's snapshot from
+// before its first tick, and the replay starts from that.  A Serial stream
+// runs on through every ending and restart in place, and each landing is
+// listed.  Rewind ticks step back through a LanderRewind ring sized as on
+// the device.  Every tick is also saved to a LanderSnapshot and restored
+// into a second game, which must come out identical.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "LanderGame.h"
+#include "LanderInputRecord.h"
+#include "LanderRewind.h"
+
+namespace {
+
+const char* outcomeName(const ENDING_OUTCOME outcome) {
+    switch (outcome) {
+        case ENDING_SUCCESS:
+            return "success";
+        case ENDING_NO_GEAR:
+            return "no gear";
+        case ENDING_TOO_FAST:
+            return "too fast";
+        case ENDING_MISSED_MOTHER_SHIP:
+            return "missed";
+    }
+    return "?";
+}
+
+const char* stateName(const APPROACH_STATE state) {
+    switch (state) {
+        case APPROACH_INIT:
+            return "init";
+        case APPROACH_PREFLIGHT:
+            return "preflight";
+        case APPROACH_IN_FLIGHT:
+            return "in-flight";
+        case APPROACH_FINAL:
+            return "final";
+        case APPROACH_ENDING:
+            return "ending";
+    }
+    return "?";
+}
+
+struct InputLog {
+    uint8_t tick_ms = 0;
+    uint16_t first_tick = 0;
+    bool has_start = false;  // Version 4 on, the game before the first frame
+    LanderSnapshot start = {};
+    std::vector<InputFrame> frames;
+};
+
+bool loadLog(const char* path, InputLog& log) {
+    FILE* file = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        return false;
+    }
+
+    uint8_t header[LanderInputRecord::HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+        header[0] != LanderInputRecord::MAGIC_0 ||
+        header[1] != LanderInputRecord::MAGIC_1) {
+        fprintf(stderr, "%s: not an input log\n", path);
+        return false;
+    }
+
+    // Older versions are the same records without taps or rewinds
+    if (header[2] == 0 || header[2] > LanderInputRecord::VERSION) {
+        fprintf(stderr, "%s: log version %u, expected up to %u\n", path, header[2], LanderInputRecord::VERSION);
+        return false;
+    }
+
+    log.tick_ms = header[3];
+    log.first_tick = header[4] | (header[5] << 8);
+
+    if (header[2] >= 4) {
+        uint8_t snapshot[LanderInputRecord::SNAPSHOT_SIZE];
+        if (fread(snapshot, 1, sizeof(snapshot), file) != sizeof(snapshot)) {
+            fprintf(stderr, "%s: header cut short\n", path);
+            return false;
+        }
+        log.has_start = true;
+        log.start = LanderInputRecord::readSnapshot(snapshot);
+    }
+
+    uint8_t record[LanderInputRecord::RECORD_SIZE];
+    while (fread(record, 1, sizeof(record), file) == sizeof(record)) {
+        log.frames.push_back(LanderInputRecord::unpack(record[0] | (record[1] << 8)));
+    }
+
+    if (file != stdin) {
+        fclose(file);
+    }
+    return true;
+}
+
+bool sameState(const LanderGame& a, const LanderGame& b) {
+    return a.getApproachState() == b.getApproachState() &&
+           a.getGearState() == b.getGearState() &&
+           a.getCurrentGearBitmapIndex() == b.getCurrentGearBitmapIndex() &&
+           a.getLanderDistanceFixed() == b.getLanderDistanceFixed() &&
+           a.getLanderSpeedFixed() == b.getLanderSpeedFixed() &&
+           a.getMotherShipXOffset() == b.getMotherShipXOffset() &&
+           a.getMotherShipYOffset() == b.getMotherShipYOffset() &&
+           // The ending keeps the touchdown time and a restore moves it to
+           // now, so only the elapsed time has to match there.  Before the
+           // first thrust there is no elapsed time to keep.
+           (a.isGameOver() || a.getApproachStartTime() == b.getApproachStartTime()) &&
+           (a.getApproachStartTime() == 0 || a.getElapsedTime() == b.getElapsedTime());
+}
+
+// How one game of the log ended
+struct Landing {
+    size_t tick;
+    ENDING_OUTCOME outcome;
+    unsigned long elapsed;
+};
+
+// Run the log through a fresh game, on through every ending and restart in
+// place as Main.cpp does.  Returns the number of ticks used, or 0 when
+// check is set and a snapshot did not restore the same state.
+size_t replay(const InputLog& log, LanderGame& game, const bool trace, const bool check,
+              std::vector<Landing>* landings) {
+    unsigned long now = static_cast<unsigned long>(log.first_tick) * log.tick_ms;
+    size_t tick = 0;
+    LanderRewind rewind;
+    bool rewoundPastStart = false;
+
+    // A ring dump starts mid-game, where the device was
+    if (log.has_start) {
+        game.restore(log.start, now);
+    }
+
+    while (tick < log.frames.size()) {
+        const InputFrame& frame = log.frames[tick++];
+        now += log.tick_ms;
+        const bool wasOver = game.isGameOver();
+        if (frame.rewind) {
+            // The device's ring still held ticks from before the log
+            if (!rewind.stepBack(game, now) && log.first_tick != 0 && check && !rewoundPastStart) {
+                fprintf(stderr, "warning: tick %zu rewinds past the start of the log; "
+                                "the replay will not match the device from here\n", tick + log.first_tick);
+                rewoundPastStart = true;
+            }
+        } else {
+            game.update(frame, now);
+            if (REWIND && !wasOver) {
+                rewind.save(game);
+            }
+        }
+
+        if (!wasOver && game.isGameOver()) {
+            if (landings) {
+                landings->push_back({tick + log.first_tick, game.getOutcome(), game.getElapsedTime()});
+            }
+        } else if (wasOver && !game.isGameOver() && game.getApproachState() == APPROACH_PREFLIGHT) {
+            rewind.clear();
+        }
+
+        if (check) {
+            LanderGame clone;
+            clone.restore(game.save(), now);
+            if (!sameState(game, clone)) {
+                fprintf(stderr, "snapshot of tick %zu does not restore the same state\n", tick + log.first_tick);
+                return 0;
+            }
+        }
+
+        if (trace) {
+            printf("%6zu %-9s dist %5d spd %3d x %3d y %3d gear %d\n",
+                   tick + log.first_tick,
+                   stateName(game.getApproachState()),
+                   game.getLanderDistance(),
+                   game.getLanderSpeed(),
+                   game.getMotherShipXOffset(),
+                   game.getMotherShipYOffset(),
+                   game.getCurrentGearBitmapIndex());
+        }
+    }
+
+    return tick;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    bool trace = false;
+    long repeat = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--trace") == 0) {
+            trace = true;
+        } else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = strtol(argv[++i], nullptr, 10);
+        } else {
+            path = argv[i];
+        }
+    }
+
+    if (!path || repeat < 1) {
+        fprintf(stderr, "usage: %s <log|-> [--trace] [--repeat N]\n", argv[0]);
+        return 2;
+    }
+
+    InputLog log;
+    if (!loadLog(path, log)) {
+        return 1;
+    }
+
+    if (log.first_tick != 0 && !log.has_start) {
+        fprintf(stderr, "warning: log starts at tick %u, the start of the game was not recorded; "
+                        "the replay will not match the device\n", log.first_tick);
+    }
+
+    LanderGame game;
+    std::vector<Landing> landings;
+    const size_t ticks = replay(log, game, trace, true, &landings);
+    if (ticks == 0 && !log.frames.empty()) {
+        return 1;
+    }
+
+    printf("ticks      %zu of %zu (%u ms each)\n", ticks, log.frames.size(), log.tick_ms);
+    printf("state      %s\n", stateName(game.getApproachState()));
+    printf("distance   %d  speed %d  offset %d,%d  gear %d\n",
+           game.getLanderDistance(), game.getLanderSpeed(),
+           game.getMotherShipXOffset(), game.getMotherShipYOffset(),
+           game.getCurrentGearBitmapIndex());
+
+    // A Serial stream can hold several games, restarted in place
+    for (const Landing& landing : landings) {
+        printf("outcome    %s in %lu.%03lu s, tick %zu\n", outcomeName(landing.outcome),
+               landing.elapsed / 1000, landing.elapsed % 1000, landing.tick);
+    }
+    if (!game.isGameOver()) {
+        printf("outcome    log ended before touchdown\n");
+    }
+
+    printf("snapshot   %zu bytes, LanderGame %zu bytes here and 24 on the AVR (%.2fx)\n",
+           sizeof(LanderSnapshot), sizeof(LanderGame), 24.0 / sizeof(LanderSnapshot));
+    if (REWIND) {
+        printf("rewind     %u ticks, %zu bytes of RAM\n", LanderRewind::SLOTS, sizeof(LanderRewind));
+    }
+
+    // Time repeated replays to see how far ahead of real time the game runs
+    if (repeat > 1) {
+        const auto start = std::chrono::steady_clock::now();
+        size_t totalTicks = 0;
+
+        for (long i = 0; i < repeat; i++) {
+            LanderGame timed;
+            totalTicks += replay(log, timed, false, false, nullptr);
+        }
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double ticksPerSecond = totalTicks / seconds;
+        printf("speed      %.0f ticks/s, %.0fx real time\n",
+               ticksPerSecond, ticksPerSecond * log.tick_ms / 1000.0);
+    }
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Arduino core for the simulated Uno in host/sim (see LanderSim.h).  Unlike
+// host/include/Arduino.h this one is complete enough for the hardware
+// classes, the real Keypad library and Main.cpp: pins, time and Serial all
+// run against the simulated board and its clock.
+
+#ifndef LANDER_SIM_ARDUINO_H
+#define LANDER_SIM_ARDUINO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define DEC 10
+#define HEX 16
+
+// Uno analog pin numbers
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+
+// Flash storage is ordinary memory on the host
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(address) (*reinterpret_cast<const uint8_t*>(address))
+#define pgm_read_word(address) (*reinterpret_cast<const uint16_t*>(address))
+#define pgm_read_ptr(address) (*reinterpret_cast<const void* const*>(address))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+class __FlashStringHelper;
+#define F(string) (reinterpret_cast<const __FlashStringHelper*>(string))
+
+size_t strlcpy_P(char* destination, const char* source, size_t size);
+size_t strlcat_P(char* destination, const char* source, size_t size);
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define _BV(bit) (1 << (bit))
+
+// Time, from the simulated clock
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// Pins, from the simulated keypad matrix and levers
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+class Print {
+public:
+  virtual ~Print() = default;
+
+  virtual size_t write(uint8_t value) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size);
+  virtual int availableForWrite() { return 0; }
+
+  size_t print(const __FlashStringHelper* string);
+  size_t print(const char* string);
+  size_t print(char value);
+  size_t print(int value, int base = DEC) { return print(static_cast<long>(value), base); }
+  size_t print(unsigned int value, int base = DEC) { return print(static_cast<unsigned long>(value), base); }
+  size_t print(long value, int base = DEC);
+  size_t print(unsigned long value, int base = DEC);
+
+  size_t println();
+  template <typename T>
+  size_t println(const T& value) { return print(value) + println(); }
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+};
+
+// Serial transmit runs through a 64 byte buffer drained at the baud rate,
+// so a long print stalls loop() the way it does on the Uno
+class HardwareSerial : public Stream {
+public:
+  // Called with each byte written, for the bench to read the device's output
+  typedef void (*WriteObserver)(uint8_t value);
+
+  void begin(unsigned long baud);
+  void setWriteObserver(const WriteObserver observer) { writeObserver = observer; }
+  size_t write(uint8_t value) override;
+  using Print::write;
+  int availableForWrite() override;
+  int available() override { return 0; }
+  int read() override { return -1; }
+
+private:
+  static constexpr int TX_BUFFER_SIZE = 64;
+
+  unsigned long byteTime = 1042;  // Microseconds per byte at 9600 baud
+  unsigned long idleAt = 0;       // When the last queued byte is out
+  WriteObserver writeObserver = nullptr;
+
+  int queued();
+};
+
+extern HardwareSerial Serial;
+
+#endif // LANDER_SIM_ARDUINO_H
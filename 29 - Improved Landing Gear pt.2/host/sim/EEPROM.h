@@ -0,0 +1,37 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Simulated EEPROM of the Uno.  A write starts in the background and takes
+// WRITE_US, as on the ATmega328P, so the next write waits for it; update()
+// only writes a byte that changes.  Starts blank, all 0xFF.
+
+#ifndef LANDER_SIM_EEPROM_H
+#define LANDER_SIM_EEPROM_H
+
+#include "Arduino.h"
+
+class EEPROMClass {
+public:
+  static constexpr uint16_t SIZE = 1024;
+  static constexpr unsigned long WRITE_US = 3400;
+
+  EEPROMClass();
+
+  uint8_t read(int address);
+  void write(int address, uint8_t value);
+  void update(int address, uint8_t value);
+  uint16_t length() const { return SIZE; }
+
+  // Bench hooks
+  unsigned long getWrites() const { return writes; }
+
+private:
+  uint8_t cells[SIZE];
+  unsigned long busyUntil = 0;
+  unsigned long writes = 0;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // LANDER_SIM_EEPROM_H
@@ -0,0 +1,273 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#include "EEPROM.h"
+#include "LanderSim.h"
+
+// Static member initialization
+unsigned long LanderSim::clock = 0;
+unsigned long LanderSim::nextTimer = LanderSim::TIMER0_PERIOD_US;
+byte LanderSim::paused = 0;
+bool LanderSim::inInterrupt = false;
+void (*LanderSim::timerInterrupt)() = nullptr;
+byte LanderSim::modes[PIN_COUNT] = {};
+byte LanderSim::levels[PIN_COUNT] = {};
+LanderSim::Contact LanderSim::keys[CONTROL_ROW_COUNT][CONTROL_COLUMN_COUNT] = {};
+LanderSim::Contact LanderSim::levers[PIN_COUNT] = {};
+
+namespace {
+int rowOf(const uint8_t pin) {
+    for (byte row = 0; row < CONTROL_ROW_COUNT; row++) {
+        if (ROW_PINS[row] == pin) {
+            return row;
+        }
+    }
+    return -1;
+}
+}  // namespace
+
+void LanderSim::spend(const unsigned long us) {
+    if (paused) {
+        return;
+    }
+
+    clock += us;
+
+    // The interrupt can't interrupt itself, its own pin reads just run on
+    while (!inInterrupt && static_cast<long>(clock - nextTimer) >= 0) {
+        nextTimer += TIMER0_PERIOD_US;
+        if (timerInterrupt != nullptr) {
+            inInterrupt = true;
+            timerInterrupt();
+            inInterrupt = false;
+        }
+    }
+}
+
+void LanderSim::setKey(const byte row, const byte column, const bool closed, const unsigned long at, const unsigned long bounce_us) {
+    change(keys[row][column], closed, at, bounce_us);
+}
+
+void LanderSim::tapKey(const byte row, const byte column, const unsigned long at,
+                       const unsigned long hold_us, const unsigned long bounce_us) {
+    Contact& contact = keys[row][column];
+    change(contact, true, at, bounce_us);
+    contact.tapped = true;
+    contact.releasedAt = at + hold_us;
+}
+
+void LanderSim::setLever(const uint8_t pin, const bool on, const unsigned long at) {
+    change(levers[pin], on, at, 0);
+}
+
+void LanderSim::change(Contact& contact, const bool after, const unsigned long at, const unsigned long bounce_us) {
+    contact.before = contact.after && !contact.tapped;  // Where the last change settles
+    contact.tapped = false;
+    contact.after = after;
+    contact.changedAt = at;
+    contact.bounce = bounce_us;
+    contact.pattern = static_cast<uint32_t>(rand());
+}
+
+bool LanderSim::isClosed(const Contact& contact) {
+    if (contact.tapped && static_cast<long>(clock - contact.releasedAt) >= 0) {
+        const unsigned long since = clock - contact.releasedAt;
+        return since < contact.bounce && ((contact.pattern >> (since / BOUNCE_STEP_US % 32)) & 1);
+    }
+    if (static_cast<long>(clock - contact.changedAt) < 0) {
+        return contact.before;
+    }
+    const unsigned long since = clock - contact.changedAt;
+    if (since >= contact.bounce) {
+        return contact.after;
+    }
+    // Chatter between open and closed until the bounce time is up
+    return (contact.pattern >> (since / BOUNCE_STEP_US % 32)) & 1;
+}
+
+void LanderSim::setPinMode(const uint8_t pin, const uint8_t mode) {
+    spend(DIGITAL_IO_US);
+    modes[pin] = mode;
+}
+
+void LanderSim::writePin(const uint8_t pin, const uint8_t value) {
+    spend(DIGITAL_IO_US);
+    levels[pin] = value;
+}
+
+int LanderSim::readPin(const uint8_t pin) {
+    spend(DIGITAL_IO_US);
+
+    const int row = rowOf(pin);
+    if (row < 0) {
+        return isClosed(levers[pin]) ? HIGH : LOW;  // Levers read HIGH when on
+    }
+
+    // A closed key pulls its row down when its column is driven LOW
+    for (byte column = 0; column < CONTROL_COLUMN_COUNT; column++) {
+        const byte columnPin = COLUMN_PINS[column];
+        if (modes[columnPin] == OUTPUT && levels[columnPin] == LOW && isClosed(keys[row][column])) {
+            return LOW;
+        }
+    }
+    return modes[pin] == INPUT_PULLUP ? HIGH : levels[pin];
+}
+
+// Arduino core
+unsigned long millis() {
+    LanderSim::spend(LanderSim::CLOCK_READ_US);
+    return LanderSim::now() / 1000;
+}
+
+unsigned long micros() {
+    LanderSim::spend(LanderSim::CLOCK_READ_US);
+    return LanderSim::now();
+}
+
+void delay(const unsigned long ms) {
+    LanderSim::spend(ms * 1000);
+}
+
+void delayMicroseconds(const unsigned int us) {
+    LanderSim::spend(us);
+}
+
+void pinMode(const uint8_t pin, const uint8_t mode) {
+    LanderSim::setPinMode(pin, mode);
+}
+
+void digitalWrite(const uint8_t pin, const uint8_t value) {
+    LanderSim::writePin(pin, value);
+}
+
+int digitalRead(const uint8_t pin) {
+    return LanderSim::readPin(pin);
+}
+
+int analogRead(const uint8_t) {
+    LanderSim::spend(LanderSim::ANALOG_READ_US);
+    return rand() & 0x3FF;
+}
+
+size_t strlcpy_P(char* destination, const char* source, const size_t size) {
+    const size_t length = strlen(source);
+    if (size > 0) {
+        const size_t copied = length < size - 1 ? length : size - 1;
+        memcpy(destination, source, copied);
+        destination[copied] = '\0';
+    }
+    return length;
+}
+
+size_t strlcat_P(char* destination, const char* source, const size_t size) {
+    const size_t used = strnlen(destination, size);
+    return used + strlcpy_P(destination + used, source, size - used);
+}
+
+// Print
+size_t Print::write(const uint8_t* buffer, const size_t size) {
+    size_t written = 0;
+    for (size_t i = 0; i < size; i++) {
+        written += write(buffer[i]);
+    }
+    return written;
+}
+
+size_t Print::print(const __FlashStringHelper* string) {
+    return print(reinterpret_cast<const char*>(string));
+}
+
+size_t Print::print(const char* string) {
+    return write(reinterpret_cast<const uint8_t*>(string), strlen(string));
+}
+
+size_t Print::print(const char value) {
+    return write(static_cast<uint8_t>(value));
+}
+
+size_t Print::print(const long value, const int base) {
+    if (value < 0 && base == DEC) {
+        return print('-') + print(0UL - static_cast<unsigned long>(value), base);
+    }
+    return print(static_cast<unsigned long>(value), base);
+}
+
+size_t Print::print(unsigned long value, const int base) {
+    char digits[sizeof(value) * 8];
+    byte count = 0;
+    do {
+        const byte digit = value % base;
+        digits[count++] = static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= base;
+    } while (value != 0);
+
+    size_t written = 0;
+    while (count > 0) {
+        written += print(digits[--count]);
+    }
+    return written;
+}
+
+size_t Print::println() {
+    return print('\r') + print('\n');
+}
+
+// Serial, 10 bits a byte
+HardwareSerial Serial;
+
+void HardwareSerial::begin(const unsigned long baud) {
+    byteTime = 10000000UL / baud;
+    idleAt = LanderSim::now();
+}
+
+int HardwareSerial::queued() {
+    const long pending = static_cast<long>(idleAt - LanderSim::now());
+    return pending <= 0 ? 0 : static_cast<int>((pending + byteTime - 1) / byteTime);
+}
+
+int HardwareSerial::availableForWrite() {
+    return TX_BUFFER_SIZE - queued();
+}
+
+size_t HardwareSerial::write(const uint8_t value) {
+    // A full buffer blocks until the interrupt has sent a byte
+    while (queued() >= TX_BUFFER_SIZE && !LanderSim::isPaused()) {
+        LanderSim::spend(idleAt - LanderSim::now() - (TX_BUFFER_SIZE - 1) * byteTime);
+    }
+
+    const unsigned long now = LanderSim::now();
+    idleAt = (static_cast<long>(idleAt - now) > 0 ? idleAt : now) + byteTime;
+    if (writeObserver != nullptr) {
+        writeObserver(value);
+    }
+    return 1;
+}
+
+// EEPROM, reads and writes both wait for the write in progress
+EEPROMClass EEPROM;
+
+EEPROMClass::EEPROMClass() {
+    memset(cells, 0xFF, sizeof(cells));
+}
+
+uint8_t EEPROMClass::read(const int address) {
+    const long pending = static_cast<long>(busyUntil - LanderSim::now());
+    if (pending > 0) {
+        LanderSim::spend(pending);
+    }
+    return cells[address % SIZE];
+}
+
+void EEPROMClass::write(const int address, const uint8_t value) {
+    read(address);
+    cells[address % SIZE] = value;
+    busyUntil = LanderSim::now() + WRITE_US;
+    writes++;
+}
+
+void EEPROMClass::update(const int address, const uint8_t value) {
+    if (read(address) != value) {
+        write(address, value);
+    }
+}
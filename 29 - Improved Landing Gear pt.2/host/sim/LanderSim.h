@@ -0,0 +1,88 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_SIM_H
+#define LANDER_SIM_H
+
+#include "Arduino.h"
+#include "LanderConfig.h"
+
+// Simulated Uno for host/latency_bench.cpp.  Time only moves when the code
+// does something that takes time on the real board: a pin access, an I2C
+// or TM1637 byte, a Serial byte that has to wait for room, or delay().
+// The costs are estimates for a 16 MHz Uno with the libraries' default
+// settings; calibrate the OLED ones against bench/oled_bench.cpp.
+//
+// The keypad is an electrical model of the matrix.  A row reads LOW when
+// a closed key joins it to a column driven LOW, so the real Keypad scan
+// runs unchanged.  Contacts can bounce for a while after each change.
+// Builds define LANDER_SIM, so LanderHardware leaves keypad sampling to the
+// emulated Timer0 interrupt as on the Uno.
+class LanderSim {
+public:
+  // Cost of the core calls, microseconds
+  static constexpr unsigned long DIGITAL_IO_US = 4;    // digitalRead(), digitalWrite(), pinMode()
+  static constexpr unsigned long ANALOG_READ_US = 112;
+  static constexpr unsigned long CLOCK_READ_US = 4;    // millis(), micros()
+
+  // Timer0 compare A fires every 1.024 ms, as on the Uno
+  static constexpr unsigned long TIMER0_PERIOD_US = 1024;
+
+  static unsigned long now() { return clock; }
+
+  // Let time pass, running the timer interrupt as it comes due
+  static void spend(unsigned long us);
+
+  // No time passes and no interrupts run until resume(), for the bench's
+  // own rendering of reference frames
+  static void pause() { paused++; }
+  static void resume() { paused--; }
+  static bool isPaused() { return paused != 0; }
+
+  static void setTimerInterrupt(void (*handler)()) { timerInterrupt = handler; }
+
+  // Close or open a key of the matrix at the given time, chattering for
+  // bounce_us after it.  Changes are set up ahead so they land at an exact
+  // time, not between two loop() calls.
+  static void setKey(byte row, byte column, bool closed, unsigned long at, unsigned long bounce_us);
+  // Close a key at the given time and open it again hold_us later, for taps
+  // too short to set the two changes from between loop() calls
+  static void tapKey(byte row, byte column, unsigned long at, unsigned long hold_us, unsigned long bounce_us);
+  static void setLever(uint8_t pin, bool on, unsigned long at);
+
+  static void setPinMode(uint8_t pin, uint8_t mode);
+  static void writePin(uint8_t pin, uint8_t value);
+  static int readPin(uint8_t pin);
+
+private:
+  static constexpr byte PIN_COUNT = 20;
+  static constexpr unsigned long BOUNCE_STEP_US = 150;  // Contact chatter period
+
+  // A key contact or lever, switching from before to after at changedAt
+  struct Contact {
+    bool before;
+    bool after;
+    unsigned long changedAt;
+    unsigned long bounce;
+    uint32_t pattern;  // Which chatter steps read as closed
+    bool tapped;       // Opens again at releasedAt, bouncing the same way
+    unsigned long releasedAt;
+  };
+
+  static unsigned long clock;
+  static unsigned long nextTimer;
+  static byte paused;
+  static bool inInterrupt;
+  static void (*timerInterrupt)();
+
+  static byte modes[PIN_COUNT];
+  static byte levels[PIN_COUNT];
+  static Contact keys[CONTROL_ROW_COUNT][CONTROL_COLUMN_COUNT];
+  static Contact levers[PIN_COUNT];
+
+  static void change(Contact& contact, bool after, unsigned long at, unsigned long bounce_us);
+  static bool isClosed(const Contact& contact);
+};
+
+#endif // LANDER_SIM_H
@@ -0,0 +1,307 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#include "U8g2lib.h"
+#include "TM1637Display.h"
+#include "LanderSim.h"
+
+const u8g2_cb_t* U8G2_R0 = nullptr;
+const uint8_t u8g2_font_6x10_tr[] = {0};
+
+// OLED
+void U8G2::begin() {
+    memset(buffer, 0, sizeof(buffer));
+    memset(panel, 0, sizeof(panel));
+}
+
+void U8G2::firstPage() {
+    firstRow = 0;
+    memset(buffer, 0, tileRows * WIDTH);
+    LanderSim::spend(tileRows * WIDTH / 16);
+}
+
+uint8_t U8G2::nextPage() {
+    charge();
+    sendPages(firstRow, tileRows);
+
+    firstRow += tileRows;
+    if (firstRow >= PAGES) {
+        firstRow = 0;
+        return 0;
+    }
+
+    memset(buffer[firstRow], 0, tileRows * WIDTH);
+    LanderSim::spend(tileRows * WIDTH / 16);
+    return 1;
+}
+
+void U8G2::clearBuffer() {
+    firstRow = 0;
+    memset(buffer, 0, sizeof(buffer));
+    LanderSim::spend(sizeof(buffer) / 16);
+}
+
+void U8G2::sendBuffer() {
+    charge();
+    sendPages(0, PAGES);
+}
+
+u8g2_uint_t U8G2::drawStr(const u8g2_uint_t x, const u8g2_uint_t y, const char* text) {
+    LanderSim::spend(DRAW_CALL_US);
+
+    // Glyphs 5 wide and 7 high in a 6x10 cell, bits made up from the character
+    int left = x;
+    for (const char* c = text; *c != '\0'; c++, left += 6) {
+        if (*c == ' ') {
+            continue;
+        }
+        uint32_t bits = static_cast<uint8_t>(*c) * 2654435761UL;
+        bits ^= bits >> 13;
+        for (int column = 0; column < 5; column++) {
+            for (int row = 0; row < 7; row++) {
+                if ((bits >> ((column * 7 + row) % 32)) & 1 || row == 6) {
+                    setPixel(left + column, y + 1 + row);
+                }
+            }
+        }
+    }
+
+    charge();
+    return getStrWidth(text);
+}
+
+void U8G2::drawPixel(const u8g2_uint_t x, const u8g2_uint_t y) {
+    LanderSim::spend(DRAW_CALL_US);
+    setPixel(x, y);
+}
+
+void U8G2::drawCircle(const u8g2_uint_t x0, const u8g2_uint_t y0, const u8g2_uint_t radius) {
+    LanderSim::spend(DRAW_CALL_US);
+
+    // Midpoint circle, all eight octants, as u8g2_DrawCircle()
+    int f = 1 - radius;
+    int ddF_x = 1;
+    int ddF_y = -2 * radius;
+    int x = 0;
+    int y = radius;
+
+    const auto section = [&] {
+        setPixel(x0 + x, y0 - y);
+        setPixel(x0 + y, y0 - x);
+        setPixel(x0 - x, y0 - y);
+        setPixel(x0 - y, y0 - x);
+        setPixel(x0 + x, y0 + y);
+        setPixel(x0 + y, y0 + x);
+        setPixel(x0 - x, y0 + y);
+        setPixel(x0 - y, y0 + x);
+    };
+
+    section();
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        section();
+    }
+
+    charge();
+}
+
+void U8G2::drawFrame(const u8g2_uint_t x, const u8g2_uint_t y, const u8g2_uint_t width, const u8g2_uint_t height) {
+    LanderSim::spend(DRAW_CALL_US);
+
+    for (int i = 0; i < width; i++) {
+        setPixel(x + i, y);
+        setPixel(x + i, y + height - 1);
+    }
+    for (int j = 0; j < height; j++) {
+        setPixel(x, y + j);
+        setPixel(x + width - 1, y + j);
+    }
+
+    charge();
+}
+
+void U8G2::drawXBMP(
+    const u8g2_uint_t x, const u8g2_uint_t y,
+    const u8g2_uint_t width, const u8g2_uint_t height,
+    const uint8_t* bitmap
+) {
+    LanderSim::spend(DRAW_CALL_US);
+
+    // XBM rows are whole bytes, least significant bit leftmost.  Mode 0
+    // draws the 0 bits in the background colour too.
+    const int rowBytes = (width + 7) / 8;
+    for (int j = 0; j < height; j++) {
+        for (int i = 0; i < width; i++) {
+            const bool set = (pgm_read_byte(bitmap + j * rowBytes + i / 8) >> (i % 8)) & 1;
+            if (set) {
+                setPixel(x + i, y + j);
+            } else if (bitmapMode == 0 && isDrawn(x + i, y + j)) {
+                buffer[(y + j) / 8][x + i] &= ~(1 << ((y + j) % 8));
+            }
+        }
+    }
+
+    charge();
+}
+
+void U8G2::capture(byte (&image)[PAGES][WIDTH], const std::function<void()>& draw) {
+    LanderSim::pause();
+
+    byte saved[PAGES][WIDTH];
+    memcpy(saved, buffer, sizeof(buffer));
+    const byte savedFirstRow = firstRow;
+    const byte savedTileRows = tileRows;
+    const byte savedBitmapMode = bitmapMode;
+    byte savedClip[4];
+    memcpy(savedClip, clip, sizeof(clip));
+
+    firstRow = 0;
+    tileRows = PAGES;
+    memset(buffer, 0, sizeof(buffer));
+    draw();
+    memcpy(image, buffer, sizeof(buffer));
+
+    memcpy(buffer, saved, sizeof(buffer));
+    firstRow = savedFirstRow;
+    tileRows = savedTileRows;
+    bitmapMode = savedBitmapMode;
+    memcpy(clip, savedClip, sizeof(clip));
+    pixels = 0;
+
+    LanderSim::resume();
+}
+
+bool U8G2::isDrawn(const int x, const int y) const {
+    if (x < clip[0] || x >= clip[2] || y < clip[1] || y >= clip[3]) {
+        return false;
+    }
+    const int page = y / 8;
+    return page >= firstRow && page < firstRow + tileRows;
+}
+
+void U8G2::setPixel(const int x, const int y) {
+    if (!isDrawn(x, y)) {
+        return;
+    }
+    buffer[y / 8][x] |= 1 << (y % 8);
+    pixels++;
+}
+
+void U8G2::charge() {
+    LanderSim::spend(pixels / DRAW_PIXELS_PER_US);
+    pixels = 0;
+}
+
+void U8G2::sendPages(const byte first, const byte count) {
+    for (byte page = first; page < first + count; page++) {
+        // Page and column address commands
+        LanderSim::spend(I2C_TRANSACTION_US + 4 * I2C_BYTE_US);
+
+        for (byte column = 0; column < WIDTH; column++) {
+            if (column % I2C_CHUNK == 0) {
+                LanderSim::spend(I2C_TRANSACTION_US + 2 * I2C_BYTE_US);
+            }
+            LanderSim::spend(I2C_BYTE_US);
+
+            const byte previous = panel[page][column];
+            panel[page][column] = buffer[page][column];
+            if (byteObserver) {
+                byteObserver(LanderSim::now(), page, column, previous, buffer[page][column]);
+            }
+        }
+    }
+}
+
+// 7-segment display
+namespace {
+constexpr uint8_t DIGIT_SEGMENTS[] = {
+    0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F,
+};
+constexpr uint8_t MINUS_SEGMENTS = 0x40;
+}  // namespace
+
+TM1637Display::TM1637Display(uint8_t, uint8_t, const unsigned int bit_delay) : bitDelay(bit_delay) {}
+
+void TM1637Display::setBrightness(const uint8_t level, const bool on) {
+    brightness = (level & 0x07) | (on ? 0x08 : 0x00);
+}
+
+uint8_t TM1637Display::encodeDigit(const uint8_t digit) {
+    return DIGIT_SEGMENTS[digit & 0x0F];
+}
+
+void TM1637Display::setSegments(const uint8_t segments[], const uint8_t length, const uint8_t position) {
+    // Data command, then the address and the digits, then the display control
+    start();
+    writeByte(0x40);
+    stop();
+
+    start();
+    writeByte(0xC0 + position);
+    for (uint8_t i = 0; i < length; i++) {
+        writeByte(segments[i]);
+
+        const byte digit = position + i;
+        const byte previous = shown[digit];
+        shown[digit] = segments[i];
+        if (digitObserver) {
+            digitObserver(LanderSim::now(), digit, previous, segments[i]);
+        }
+    }
+    stop();
+
+    start();
+    writeByte(0x80 + brightness);
+    stop();
+}
+
+void TM1637Display::clear() {
+    const uint8_t blank[DIGITS] = {};
+    setSegments(blank);
+}
+
+void TM1637Display::showNumberDec(const int number, const bool leading_zero, const uint8_t length, const uint8_t position) {
+    uint8_t digits[DIGITS] = {};
+    unsigned int magnitude = number < 0 ? -number : number;
+
+    if (magnitude == 0 && !leading_zero) {
+        digits[length - 1] = encodeDigit(0);
+    } else {
+        for (int i = length - 1; i >= 0; i--) {
+            if (magnitude == 0 && !leading_zero) {
+                if (number < 0) {
+                    digits[i] = MINUS_SEGMENTS;
+                }
+                break;
+            }
+            digits[i] = encodeDigit(magnitude % 10);
+            magnitude /= 10;
+        }
+    }
+
+    setSegments(digits, length, position);
+}
+
+void TM1637Display::start() {
+    LanderSim::spend(LanderSim::DIGITAL_IO_US);
+    delayMicroseconds(bitDelay);
+}
+
+void TM1637Display::stop() {
+    delayMicroseconds(3 * bitDelay);
+    LanderSim::spend(3 * LanderSim::DIGITAL_IO_US);
+}
+
+void TM1637Display::writeByte(uint8_t) {
+    // Three bit delays and three pin changes per bit, then the ack
+    delayMicroseconds(8 * 3 * bitDelay + 4 * bitDelay);
+    LanderSim::spend((8 * 3 + 6) * LanderSim::DIGITAL_IO_US);
+}
@@ -0,0 +1,46 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Simulated TM1637 4-digit display.  Every byte is bit-banged as the real
+// library does, 8 data clocks and an ack each two bit delays long, and the
+// segments of a digit change when its byte is through.
+
+#ifndef LANDER_SIM_TM1637_DISPLAY_H
+#define LANDER_SIM_TM1637_DISPLAY_H
+
+#include <functional>
+#include "Arduino.h"
+
+class TM1637Display {
+public:
+  static constexpr byte DIGITS = 4;
+
+  // Called as each digit's segments arrive, with the time it finished
+  typedef std::function<void(unsigned long time, byte position, byte previous, byte segments)> DigitObserver;
+
+  TM1637Display(uint8_t clock_pin, uint8_t data_pin, unsigned int bit_delay = 100);
+
+  void setBrightness(uint8_t brightness, bool on = true);
+  void setSegments(const uint8_t segments[], uint8_t length = DIGITS, uint8_t position = 0);
+  void clear();
+  void showNumberDec(int number, bool leading_zero = false, uint8_t length = DIGITS, uint8_t position = 0);
+
+  static uint8_t encodeDigit(uint8_t digit);
+
+  // Bench hooks
+  void setDigitObserver(const DigitObserver& observer) { digitObserver = observer; }
+  byte getSegments(const byte position) const { return shown[position]; }
+
+private:
+  unsigned int bitDelay;
+  uint8_t brightness = 0x0F;
+  byte shown[DIGITS] = {};
+  DigitObserver digitObserver;
+
+  void start();
+  void stop();
+  void writeByte(uint8_t value);
+};
+
+#endif // LANDER_SIM_TM1637_DISPLAY_H
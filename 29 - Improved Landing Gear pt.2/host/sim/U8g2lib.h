@@ -0,0 +1,110 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Simulated SH1106 OLED behind the U8g2 calls LanderDisplay makes.  Pixels
+// are drawn into the page buffer as U8g2 would, then each finished page
+// goes out as timed I2C bytes into a model of the panel's RAM.  Text uses
+// a made-up 6x10 font: the glyphs are wrong but cover the same cells, so
+// the same bytes change as on the real display.
+
+#ifndef LANDER_SIM_U8G2LIB_H
+#define LANDER_SIM_U8G2LIB_H
+
+#include <functional>
+#include "Arduino.h"
+
+typedef uint8_t u8g2_uint_t;
+struct u8g2_cb_t {};
+extern const u8g2_cb_t* U8G2_R0;
+extern const uint8_t u8g2_font_6x10_tr[];
+
+#define U8X8_PIN_NONE 255
+
+class U8G2 : public Print {
+public:
+  static constexpr byte WIDTH = 128;
+  static constexpr byte HEIGHT = 64;
+  static constexpr byte PAGES = HEIGHT / 8;
+
+  // I2C costs at the SH1106's 400 kHz: 9 clocks a byte, a transaction per
+  // Wire buffer with its address and control bytes and start/stop, and a
+  // per-pixel and per-call cost for drawing
+  static constexpr unsigned long I2C_BYTE_US = 23;
+  static constexpr unsigned long I2C_TRANSACTION_US = 60;
+  static constexpr byte I2C_CHUNK = 30;  // Data bytes per Wire transaction
+  static constexpr unsigned long DRAW_CALL_US = 40;
+  static constexpr unsigned long DRAW_PIXELS_PER_US = 2;
+
+  // Called as each display RAM byte arrives, with the time it finished
+  typedef std::function<void(unsigned long time, byte page, byte column, byte previous, byte value)> ByteObserver;
+
+  explicit U8G2(byte tile_rows) : tileRows(tile_rows) {}
+
+  void begin();
+  void setFont(const uint8_t*) {}
+  void setFontRefHeightText() {}
+  void setFontPosTop() {}
+  void setBitmapMode(const uint8_t mode) { bitmapMode = mode; }
+
+  // Only pixels with x0 <= x < x1 and y0 <= y < y1 are drawn
+  void setClipWindow(const u8g2_uint_t x0, const u8g2_uint_t y0, const u8g2_uint_t x1, const u8g2_uint_t y1) {
+    clip[0] = x0;
+    clip[1] = y0;
+    clip[2] = x1;
+    clip[3] = y1;
+  }
+  void setMaxClipWindow() { setClipWindow(0, 0, WIDTH, HEIGHT); }
+
+  void firstPage();
+  uint8_t nextPage();
+  void clearBuffer();
+  void sendBuffer();
+
+  u8g2_uint_t getDisplayWidth() const { return WIDTH; }
+  u8g2_uint_t getDisplayHeight() const { return HEIGHT; }
+  int8_t getMaxCharHeight() const { return 10; }
+  u8g2_uint_t getStrWidth(const char* text) const { return static_cast<u8g2_uint_t>(6 * strlen(text)); }
+
+  u8g2_uint_t drawStr(u8g2_uint_t x, u8g2_uint_t y, const char* text);
+  void drawPixel(u8g2_uint_t x, u8g2_uint_t y);
+  void drawCircle(u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t radius);
+  void drawFrame(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t width, u8g2_uint_t height);
+  void drawXBMP(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t width, u8g2_uint_t height, const uint8_t* bitmap);
+
+  size_t write(uint8_t) override { return 1; }
+
+  // Bench hooks.  capture() runs draw over the whole frame into image
+  // without sending anything or taking any time.
+  void setByteObserver(const ByteObserver& observer) { byteObserver = observer; }
+  void capture(byte (&image)[PAGES][WIDTH], const std::function<void()>& draw);
+  byte panelByte(const byte page, const byte column) const { return panel[page][column]; }
+
+private:
+  byte tileRows;         // Pages held by the buffer
+  byte firstRow = 0;     // First page in the buffer on this pass
+  byte buffer[PAGES][WIDTH] = {};
+  byte panel[PAGES][WIDTH] = {};
+  byte bitmapMode = 0;
+  byte clip[4] = {0, 0, WIDTH, HEIGHT};
+  unsigned long pixels = 0;  // Drawn since the last charge
+  ByteObserver byteObserver;
+
+  bool isDrawn(int x, int y) const;  // Inside the clip window and this pass's pages
+  void setPixel(int x, int y);
+  void charge();
+  void sendPages(byte first, byte count);
+};
+
+template <byte TILE_ROWS>
+class LanderSimU8g2 : public U8G2 {
+public:
+  explicit LanderSimU8g2(const u8g2_cb_t*, uint8_t = U8X8_PIN_NONE, uint8_t = U8X8_PIN_NONE, uint8_t = U8X8_PIN_NONE) :
+      U8G2(TILE_ROWS) {}
+};
+
+typedef LanderSimU8g2<1> U8G2_SH1106_128X64_NONAME_1_HW_I2C;
+typedef LanderSimU8g2<2> U8G2_SH1106_128X64_NONAME_2_HW_I2C;
+typedef LanderSimU8g2<8> U8G2_SH1106_128X64_NONAME_F_HW_I2C;
+
+#endif // LANDER_SIM_U8G2LIB_H
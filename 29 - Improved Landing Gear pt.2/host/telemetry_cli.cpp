@@ -0,0 +1,165 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Decodes the LanderTelemetry stream to CSV as it arrives.
+//
+//   pio run -e telemetry && .pio/build/telemetry/program /dev/ttyACM0 > flight.csv
+//
+// The source is a serial port, which is set to raw SERIAL_BAUD, or a
+// capture file, or - for stdin.  Every frame is written and flushed as soon
+// as its delimiter comes in.  Bytes before the first delimiter are skipped,
+// since the port may open in the middle of a frame.  Frames that fail COBS
+// or the CRC, and gaps in the tick count, are reported on stderr along with
+// a summary at the end.
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "LanderTelemetryRecord.h"
+
+namespace {
+
+// Longest frame that could be valid, anything longer is noise
+constexpr size_t MAX_FRAME = 255;
+
+const char* stateName(const APPROACH_STATE state) {
+    switch (state) {
+        case APPROACH_INIT:
+            return "init";
+        case APPROACH_PREFLIGHT:
+            return "preflight";
+        case APPROACH_IN_FLIGHT:
+            return "in_flight";
+        case APPROACH_FINAL:
+            return "final";
+        case APPROACH_ENDING:
+            return "ending";
+        default:
+            return "?";
+    }
+}
+
+struct Stats {
+    unsigned long frames = 0;
+    unsigned long bad = 0;
+    unsigned long lost = 0;
+    bool have_tick = false;
+    uint16_t last_tick = 0;
+};
+
+// Raw 8N1 at the device baud rate, reads returning whatever has arrived
+bool configurePort(const int fd) {
+    termios tty;
+    if (tcgetattr(fd, &tty) != 0) {
+        return false;
+    }
+    cfmakeraw(&tty);
+    cfsetispeed(&tty, B115200);
+    cfsetospeed(&tty, B115200);
+    tty.c_cflag |= CLOCAL | CREAD;
+    tty.c_cc[VMIN] = 1;
+    tty.c_cc[VTIME] = 0;
+    return tcsetattr(fd, TCSANOW, &tty) == 0;
+}
+
+void handleFrame(const uint8_t* frame, const size_t length, const unsigned long offset, Stats& stats) {
+    uint8_t payload[MAX_FRAME];
+    const size_t decoded = length == 0 || length > MAX_FRAME ? 0 : LanderTelemetryRecord::decode(frame, length, payload);
+
+    if (decoded != LanderTelemetryRecord::PAYLOAD_SIZE ||
+        LanderTelemetryRecord::crc8(payload, LanderTelemetryRecord::RECORD_SIZE) != payload[LanderTelemetryRecord::RECORD_SIZE]) {
+        fprintf(stderr, "bad frame ending at byte %lu\n", offset);
+        stats.bad++;
+        return;
+    }
+
+    const TelemetryFrame record = LanderTelemetryRecord::unpack(payload);
+
+    if (stats.have_tick) {
+        const uint16_t gap = record.tick - stats.last_tick - 1;
+        if (gap != 0) {
+            fprintf(stderr, "lost %u frame(s) before tick %u\n", gap, record.tick);
+            stats.lost += gap;
+        }
+    }
+    stats.have_tick = true;
+    stats.last_tick = record.tick;
+    stats.frames++;
+
+    printf("%u,%s,%.4f,%.4f,%d,%d,%u,%u\n",
+           record.tick, stateName(record.approach_state),
+           record.distance_raw / 16.0, record.speed_raw / 256.0,
+           record.x_offset, record.y_offset, record.gear_index, record.tick_us);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <port|capture|->\n", argv[0]);
+        return 2;
+    }
+
+    const char* path = argv[1];
+    const int fd = strcmp(path, "-") == 0 ? STDIN_FILENO : open(path, O_RDONLY | O_NOCTTY);
+    if (fd < 0) {
+        perror(path);
+        return 1;
+    }
+    if (isatty(fd) && !configurePort(fd)) {
+        perror(path);
+        return 1;
+    }
+
+    printf("tick,state,distance,speed,x_offset,y_offset,gear,tick_us\n");
+    fflush(stdout);
+
+    Stats stats;
+    uint8_t frame[MAX_FRAME + 1];
+    size_t length = 0;
+    bool synced = false;
+    unsigned long offset = 0;
+    uint8_t chunk[256];
+
+    for (;;) {
+        const ssize_t count = read(fd, chunk, sizeof(chunk));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            break;
+        }
+
+        for (ssize_t i = 0; i < count; i++) {
+            const uint8_t byte = chunk[i];
+            offset++;
+
+            if (byte != 0) {
+                // Past MAX_FRAME the frame is garbage anyway, keep the count only
+                if (length < sizeof(frame)) {
+                    frame[length] = byte;
+                }
+                length++;
+                continue;
+            }
+
+            if (synced) {
+                handleFrame(frame, length, offset, stats);
+            }
+            synced = true;
+            length = 0;
+        }
+
+        // One flush per read keeps a live plot current without a write per byte
+        fflush(stdout);
+    }
+
+    fprintf(stderr, "%lu frames, %lu bad, %lu lost\n", stats.frames, stats.bad, stats.lost);
+    return stats.bad == 0 ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_AUTOPILOT_H
+#define LANDER_AUTOPILOT_H
+
+#include "Arduino.h"
+#include "LanderConfig.h"
+#include "LanderTypes.h"
+
+class LanderGame;
+
+// Flies the lander from the policy solved offline by host/policy_solver.cpp
+// and stored in LanderAutopilotPolicy.h.
+//
+// The game state is cut into cells of phase, speed and stopping margin, and
+// each cell points at a pattern giving the action for every pair of folded
+// x/y offset classes.  Cells run-length encode the pattern numbers, patterns
+// are shared between cells and are themselves lists of shared rows of y
+// actions, which keeps the table to a few KB of PROGMEM.  The solver
+// quantizes with the same functions, so keep them here.
+class LanderAutopilot {
+public:
+  // Actions stored in the table.  Steering is relative to the folded
+  // offsets: +1 moves the offset away from center, -1 towards it.
+  enum ACTION {
+    ACTION_NONE,
+    ACTION_RAISE_SPEED,
+    ACTION_LOWER_SPEED,
+    ACTION_LOWER_GEAR,
+    ACTION_STEER_FIRST,  // 8 steering actions follow, see steerAction()
+    ACTION_COUNT = ACTION_STEER_FIRST + 8
+  };
+
+  // Gear phase: the gear index plus whether it can be lowered yet
+  enum GEAR_PHASE {
+    GEAR_PHASE_UP,        // Gear up, not on final approach
+    GEAR_PHASE_UP_FINAL,  // Gear up, on final so it can be lowered
+    GEAR_PHASE_LOWERING_1,
+    GEAR_PHASE_LOWERING_2,
+    GEAR_PHASE_DOWN,
+    GEAR_PHASE_COUNT
+  };
+
+  static constexpr byte MARGIN_BUCKETS = 109;
+  static constexpr byte SPEED_CLASSES = 41;
+  static constexpr byte OFFSET_CLASSES = 8;
+  static constexpr byte PATTERN_SIZE = OFFSET_CLASSES * OFFSET_CLASSES;  // Actions per pattern
+  static constexpr byte ROW_BYTES = OFFSET_CLASSES / 2;
+  static constexpr uint16_t CELL_COUNT = GEAR_PHASE_COUNT * SPEED_CLASSES * MARGIN_BUCKETS;
+  static constexpr byte RUN_STRIDE = 16;  // Runs between run index entries
+
+  // Distance left over after braking one speed step per tick, which is what
+  // decides when to brake.  Exact up to 64, then steps of 8 and 64.
+  static byte marginBucket(const int distance, const int speed) {
+    const int margin = distance - speed * (speed - 1) / 2;
+    if (margin < 0) return 0;
+    if (margin < 64) return 1 + margin;                 // 1-64
+    if (margin < 256) return 65 + (margin - 64) / 8;    // 65-88
+    const int bucket = 89 + (margin - 256) / 64;        // 89-108
+    return bucket < MARGIN_BUCKETS ? bucket : MARGIN_BUCKETS - 1;
+  }
+
+  static byte speedClass(const int speed) {
+    return speed < SPEED_CLASSES ? speed : SPEED_CLASSES - 1;
+  }
+
+  // 0, 1, 2-3, 4-5, 6, 7, 8-10, 11+.  The bay edges are at 7/8 for y and
+  // 10/11 for x, so no class straddles one.
+  static byte offsetClass(int offset) {
+    if (offset < 0) offset = -offset;
+    if (offset < 2) return offset;
+    if (offset < 6) return 1 + offset / 2;
+    if (offset < 8) return offset - 2;
+    return offset < 11 ? 6 : 7;
+  }
+
+  static byte gearPhase(const int gear_index, const bool final_approach) {
+    if (gear_index == 0) return final_approach ? GEAR_PHASE_UP_FINAL : GEAR_PHASE_UP;
+    return GEAR_PHASE_UP_FINAL + gear_index;
+  }
+
+  static uint16_t cellIndex(const int distance, const int speed, const byte gear_phase) {
+    return (static_cast<uint16_t>(gear_phase) * SPEED_CLASSES + speedClass(speed)) * MARGIN_BUCKETS +
+           marginBucket(distance, speed);
+  }
+
+  static byte offsetIndex(const int x_offset, const int y_offset) {
+    return offsetClass(x_offset) * OFFSET_CLASSES + offsetClass(y_offset);
+  }
+
+  // Steering action for a move of (sx, sy) in folded coordinates, each -1, 0 or 1
+  static byte steerAction(const int sx, const int sy) {
+    const byte cell = (sx + 1) * 3 + (sy + 1);  // 0-8, 4 is no steering
+    return ACTION_STEER_FIRST + (cell < 4 ? cell : cell - 1);
+  }
+
+  // Undo the offset folding and turn a table action into a key press
+  static LANDER_CONTROLS toControl(byte action, int x_offset, int y_offset);
+
+  // Table lookup.  cells holds (pattern, cell count) byte pairs in cell
+  // order, and runStarts the first cell of every RUN_STRIDE-th of those
+  // runs so a lookup only walks a few of them.  patterns holds a row number
+  // per x offset class, and rows hold the action per y offset class, two a
+  // byte with the even one high.
+  static byte lookup(const uint8_t* cells, const uint16_t* runStarts, uint16_t runStartCount,
+                     const uint8_t* patterns, const uint8_t* rows, uint16_t cell, byte offset);
+
+  // Pick this tick's key for the game from the built-in policy table
+  static LANDER_CONTROLS choose(const LanderGame& game);
+};
+
+#endif // LANDER_AUTOPILOT_H
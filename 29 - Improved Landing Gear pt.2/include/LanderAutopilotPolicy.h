@@ -0,0 +1,321 @@
+//
+// Created by ash on 6/15/25.
+//
+
+// Generated by host/policy_solver.cpp, do not edit.
+//   --max-speed 40 --penalty 10000 --runs 200000 --seed 1
+// Flown 200000 times: 99.7040% success, mean time 7.60 s.
+// Only included by LanderAutopilot.cpp.
+
+#ifndef LANDER_AUTOPILOT_POLICY_H
+#define LANDER_AUTOPILOT_POLICY_H
+
+#include "Arduino.h"
+#include "LanderAutopilot.h"
+
+const uint8_t AUTOPILOT_CELLS[1700] PROGMEM = {
+  0, 108, 1, 255, 1, 255, 1, 255, 1, 255, 1, 255, 1, 187, 2, 15,
+  3, 1, 4, 5, 5, 1, 6, 2, 7, 37, 1, 32, 8, 15, 2, 1,
+  9, 11, 1, 1, 2, 3, 10, 6, 5, 1, 11, 1, 6, 1, 7, 5,
+  12, 2, 13, 5, 14, 24, 1, 17, 15, 8, 16, 1, 17, 2, 8, 2,
+  15, 1, 18, 4, 3, 7, 19, 5, 2, 33, 6, 29, 1, 9, 15, 17,
+  20, 4, 18, 5, 3, 5, 2, 4, 3, 3, 21, 33, 6, 28, 1, 10,
+  15, 18, 20, 1, 22, 3, 23, 1, 15, 1, 2, 2, 3, 7, 2, 2,
+  3, 3, 4, 7, 2, 26, 6, 28, 1, 10, 15, 19, 20, 2, 24, 1,
+  15, 1, 18, 1, 15, 2, 2, 4, 15, 1, 2, 4, 3, 3, 4, 7,
+  2, 26, 6, 27, 1, 11, 15, 20, 20, 1, 25, 1, 26, 1, 15, 7,
+  27, 1, 15, 2, 2, 2, 3, 3, 4, 7, 28, 26, 6, 26, 1, 12,
+  15, 21, 29, 1, 30, 1, 18, 10, 31, 2, 3, 3, 4, 7, 28, 17,
+  3, 9, 11, 26, 1, 12, 15, 22, 32, 1, 22, 1, 2, 6, 33, 1,
+  15, 2, 34, 2, 3, 3, 28, 7, 2, 2, 3, 24, 35, 5, 6, 20,
+  1, 13, 15, 23, 36, 1, 22, 6, 18, 3, 37, 5, 4, 7, 38, 26,
+  39, 24, 1, 14, 8, 1, 15, 23, 40, 1, 2, 5, 18, 3, 41, 3,
+  3, 2, 42, 7, 3, 26, 39, 24, 1, 14, 8, 1, 15, 24, 43, 1,
+  2, 4, 15, 3, 44, 2, 2, 1, 3, 2, 45, 7, 42, 17, 3, 9,
+  9, 1, 2, 4, 46, 18, 1, 15, 8, 1, 15, 25, 47, 1, 2, 3,
+  48, 3, 15, 1, 18, 4, 49, 2, 2, 22, 3, 9, 9, 5, 6, 17,
+  1, 17, 15, 27, 22, 3, 18, 2, 41, 1, 15, 3, 2, 1, 50, 2,
+  45, 1, 17, 1, 2, 3, 21, 17, 3, 9, 6, 5, 11, 16, 1, 18,
+  15, 28, 2, 1, 23, 1, 15, 3, 23, 1, 15, 3, 51, 2, 49, 1,
+  9, 1, 52, 3, 53, 7, 2, 10, 3, 9, 6, 5, 11, 15, 1, 19,
+  15, 29, 54, 1, 24, 2, 55, 4, 2, 1, 56, 2, 57, 1, 49, 1,
+  43, 1, 52, 2, 53, 7, 9, 2, 58, 1, 2, 7, 3, 9, 6, 5,
+  11, 14, 1, 20, 15, 30, 59, 2, 60, 1, 48, 4, 61, 2, 62, 2,
+  49, 1, 45, 1, 9, 1, 10, 7, 43, 1, 9, 4, 2, 5, 3, 9,
+  11, 19, 1, 20, 15, 31, 2, 1, 48, 1, 15, 4, 63, 3, 31, 1,
+  47, 1, 49, 1, 43, 1, 64, 1, 2, 5, 65, 3, 66, 1, 9, 3,
+  67, 1, 2, 3, 3, 9, 6, 1, 11, 17, 1, 21, 15, 32, 54, 1,
+  30, 4, 56, 2, 34, 1, 8, 1, 34, 1, 31, 1, 16, 1, 68, 1,
+  52, 1, 2, 4, 16, 2, 65, 1, 69, 1, 65, 1, 45, 1, 66, 1,
+  9, 3, 2, 1, 64, 3, 70, 4, 71, 2, 6, 1, 11, 5, 72, 4,
+  73, 4, 74, 1, 75, 1, 76, 1, 77, 22, 15, 33, 54, 1, 18, 3,
+  78, 2, 37, 5, 79, 1, 66, 1, 80, 1, 2, 3, 16, 3, 81, 2,
+  82, 1, 69, 2, 45, 1, 66, 1, 83, 1, 84, 1, 2, 1, 10, 4,
+  85, 1, 3, 2, 6, 1, 86, 4, 11, 4, 72, 4, 87, 1, 88, 1,
+  89, 1, 90, 23, 15, 34, 91, 3, 92, 1, 8, 2, 15, 4, 93, 1,
+  49, 1, 68, 1, 80, 1, 2, 1, 9, 1, 49, 1, 16, 1, 49, 9,
+  94, 1, 10, 5, 95, 3, 96, 5, 11, 8, 97, 1, 98, 1, 99, 24,
+  15, 35, 2, 2, 100, 2, 78, 1, 8, 6, 47, 1, 43, 3, 8, 10,
+  2, 1, 86, 1, 20, 3, 101, 1, 2, 4, 102, 4, 73, 1, 103, 4,
+  104, 4, 105, 26, 15, 36, 2, 24, 9, 1, 2, 4, 10, 5, 106, 4,
+  107, 64, 15, 31, 45, 5, 2, 255, 2, 224, 108, 109, 109, 1, 110, 1,
+  111, 1, 112, 1, 113, 1, 114, 1, 115, 2, 108, 4, 116, 97, 117, 1,
+  110, 1, 118, 1, 119, 1, 120, 1, 111, 1, 121, 2, 122, 2, 123, 1,
+  108, 1, 124, 1, 108, 1, 125, 7, 108, 88, 126, 1, 15, 1, 127, 1,
+  128, 1, 129, 1, 109, 1, 130, 2, 131, 1, 108, 1, 132, 1, 133, 1,
+  134, 1, 135, 1, 113, 1, 124, 93, 15, 2, 136, 1, 15, 1, 137, 1,
+  138, 1, 109, 1, 15, 2, 109, 3, 139, 1, 140, 1, 141, 2, 142, 1,
+  143, 1, 108, 4, 114, 87, 8, 1, 15, 2, 144, 1, 15, 1, 145, 1,
+  146, 1, 109, 4, 130, 1, 109, 1, 147, 1, 148, 1, 149, 4, 108, 3,
+  2, 87, 8, 1, 15, 3, 150, 1, 15, 1, 151, 1, 152, 1, 108, 1,
+  15, 2, 109, 1, 153, 1, 110, 1, 154, 1, 155, 1, 122, 1, 2, 5,
+  111, 12, 123, 4, 108, 72, 15, 4, 156, 1, 15, 1, 157, 1, 15, 1,
+  158, 3, 15, 1, 159, 1, 109, 1, 160, 1, 130, 22, 108, 72, 15, 5,
+  161, 2, 157, 1, 162, 1, 109, 1, 15, 1, 158, 1, 15, 1, 163, 1,
+  109, 1, 164, 2, 15, 4, 122, 2, 135, 10, 114, 4, 108, 72, 15, 8,
+  165, 1, 138, 1, 166, 1, 15, 1, 109, 1, 15, 1, 167, 1, 168, 6,
+  15, 12, 169, 5, 108, 70, 2, 1, 15, 9, 117, 1, 170, 1, 158, 1,
+  15, 1, 158, 1, 15, 1, 171, 2, 111, 4, 113, 2, 111, 10, 169, 4,
+  2, 68, 0, 3, 2, 1, 15, 10, 117, 1, 172, 1, 173, 1, 174, 1,
+  158, 1, 15, 6, 130, 2, 111, 8, 108, 2, 134, 72, 1, 3, 2, 1,
+  15, 11, 172, 1, 117, 1, 173, 1, 15, 1, 109, 6, 139, 2, 111, 10,
+  112, 72, 0, 3, 2, 1, 15, 12, 170, 1, 175, 1, 173, 1, 15, 4,
+  108, 2, 109, 1, 148, 1, 160, 10, 119, 4, 113, 1, 176, 67, 177, 3,
+  2, 1, 15, 13, 117, 1, 178, 1, 179, 6, 153, 1, 109, 1, 121, 82,
+  180, 3, 2, 1, 15, 255, 15, 255, 15, 255, 15, 255, 15, 255, 15, 255,
+  15, 255, 15, 255, 15, 255, 15, 255, 15, 255, 15, 28, 181, 1, 182, 3,
+  76, 104, 15, 1, 183, 1, 184, 1, 185, 1, 186, 2, 187, 2, 6, 2,
+  188, 1, 2, 1, 6, 96, 15, 1, 189, 1, 190, 1, 191, 1, 192, 1,
+  18, 1, 46, 1, 2, 1, 3, 3, 193, 1, 194, 1, 195, 1, 6, 7,
+  3, 87, 15, 3, 191, 1, 196, 2, 25, 2, 18, 2, 197, 1, 198, 1,
+  4, 1, 39, 1, 2, 95, 15, 7, 18, 2, 199, 2, 200, 1, 201, 2,
+  15, 1, 2, 1, 184, 4, 3, 89, 8, 2, 15, 6, 23, 2, 202, 1,
+  15, 1, 2, 97, 8, 2, 15, 8, 18, 1, 15, 7, 2, 16, 6, 75,
+  8, 2, 15, 8, 18, 101, 15, 216, 0, 2, 8, 1, 15, 13, 18, 93,
+  0, 2, 15, 255, 15, 70, 203, 2, 15, 255, 15, 255, 15, 255, 15, 255,
+  15, 255, 15, 255, 15, 255, 15, 255, 15, 255, 15, 255, 15, 255, 15, 138,
+  204, 1, 205, 2, 206, 105, 186, 1, 207, 1, 183, 1, 208, 1, 201, 1,
+  181, 2, 209, 2, 210, 2, 211, 1, 6, 1, 7, 95, 15, 2, 189, 1,
+  212, 1, 213, 1, 2, 1, 214, 2, 215, 1, 6, 1, 216, 1, 46, 1,
+  195, 2, 9, 1, 6, 94, 15, 3, 217, 3, 183, 3, 33, 1, 218, 1,
+  219, 1, 184, 2, 6, 1, 2, 1, 5, 1, 6, 92, 15, 4, 220, 3,
+  18, 1, 15, 1, 18, 1, 183, 2, 18, 97, 8, 2, 15, 6, 199, 2,
+  221, 1, 15, 1, 2, 22, 3, 75, 8, 2, 15, 7, 18, 1, 23, 99,
+  8, 2, 15, 8, 17, 6, 198, 95, 15, 107, 1, 2, 8, 1, 15, 11,
+  17, 95, 0, 2, 15, 21, 2, 88, 15, 135, 2, 81, 0, 2, 15, 255,
+  15, 255, 15, 255, 15, 255, 15, 255, 15, 255, 15, 255, 15, 255, 15, 255,
+  15, 255, 15, 255, 15, 138, 205, 109, 183, 1, 222, 1, 223, 1, 206, 1,
+  74, 1, 224, 1, 7, 1, 12, 2, 13, 99, 186, 1, 207, 1, 183, 1,
+  225, 1, 226, 1, 227, 2, 182, 1, 184, 1, 74, 99, 15, 2, 191, 1,
+  228, 1, 191, 1, 229, 1, 230, 1, 231, 1, 232, 1, 74, 1, 186, 1,
+  46, 1, 233, 1, 6, 1, 39, 1, 46, 1, 2, 1, 6, 2, 46, 90,
+  15, 3, 191, 1, 234, 1, 235, 1, 236, 3, 221, 1, 237, 1, 198, 1,
+  38, 2, 9, 1, 238, 3, 233, 1, 238, 4, 2, 1, 6, 85, 239, 2,
+  15, 2, 220, 4, 183, 1, 50, 1, 15, 1, 240, 3, 15, 1, 2, 2,
+  6, 1, 2, 2, 39, 2, 6, 2, 2, 1, 5, 2, 2, 1, 6, 2,
+  241, 79, 242, 2, 15, 3, 220, 3, 243, 2, 244, 2, 2, 2, 184, 10,
+  2, 1, 6, 7, 2, 77, 245, 2, 15, 4, 246, 3, 2, 1, 247, 4,
+  61, 2, 50, 12, 5, 1, 3, 80, 248, 2, 15, 8, 249, 4, 33, 2,
+  50, 12, 5, 1, 6, 3, 2, 77, 203, 2, 15, 11, 2, 1, 199, 14,
+  4, 81, 0, 2, 15, 10, 18, 13, 2, 3, 3, 1, 2, 80, 250, 2,
+  15, 26, 35, 81, 0, 2, 15, 26, 9, 81, 251, 2, 15, 255, 15, 255,
+  15, 255, 15, 255, 15, 255, 15, 255, 15, 255, 15, 255, 15, 255, 15, 255,
+  15, 255, 15, 245
+};
+
+const uint16_t AUTOPILOT_RUN_STARTS[54] PROGMEM = {
+  0, 1679, 1769, 1966, 2097, 2214, 2355, 2498, 2656, 2800, 2931, 3057, 3166, 3241, 3345, 3441,
+  3538, 3573, 3657, 3687, 3772, 3880, 4003, 4801, 4912, 5022, 5132, 5244, 5353, 5468, 5584, 5709,
+  5890, 6018, 6213, 9054, 9271, 9386, 9603, 10246, 13518, 13737, 13854, 14071, 14511, 17230, 18098, 18214,
+  18324, 18438, 18554, 18764, 19077, 21845
+};
+
+const uint8_t AUTOPILOT_PATTERNS[252 * LanderAutopilot::OFFSET_CLASSES] PROGMEM = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+  2, 3, 3, 3, 3, 3, 3, 4, 5, 6, 7, 3, 3, 3, 3, 3,
+  5, 7, 7, 3, 3, 3, 8, 3, 9, 10, 10, 11, 10, 3, 3, 3,
+  12, 13, 13, 13, 13, 13, 8, 3, 14, 15, 15, 15, 15, 15, 13, 8,
+  16, 17, 17, 17, 18, 18, 19, 4, 20, 21, 22, 21, 21, 21, 3, 4,
+  23, 3, 3, 3, 3, 3, 3, 3, 24, 25, 25, 8, 8, 8, 8, 3,
+  26, 27, 27, 27, 27, 27, 27, 8, 26, 26, 26, 26, 26, 26, 26, 28,
+  26, 26, 1, 26, 26, 26, 26, 27, 4, 4, 4, 4, 4, 4, 4, 4,
+  29, 30, 30, 30, 4, 4, 4, 4, 31, 32, 32, 33, 33, 33, 34, 4,
+  35, 18, 18, 18, 18, 36, 19, 37, 23, 3, 3, 3, 3, 3, 3, 4,
+  38, 39, 34, 34, 40, 4, 4, 4, 41, 42, 42, 3, 8, 3, 3, 30,
+  43, 33, 33, 33, 33, 33, 34, 4, 44, 45, 45, 45, 45, 45, 33, 4,
+  44, 45, 45, 45, 33, 33, 34, 4, 43, 33, 33, 33, 33, 33, 46, 4,
+  44, 45, 45, 45, 33, 33, 47, 4, 16, 18, 18, 17, 17, 48, 49, 4,
+  41, 42, 42, 3, 3, 3, 3, 50, 51, 34, 34, 34, 4, 4, 4, 4,
+  43, 33, 33, 33, 33, 52, 30, 4, 16, 17, 48, 48, 48, 48, 45, 30,
+  38, 39, 34, 53, 4, 4, 4, 4, 35, 18, 18, 17, 18, 36, 45, 4,
+  35, 18, 18, 48, 48, 48, 19, 4, 54, 10, 11, 11, 25, 8, 8, 8,
+  38, 39, 39, 39, 4, 4, 4, 4, 16, 18, 18, 18, 48, 48, 36, 55,
+  2, 3, 3, 3, 3, 3, 3, 39, 56, 15, 15, 15, 13, 13, 8, 3,
+  38, 39, 39, 4, 4, 4, 4, 4, 35, 18, 18, 18, 36, 36, 57, 4,
+  2, 3, 3, 3, 3, 3, 3, 53, 29, 39, 39, 4, 4, 4, 4, 4,
+  35, 18, 18, 18, 36, 36, 21, 4, 58, 21, 19, 21, 3, 3, 3, 4,
+  27, 15, 15, 15, 15, 15, 25, 8, 4, 30, 4, 4, 4, 4, 4, 4,
+  44, 45, 45, 33, 33, 33, 39, 4, 16, 48, 48, 48, 36, 48, 21, 53,
+  35, 18, 17, 36, 36, 36, 19, 4, 16, 17, 17, 48, 48, 36, 19, 4,
+  20, 3, 3, 3, 3, 3, 3, 4, 59, 48, 48, 48, 21, 21, 3, 60,
+  43, 33, 33, 33, 52, 52, 34, 4, 44, 45, 45, 33, 33, 33, 37, 4,
+  61, 62, 62, 62, 57, 57, 55, 4, 35, 18, 36, 36, 36, 36, 19, 4,
+  20, 3, 3, 21, 21, 21, 3, 4, 43, 33, 33, 33, 52, 52, 63, 4,
+  43, 33, 33, 52, 52, 34, 4, 4, 35, 17, 18, 17, 36, 36, 57, 30,
+  35, 18, 18, 36, 36, 36, 36, 4, 4, 37, 37, 62, 55, 55, 4, 4,
+  20, 3, 3, 3, 3, 3, 3, 34, 59, 48, 21, 21, 21, 21, 21, 4,
+  59, 21, 21, 21, 21, 21, 21, 4, 20, 21, 3, 21, 21, 21, 3, 4,
+  59, 21, 21, 21, 21, 3, 45, 39, 59, 48, 21, 48, 48, 21, 21, 4,
+  5, 7, 3, 3, 3, 3, 3, 3, 41, 42, 7, 3, 3, 3, 3, 3,
+  54, 11, 11, 64, 8, 8, 8, 3, 54, 11, 11, 11, 25, 8, 8, 3,
+  65, 13, 13, 13, 66, 13, 8, 28, 27, 27, 27, 27, 27, 15, 67, 28,
+  27, 27, 27, 26, 26, 26, 26, 28, 1, 1, 1, 1, 26, 1, 26, 26,
+  68, 55, 57, 55, 55, 30, 4, 4, 16, 48, 48, 48, 48, 48, 19, 39,
+  20, 21, 3, 3, 3, 3, 3, 4, 59, 48, 48, 48, 48, 21, 21, 53,
+  59, 48, 21, 21, 48, 21, 21, 4, 2, 3, 21, 3, 3, 3, 3, 30,
+  20, 21, 21, 3, 3, 3, 3, 45, 5, 3, 3, 3, 3, 3, 3, 3,
+  24, 25, 3, 3, 3, 3, 3, 3, 69, 15, 15, 13, 13, 13, 8, 8,
+  70, 66, 66, 66, 13, 71, 8, 8, 27, 27, 27, 27, 27, 27, 27, 8,
+  26, 26, 26, 26, 26, 26, 26, 27, 43, 33, 33, 52, 52, 34, 50, 4,
+  43, 33, 33, 33, 33, 63, 30, 4, 72, 18, 36, 36, 36, 36, 57, 4,
+  73, 7, 21, 21, 21, 3, 3, 45, 41, 42, 74, 3, 3, 3, 3, 3,
+  41, 25, 8, 3, 3, 3, 3, 3, 12, 13, 13, 13, 11, 11, 8, 8,
+  75, 15, 13, 13, 15, 15, 8, 8, 76, 26, 26, 26, 26, 26, 27, 8,
+  77, 52, 52, 52, 34, 34, 4, 4, 78, 79, 42, 3, 3, 3, 3, 3,
+  54, 11, 11, 42, 3, 3, 3, 3, 80, 13, 13, 8, 81, 8, 8, 3,
+  54, 11, 11, 11, 11, 11, 8, 3, 80, 13, 13, 13, 13, 13, 11, 3,
+  41, 7, 3, 3, 3, 3, 3, 3, 9, 10, 42, 3, 3, 3, 3, 3,
+  82, 82, 82, 82, 82, 82, 82, 82, 83, 83, 83, 83, 83, 83, 83, 84,
+  83, 83, 83, 83, 83, 83, 83, 4, 85, 85, 85, 85, 83, 85, 85, 86,
+  85, 85, 85, 85, 85, 85, 85, 87, 88, 88, 88, 89, 88, 88, 85, 90,
+  91, 91, 92, 91, 91, 93, 85, 85, 94, 95, 94, 95, 94, 94, 93, 85,
+  96, 96, 96, 96, 96, 96, 96, 82, 97, 97, 97, 97, 97, 97, 4, 4,
+  98, 98, 98, 98, 98, 98, 99, 4, 88, 88, 88, 88, 88, 88, 85, 83,
+  100, 100, 100, 100, 100, 88, 83, 101, 102, 103, 102, 103, 103, 85, 85, 104,
+  88, 88, 88, 88, 88, 88, 85, 105, 106, 106, 106, 106, 94, 94, 107, 108,
+  91, 91, 92, 92, 93, 107, 82, 82, 109, 109, 110, 109, 111, 96, 94, 87,
+  97, 97, 97, 97, 112, 97, 4, 4, 108, 113, 113, 108, 113, 113, 98, 84,
+  114, 114, 114, 114, 114, 98, 113, 4, 114, 114, 114, 114, 114, 98, 90, 4,
+  115, 115, 115, 116, 116, 83, 83, 4, 115, 115, 116, 116, 115, 85, 85, 117,
+  93, 93, 93, 93, 93, 103, 85, 104, 116, 116, 116, 116, 116, 85, 85, 118,
+  116, 116, 116, 116, 116, 82, 85, 119, 120, 121, 121, 121, 93, 93, 85, 122,
+  112, 112, 112, 112, 112, 4, 4, 4, 108, 108, 108, 108, 108, 98, 98, 4,
+  114, 114, 114, 114, 108, 98, 123, 4, 116, 115, 115, 116, 83, 83, 83, 4,
+  93, 93, 93, 93, 93, 103, 85, 124, 103, 103, 103, 103, 103, 85, 85, 125,
+  116, 116, 116, 126, 85, 85, 85, 4, 116, 116, 126, 116, 85, 85, 85, 4,
+  112, 112, 127, 112, 4, 4, 4, 4, 128, 128, 128, 108, 98, 98, 97, 4,
+  129, 129, 129, 129, 98, 98, 98, 4, 130, 130, 130, 130, 83, 83, 83, 131,
+  130, 132, 132, 132, 83, 85, 85, 105, 130, 130, 130, 130, 85, 85, 85, 133,
+  127, 127, 127, 127, 4, 4, 4, 4, 128, 128, 128, 128, 98, 98, 97, 4,
+  134, 134, 134, 128, 98, 98, 135, 4, 136, 136, 136, 137, 83, 83, 85, 4,
+  136, 138, 136, 139, 85, 85, 83, 140, 138, 136, 136, 139, 85, 85, 85, 118,
+  127, 127, 127, 4, 4, 4, 4, 4, 90, 90, 90, 98, 98, 98, 119, 4,
+  141, 141, 141, 83, 83, 83, 98, 4, 142, 142, 142, 87, 143, 144, 83, 4,
+  145, 145, 145, 83, 85, 85, 83, 4, 104, 104, 104, 4, 4, 4, 4, 4,
+  98, 98, 98, 98, 98, 98, 112, 4, 85, 83, 83, 83, 83, 83, 83, 124,
+  85, 85, 83, 83, 83, 85, 83, 4, 98, 98, 98, 98, 98, 97, 97, 4,
+  83, 83, 83, 83, 83, 83, 146, 4, 83, 83, 83, 83, 83, 85, 85, 4,
+  83, 83, 83, 83, 85, 83, 83, 4, 147, 148, 147, 147, 85, 85, 85, 85,
+  97, 97, 97, 97, 97, 97, 101, 4, 83, 85, 83, 83, 83, 83, 83, 149,
+  97, 97, 97, 97, 97, 97, 105, 4, 83, 83, 83, 83, 83, 98, 97, 4,
+  98, 98, 98, 98, 98, 98, 4, 4, 97, 97, 97, 97, 97, 112, 4, 4,
+  85, 82, 82, 85, 85, 85, 85, 85, 0, 150, 0, 0, 0, 0, 0, 0,
+  97, 97, 97, 97, 97, 97, 112, 4, 83, 83, 83, 83, 98, 98, 97, 4,
+  0, 0, 151, 151, 0, 0, 0, 0, 152, 152, 152, 152, 152, 152, 153, 28,
+  154, 154, 154, 154, 154, 154, 28, 28, 155, 155, 155, 155, 155, 155, 156, 4,
+  157, 157, 157, 157, 157, 157, 158, 159, 160, 160, 160, 161, 161, 160, 155, 162,
+  157, 157, 157, 157, 157, 157, 157, 30, 163, 163, 15, 163, 163, 163, 163, 164,
+  27, 27, 27, 165, 27, 27, 27, 28, 166, 166, 166, 166, 166, 166, 167, 4,
+  168, 168, 168, 168, 168, 168, 169, 4, 166, 166, 166, 166, 166, 166, 4, 4,
+  170, 171, 171, 170, 171, 170, 172, 39, 170, 170, 170, 170, 170, 170, 28, 4,
+  173, 174, 174, 174, 174, 163, 175, 28, 176, 177, 177, 176, 177, 165, 27, 28,
+  166, 166, 178, 166, 166, 178, 4, 4, 170, 170, 171, 170, 170, 170, 164, 179,
+  170, 170, 170, 171, 171, 170, 172, 4, 180, 180, 180, 180, 180, 172, 172, 4,
+  181, 181, 181, 182, 183, 184, 172, 162, 183, 183, 185, 185, 183, 186, 172, 4,
+  187, 180, 187, 180, 18, 172, 45, 53, 151, 0, 0, 0, 0, 0, 188, 0,
+  155, 155, 155, 155, 155, 155, 189, 4, 15, 15, 15, 15, 15, 15, 190, 28,
+  27, 27, 27, 27, 27, 27, 15, 28, 155, 155, 155, 155, 155, 155, 155, 4,
+  157, 157, 157, 157, 157, 157, 191, 164, 163, 15, 163, 163, 163, 163, 192, 164,
+  193, 193, 194, 194, 194, 194, 165, 164, 165, 27, 27, 27, 27, 27, 27, 28,
+  168, 168, 168, 168, 168, 168, 195, 4, 166, 166, 166, 166, 166, 166, 196, 4,
+  171, 171, 171, 171, 171, 171, 172, 4, 171, 170, 170, 171, 170, 170, 164, 197,
+  173, 173, 173, 173, 173, 163, 198, 37, 166, 199, 199, 166, 166, 166, 4, 4,
+  170, 170, 171, 170, 170, 171, 164, 4, 171, 170, 170, 171, 170, 170, 172, 4,
+  199, 199, 199, 199, 199, 4, 4, 4, 187, 180, 180, 180, 18, 164, 3, 4,
+  15, 15, 15, 15, 15, 15, 200, 28, 154, 154, 154, 154, 154, 154, 201, 28,
+  27, 27, 26, 27, 27, 27, 27, 28, 157, 157, 157, 157, 157, 157, 157, 164,
+  161, 161, 161, 161, 161, 161, 202, 203, 157, 157, 157, 157, 157, 157, 204, 164,
+  168, 168, 168, 168, 168, 168, 205, 4, 171, 170, 170, 170, 170, 170, 164, 206,
+  171, 171, 171, 171, 171, 171, 207, 4, 208, 208, 208, 208, 208, 208, 164, 55,
+  170, 170, 170, 170, 170, 170, 164, 209, 170, 210, 170, 170, 170, 170, 164, 211,
+  178, 178, 178, 166, 178, 166, 4, 4, 166, 199, 199, 199, 166, 166, 4, 4,
+  185, 171, 185, 185, 171, 171, 212, 4, 170, 170, 170, 170, 171, 170, 164, 213,
+  170, 170, 170, 210, 170, 170, 164, 4, 214, 214, 214, 214, 214, 215, 216, 0,
+  182, 182, 182, 181, 183, 186, 164, 55, 13, 13, 198, 13, 13, 13, 28, 164,
+  215, 215, 215, 214, 0, 0, 0, 0, 180, 180, 180, 217, 18, 172, 33, 4,
+  180, 187, 180, 180, 18, 172, 45, 4, 151, 0, 0, 0, 0, 0, 0, 0,
+  218, 218, 218, 218, 4, 4, 4, 4, 217, 217, 217, 217, 172, 45, 45, 4,
+  0, 0, 219, 0, 0, 0, 151, 0, 220, 220, 220, 36, 45, 45, 33, 4,
+  0, 151, 0, 151, 0, 0, 188, 0, 221, 151, 0, 222, 0, 0, 188, 0
+};
+
+const uint8_t AUTOPILOT_ROWS[223 * LanderAutopilot::ROW_BYTES] PROGMEM = {
+  0x00, 0x00, 0x00, 0x00, 0x11, 0x11, 0x11, 0x11, 0x07, 0x77, 0x77, 0x72, 0x54, 0x44, 0x44, 0x42,
+  0x22, 0x22, 0x22, 0x22, 0x17, 0x77, 0x77, 0x72, 0x14, 0x44, 0x44, 0x44, 0x14, 0x44, 0x44, 0x42,
+  0x54, 0x44, 0x44, 0x44, 0x11, 0x17, 0x77, 0x72, 0x11, 0x14, 0x44, 0x42, 0x11, 0x14, 0x44, 0x44,
+  0x11, 0x11, 0x77, 0x74, 0x11, 0x11, 0x44, 0x44, 0x11, 0x11, 0x17, 0x74, 0x11, 0x11, 0x14, 0x44,
+  0x22, 0x27, 0x77, 0x72, 0x22, 0x24, 0x44, 0x42, 0x22, 0x24, 0x44, 0x22, 0x24, 0x44, 0x44, 0x22,
+  0x27, 0x77, 0x77, 0x72, 0x24, 0x44, 0x44, 0x42, 0x24, 0x44, 0x44, 0x44, 0x07, 0x77, 0x77, 0x77,
+  0x11, 0x77, 0x77, 0x77, 0x11, 0x44, 0x44, 0x44, 0x11, 0x11, 0x11, 0x14, 0x11, 0x11, 0x11, 0x44,
+  0x44, 0x44, 0x44, 0x44, 0x22, 0x72, 0x22, 0x22, 0x22, 0x42, 0x22, 0x22, 0x27, 0x77, 0x72, 0x22,
+  0x24, 0x44, 0x42, 0x22, 0x54, 0x44, 0x42, 0x22, 0x54, 0x42, 0x22, 0x22, 0x22, 0x27, 0x77, 0x22,
+  0x22, 0x44, 0x44, 0x22, 0x22, 0x24, 0x22, 0x22, 0x27, 0x72, 0x22, 0x22, 0x24, 0x42, 0x22, 0x22,
+  0x54, 0x22, 0x22, 0x22, 0x11, 0x77, 0x77, 0x72, 0x11, 0x44, 0x44, 0x42, 0x07, 0x77, 0x72, 0x22,
+  0x07, 0x77, 0x77, 0x22, 0x54, 0x44, 0x44, 0x22, 0x54, 0x24, 0x22, 0x22, 0x52, 0x44, 0x22, 0x22,
+  0x22, 0x44, 0x44, 0x42, 0x52, 0x44, 0x44, 0x42, 0x52, 0x22, 0x22, 0x22, 0x07, 0x22, 0x22, 0x22,
+  0x54, 0x44, 0x22, 0x22, 0x24, 0x22, 0x22, 0x22, 0x11, 0x17, 0x77, 0x77, 0x22, 0x44, 0x22, 0x22,
+  0x11, 0x11, 0x17, 0x72, 0x22, 0x44, 0x42, 0x22, 0x22, 0x77, 0x77, 0x22, 0x22, 0x77, 0x77, 0x72,
+  0x52, 0x42, 0x22, 0x22, 0x22, 0x27, 0x22, 0x22, 0x22, 0x24, 0x42, 0x22, 0x24, 0x44, 0x22, 0x22,
+  0x51, 0x44, 0x44, 0x44, 0x11, 0x11, 0x77, 0x44, 0x11, 0x14, 0x14, 0x44, 0x54, 0x41, 0x44, 0x44,
+  0x22, 0x77, 0x22, 0x22, 0x11, 0x11, 0x17, 0x77, 0x11, 0x17, 0x17, 0x44, 0x14, 0x11, 0x44, 0x44,
+  0x22, 0x22, 0x77, 0x22, 0x12, 0x77, 0x77, 0x72, 0x51, 0x44, 0x44, 0x42, 0x11, 0x11, 0x17, 0x44,
+  0x11, 0x11, 0x11, 0x17, 0x07, 0x77, 0x22, 0x22, 0x17, 0x17, 0x77, 0x72, 0x54, 0x14, 0x44, 0x42,
+  0x11, 0x11, 0x77, 0x77, 0x54, 0x14, 0x44, 0x44, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x22,
+  0x22, 0x22, 0x22, 0x23, 0x33, 0x33, 0x33, 0x32, 0x33, 0x22, 0x23, 0x22, 0x33, 0x32, 0x33, 0x32,
+  0x00, 0x00, 0x33, 0x32, 0x00, 0x00, 0x33, 0x33, 0x23, 0x33, 0x32, 0x22, 0x00, 0x01, 0x33, 0x32,
+  0x00, 0x01, 0x33, 0x33, 0x11, 0x11, 0x33, 0x32, 0x11, 0x11, 0x13, 0x32, 0x11, 0x11, 0x13, 0x33,
+  0x11, 0x11, 0x11, 0x33, 0x33, 0x33, 0x22, 0x22, 0x33, 0x33, 0x32, 0x22, 0x33, 0x23, 0x22, 0x22,
+  0x00, 0x00, 0x33, 0x22, 0x23, 0x22, 0x22, 0x22, 0x11, 0x13, 0x33, 0x22, 0x11, 0x13, 0x33, 0x32,
+  0x32, 0x22, 0x22, 0x22, 0x22, 0x32, 0x22, 0x22, 0x00, 0x01, 0x13, 0x32, 0x11, 0x11, 0x33, 0x33,
+  0x22, 0x23, 0x32, 0x22, 0x00, 0x01, 0x11, 0x32, 0x00, 0x01, 0x11, 0x33, 0x11, 0x11, 0x11, 0x32,
+  0x33, 0x32, 0x22, 0x22, 0x22, 0x22, 0x32, 0x22, 0x00, 0x03, 0x32, 0x22, 0x00, 0x03, 0x33, 0x22,
+  0x00, 0x03, 0x33, 0x32, 0x22, 0x33, 0x22, 0x22, 0x22, 0x23, 0x22, 0x22, 0x23, 0x33, 0x22, 0x22,
+  0x00, 0x11, 0x33, 0x33, 0x00, 0x11, 0x33, 0x32, 0x22, 0x32, 0x22, 0x32, 0x22, 0x32, 0x32, 0x22,
+  0x22, 0x32, 0x23, 0x22, 0x22, 0x22, 0x22, 0x32, 0x00, 0x03, 0x33, 0x33, 0x33, 0x22, 0x22, 0x22,
+  0x22, 0x33, 0x32, 0x22, 0x00, 0x23, 0x32, 0x22, 0x00, 0x33, 0x33, 0x32, 0x23, 0x22, 0x23, 0x22,
+  0x00, 0x33, 0x33, 0x22, 0x22, 0x22, 0x32, 0x32, 0x02, 0x33, 0x32, 0x22, 0x23, 0x23, 0x22, 0x22,
+  0x02, 0x33, 0x33, 0x22, 0x22, 0x33, 0x33, 0x22, 0x02, 0x33, 0x33, 0x32, 0x22, 0x33, 0x33, 0x32,
+  0x33, 0x23, 0x32, 0x22, 0x23, 0x33, 0x33, 0x22, 0x33, 0x32, 0x33, 0x22, 0x33, 0x22, 0x33, 0x22,
+  0x32, 0x23, 0x33, 0x32, 0x23, 0x33, 0x33, 0x32, 0x33, 0x32, 0x32, 0x22, 0x11, 0x33, 0x33, 0x32,
+  0x11, 0x33, 0x33, 0x33, 0x23, 0x22, 0x32, 0x22, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x01,
+  0x00, 0x00, 0x04, 0x44, 0x00, 0x40, 0x04, 0x44, 0x00, 0x00, 0x14, 0x44, 0x00, 0x00, 0x04, 0x22,
+  0x44, 0x44, 0x04, 0x22, 0x00, 0x00, 0x04, 0x42, 0x04, 0x00, 0x04, 0x42, 0x44, 0x44, 0x24, 0x22,
+  0x11, 0x11, 0x04, 0x22, 0x11, 0x11, 0x04, 0x42, 0x24, 0x22, 0x22, 0x42, 0x11, 0x11, 0x14, 0x42,
+  0x44, 0x44, 0x44, 0x42, 0x11, 0x11, 0x11, 0x42, 0x00, 0x00, 0x22, 0x22, 0x22, 0x20, 0x22, 0x22,
+  0x00, 0x00, 0x42, 0x22, 0x00, 0x42, 0x42, 0x22, 0x00, 0x00, 0x44, 0x42, 0x00, 0x00, 0x44, 0x22,
+  0x44, 0x44, 0x44, 0x22, 0x00, 0x01, 0x14, 0x42, 0x00, 0x01, 0x14, 0x44, 0x11, 0x44, 0x14, 0x44,
+  0x00, 0x01, 0x11, 0x44, 0x00, 0x01, 0x11, 0x42, 0x00, 0x04, 0x22, 0x22, 0x42, 0x22, 0x22, 0x22,
+  0x00, 0x04, 0x44, 0x22, 0x11, 0x02, 0x44, 0x22, 0x11, 0x02, 0x44, 0x42, 0x00, 0x02, 0x44, 0x42,
+  0x22, 0x22, 0x44, 0x22, 0x00, 0x02, 0x44, 0x22, 0x22, 0x22, 0x44, 0x42, 0x00, 0x04, 0x44, 0x42,
+  0x00, 0x10, 0x00, 0x10, 0x04, 0x00, 0x04, 0x22, 0x44, 0x44, 0x14, 0x44, 0x44, 0x44, 0x04, 0x42,
+  0x14, 0x11, 0x14, 0x42, 0x00, 0x00, 0x11, 0x44, 0x00, 0x00, 0x11, 0x42, 0x40, 0x40, 0x42, 0x22,
+  0x22, 0x02, 0x22, 0x22, 0x24, 0x42, 0x42, 0x22, 0x11, 0x11, 0x44, 0x42, 0x00, 0x02, 0x22, 0x22,
+  0x44, 0x41, 0x14, 0x44, 0x41, 0x44, 0x14, 0x44, 0x00, 0x40, 0x04, 0x42, 0x24, 0x24, 0x42, 0x22,
+  0x40, 0x44, 0x04, 0x42, 0x24, 0x04, 0x42, 0x22, 0x22, 0x22, 0x24, 0x22, 0x44, 0x04, 0x44, 0x22,
+  0x11, 0x10, 0x44, 0x42, 0x22, 0x42, 0x24, 0x22, 0x00, 0x00, 0x44, 0x44, 0x24, 0x22, 0x42, 0x22,
+  0x42, 0x44, 0x44, 0x22, 0x44, 0x24, 0x22, 0x22, 0x22, 0x22, 0x00, 0x00, 0x22, 0x20, 0x00, 0x00,
+  0x22, 0x00, 0x00, 0x00, 0x00, 0x24, 0x44, 0x22, 0x00, 0x22, 0x22, 0x22, 0x01, 0x00, 0x00, 0x00,
+  0x02, 0x44, 0x44, 0x22, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+};
+
+#endif // LANDER_AUTOPILOT_POLICY_H
@@ -6,6 +6,8 @@
 #define LANDER_CONFIG_H
 
 #include "Arduino.h"
+#include "LanderTypes.h"
+#include "LanderFixed.h"
 
 // Pins
 constexpr byte DISTANCE_DISPLAY_DIO = 4;
@@ -19,18 +21,109 @@ constexpr byte THRUST_LEVER = A0;
 constexpr byte CONTROL_ROW_COUNT = 4;
 constexpr byte CONTROL_COLUMN_COUNT = 4;
 
+// Listed one by one in LanderKeypad (LanderHardware.h) as well
 constexpr byte COLUMN_PINS[CONTROL_COLUMN_COUNT] = { 10, 11, 12, 13 };
-constexpr byte ROW_PINS[4] = {9, 8, 7, 6};
+constexpr byte ROW_PINS[CONTROL_ROW_COUNT] = {9, 8, 7, 6};
 
 // Game Constants
 constexpr int INITIAL_DISTANCE = 1476;  // Distance to mother ship
 constexpr byte MAX_MOTHER_SHIP_WIDTH = 21;
 constexpr byte MAX_MOTHER_SHIP_HEIGHT = 15;
 constexpr byte DRIFT_CONTROL = 3;       // Must be > 1.  Higher numbers slow drift rate.
+constexpr byte MAX_DRIFT = 18;          // Furthest the mother ship drifts from radar center
 
 // Display Constants
+// OLED buffer size, traded against passes per frame.  The oledbench envs
+// override it with LANDER_OLED_BUFFER to compare the modes.
+#ifndef LANDER_OLED_BUFFER
+#define LANDER_OLED_BUFFER OLED_BUFFER_2_PAGE
+#endif
+constexpr OLED_BUFFER_MODE OLED_BUFFER = LANDER_OLED_BUFFER;
+constexpr byte DISPLAY_WIDTH = 128;     // Must match the U8G2 display in LanderHardware.cpp
+constexpr byte DISPLAY_HEIGHT = 64;
 constexpr byte RADAR_RADIUS = 25;
 constexpr int DRIFT_BEFORE_ARROW_X = 2;
 constexpr int DRIFT_BEFORE_ARROW_Y = 2;
 
+// Ending Constants
+// The ending screen swaps between the time and outcome splash and the final
+// radar view.  Turning all three levers off starts a new game in place.
+constexpr unsigned long ENDING_VIEW_MS = 2000;  // How long each view shows
+
+// Keypad Constants
+constexpr byte KEY_QUEUE_SIZE = 16;  // Press and release events held between ticks, a power of two
+
+// Scheduler Constants (milliseconds)
+// With INTERPOLATE the OLED refreshes faster than the game ticks and draws
+// the radar and gear between the last two ticks (see LanderInterpolation.h).
+// The latency_interpolate env overrides it with LANDER_INTERPOLATE.  A final
+// approach page with a 7-segment refresh in front of it takes over 50 ms,
+// so 50 ms misses frames; 60 ms is the shortest period that keeps up.
+#ifndef LANDER_INTERPOLATE
+#define LANDER_INTERPOLATE false
+#endif
+constexpr bool INTERPOLATE = LANDER_INTERPOLATE;
+constexpr unsigned long SIMULATION_TICK_MS = 100;   // Fixed game tick
+constexpr unsigned long RENDER_PERIOD_MS = INTERPOLATE ? 60 : 100;  // OLED refresh
+constexpr unsigned long DISTANCE_PERIOD_MS = 200;   // 7-segment refresh
+constexpr unsigned long SCHEDULER_REPORT_MS = 5000; // Serial timing report, 0 to disable
+
+// Profiler Constants
+// Time each frame stage into histograms in RAM, about 200 bytes when on.
+// Sending PROFILER_DUMP_COMMAND over Serial dumps and clears them; decode
+// the capture with host/profile_decode.cpp.
+constexpr bool PROFILER = false;
+constexpr char PROFILER_DUMP_COMMAND = 'P';
+
+// Physics Constants
+// Speed is in distance units per PHYSICS_REFERENCE_MS and each tick moves
+// its share of that, so the approach takes as long whatever the tick rate.
+// Drift and key presses still count per tick.  These defaults reproduce
+// the original whole-unit model exactly.
+constexpr unsigned long PHYSICS_REFERENCE_MS = 100;
+constexpr LanderSpeed THRUST_STEP = LanderSpeed::fromInt(1);        // Speed change per RAISE/LOWER_SPEED
+constexpr LanderRatio DRAG = LanderRatio::fromRaw(0);               // Share of speed lost per reference tick
+constexpr LanderSpeed MAX_LANDING_SPEED = LanderSpeed::fromInt(2);  // Any faster is ENDING_TOO_FAST
+constexpr LanderRatio TICK_SCALE = LanderRatio::fromRatio(SIMULATION_TICK_MS, PHYSICS_REFERENCE_MS);
+
+// Input Log Constants
+// The ring takes 2 bytes a tick and 16 more for two game snapshots.  A
+// dump at game over holds the last half to all of it, 6.4 to 12.8 s at
+// the default size, and replays from the snapshot before its first tick.
+constexpr INPUT_LOG_MODE INPUT_LOG = INPUT_LOG_OFF;
+constexpr byte INPUT_LOG_RING_TICKS = 128;  // RAM ring size, even
+
+// Telemetry Constants
+// Stream a framed game state record every tick for host/telemetry_cli.cpp.
+// Shares Serial with the text report and the input log, so it replaces the
+// report and can't run beside INPUT_LOG_SERIAL.
+constexpr bool TELEMETRY = false;
+constexpr unsigned long SERIAL_BAUD = 115200;  // 14 bytes a tick need over 1400 baud at 100 ms ticks
+
+static_assert(!TELEMETRY || INPUT_LOG != INPUT_LOG_SERIAL,
+              "Telemetry and INPUT_LOG_SERIAL can't share Serial");
+
+// Rewind Constants
+// Keep a snapshot of every tick for the last REWIND_TICKS ticks and step
+// back through them while LOWER_GEAR and RAISE_GEAR are held together.
+// Costs 8 bytes of RAM a tick, 400 bytes for the default 5 seconds.
+constexpr bool REWIND = false;
+constexpr byte REWIND_TICKS = 5000 / SIMULATION_TICK_MS;
+
+// Autopilot Constants
+// Fly with the solved policy in LanderAutopilotPolicy.h whenever no key is
+// pressed.  Costs about 4.5 KB of flash, none when off.
+constexpr bool AUTOPILOT = false;
+
+// Ghost Constants
+// Keep the fastest successful approach in EEPROM and fly it again as a
+// second mother ship on the radar, see LanderGhost.h.  Costs about 30
+// bytes of RAM and GHOST_EEPROM_SIZE bytes of EEPROM from
+// GHOST_EEPROM_ADDRESS, split into two slots.  A run takes under a byte a
+// tick, so the 1 KB default holds approaches of a minute or more; a
+// longer one just isn't kept.
+constexpr bool GHOST = false;
+constexpr uint16_t GHOST_EEPROM_ADDRESS = 0;
+constexpr uint16_t GHOST_EEPROM_SIZE = 1024;  // All of the Uno's EEPROM
+
 #endif // LANDER_CONFIG_H
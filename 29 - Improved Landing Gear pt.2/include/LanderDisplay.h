@@ -7,15 +7,46 @@
 
 #include "Arduino.h"
 #include "LanderTypes.h"
+#include "LanderFixed.h"
+#include "LanderInterpolation.h"
+
+// Everything that changes what a frame looks like.  Two frames with the same
+// key draw the same pixels, so the second one doesn't need to be sent.
+struct LanderRenderKey {
+  byte approach_state;
+  byte levers;           // Thrust, systems, confirm as bits 0-2
+  byte gear_index;
+  byte previous_gear_index;
+  byte gear_wipe;        // Rows of the current gear bitmap shown, not the blend
+  byte distance_bucket;  // Mother ship size step, not the raw distance
+  int8_t x_offset;
+  int8_t y_offset;
+  bool ghost_visible;
+  byte ghost_bucket;
+  int8_t ghost_x_offset;
+  int8_t ghost_y_offset;
+  int speed;             // After the bytes so the key has no padding to hash
+};
 
 class LanderDisplay {
 public:
+  // Frame memoization
+  static LanderRenderKey makeRenderKey(
+      APPROACH_STATE approach_state,
+      const InputFrame& input,
+      const LanderView& view,
+      bool ending_splash
+  );
+
+  // False (and counts the frame as elided) when key matches the last presented frame
+  static bool shouldRender(const LanderRenderKey& key);
+  // Frames drawn and elided, and frames drawn per second, since the last report
+  static void reportRenderStats(Print& out);
+
   // Display management
   static void displayPreFlight(
       APPROACH_STATE approach_state,
-      bool thrusterLever,
-      bool systemsLever,
-      bool confirmLever
+      const InputFrame& input
   );
 
   static void displayInFlight(
@@ -25,26 +56,54 @@ public:
       int mother_ship_y_offset
   );
 
+  // Best run's mother ship as the corners of its frame, over displayInFlight()
+  static void displayGhost(
+      int ghost_distance,
+      int ghost_x_offset,
+      int ghost_y_offset
+  );
+
+  // Wipes from the previous gear bitmap to the current one as gear_blend
+  // goes from 0 to 1, down while lowering and up while raising
   static void displayFinal(
-      int current_gear_bitmap_index
+      int current_gear_bitmap_index,
+      int previous_gear_bitmap_index,
+      LanderRatio gear_blend
   );
 
-  static void displayEndingScreen(
+  // Splash half of the ending screen: time and outcome bitmap.  The radar
+  // half is displayFinal() and displayInFlight() as on the final approach.
+  static void displayEnding(
+      const char* time,
+      const unsigned char* endingBitmap
+  );
+
+  static void displayEnding(
       unsigned long elapsed_time,
-      const unsigned char* endingBitmap,
-      int current_gear_bitmap_index,
-      int lander_distance,
-      int lander_speed,
-      int mother_ship_x_offset,
-      int mother_ship_y_offset
+      const unsigned char* endingBitmap
   );
 
 private:
+  static uint16_t lastFrameHash;
+  static LanderRenderKey lastFrameKey;
+  static bool lastFrameValid;
+  static unsigned int framesRendered;
+  static unsigned int framesElided;
+  static unsigned long statsStarted;  // millis() at the last report
+
   // Helper functions
-  static byte drawString(byte x, byte y, const char* string);
-  static byte displayLeverSetting(const String& leverName, bool leverVal, byte yOffset);
-  static String onOff(bool val);
-  static String liftoffStateToString(APPROACH_STATE approach_state);
+  static uint16_t hashRenderKey(const LanderRenderKey& key);
+  static byte distanceBucket(int lander_distance);
+  static byte gearWipe(int current_gear_bitmap_index, int previous_gear_bitmap_index, LanderRatio gear_blend);
+  // Draw label then value, both from flash, and return the next line's y
+  static byte drawString(
+      byte x, byte y,
+      const __FlashStringHelper* label,
+      const __FlashStringHelper* value = nullptr
+  );
+  static byte displayLeverSetting(const __FlashStringHelper* leverName, bool leverVal, byte yOffset);
+  static const __FlashStringHelper* onOff(bool val);
+  static const __FlashStringHelper* liftoffStateToString(APPROACH_STATE approach_state);
 };
 
 #endif // LANDER_DISPLAY_H
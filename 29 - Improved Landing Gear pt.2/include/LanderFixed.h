@@ -0,0 +1,86 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_FIXED_H
+#define LANDER_FIXED_H
+
+#include <stdint.h>
+
+// Signed Q-format fixed point number: Raw holds the value times
+// 2^FRACTION_BITS.  Sums stay in Raw and products go through Wide, so the
+// AVR never needs floating point.  Everything is constexpr so physics
+// constants can be written as fixed point values in LanderConfig.h.
+template <typename Raw, uint8_t FRACTION_BITS, typename Wide = int32_t>
+class LanderFixed {
+public:
+  typedef Raw RawType;
+  static constexpr uint8_t FRACTION = FRACTION_BITS;
+  static constexpr Raw ONE = static_cast<Raw>(1) << FRACTION_BITS;
+
+  constexpr LanderFixed() : raw(0) {}
+
+  static constexpr LanderFixed fromRaw(const Raw value) { return LanderFixed(value); }
+  static constexpr LanderFixed fromInt(const int value) { return LanderFixed(static_cast<Raw>(value * ONE)); }
+
+  // value / divisor, for constants like a fraction of a tick
+  static constexpr LanderFixed fromRatio(const long value, const long divisor) {
+    return LanderFixed(static_cast<Raw>(value * ONE / divisor));
+  }
+
+  constexpr Raw toRaw() const { return raw; }
+
+  // Whole units, rounded down or up
+  constexpr int floor() const { return static_cast<int>(raw >> FRACTION_BITS); }
+  constexpr int ceil() const { return static_cast<int>((static_cast<Wide>(raw) + ONE - 1) >> FRACTION_BITS); }
+
+  // Nearest whole unit, halves rounded up
+  constexpr int round() const { return static_cast<int>((static_cast<Wide>(raw) + ONE / 2) >> FRACTION_BITS); }
+
+  // Same value in another Q format, dropping any fraction bits it lacks
+  template <typename Fixed>
+  constexpr Fixed to() const {
+    return Fixed::fromRaw(static_cast<typename Fixed::RawType>(shift(raw, Fixed::FRACTION - FRACTION_BITS)));
+  }
+
+  // Product with a value in any Q format, kept in this format
+  template <typename Factor>
+  constexpr LanderFixed operator*(const Factor factor) const {
+    return LanderFixed(static_cast<Raw>(shift(static_cast<Wide>(raw) * factor.toRaw(), -Factor::FRACTION)));
+  }
+
+  constexpr LanderFixed operator+(const LanderFixed other) const { return LanderFixed(raw + other.raw); }
+  constexpr LanderFixed operator-(const LanderFixed other) const { return LanderFixed(raw - other.raw); }
+  constexpr LanderFixed operator-() const { return LanderFixed(-raw); }
+
+  LanderFixed& operator+=(const LanderFixed other) { raw += other.raw; return *this; }
+  LanderFixed& operator-=(const LanderFixed other) { raw -= other.raw; return *this; }
+
+  constexpr bool operator==(const LanderFixed other) const { return raw == other.raw; }
+  constexpr bool operator!=(const LanderFixed other) const { return raw != other.raw; }
+  constexpr bool operator<(const LanderFixed other) const { return raw < other.raw; }
+  constexpr bool operator<=(const LanderFixed other) const { return raw <= other.raw; }
+  constexpr bool operator>(const LanderFixed other) const { return raw > other.raw; }
+  constexpr bool operator>=(const LanderFixed other) const { return raw >= other.raw; }
+
+private:
+  Raw raw;
+
+  constexpr explicit LanderFixed(const Raw value) : raw(value) {}
+
+  // Multiply rather than left shift so negative values are well defined
+  static constexpr Wide shift(const Wide value, const int bits) {
+    return bits >= 0 ? value * (static_cast<Wide>(1) << bits) : value >> -bits;
+  }
+};
+
+// Speed in distance units per PHYSICS_REFERENCE_MS, Q8.8
+typedef LanderFixed<int16_t, 8> LanderSpeed;
+
+// Distance units, Q12.4.  INITIAL_DISTANCE needs 11 integer bits.
+typedef LanderFixed<int16_t, 4> LanderDistance;
+
+// Unitless factors such as drag and tick scaling, Q8.8
+typedef LanderFixed<int16_t, 8> LanderRatio;
+
+#endif // LANDER_FIXED_H
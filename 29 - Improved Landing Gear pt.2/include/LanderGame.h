@@ -6,57 +6,76 @@
 #define LANDER_GAME_H
 
 #include "LanderTypes.h"
+#include "LanderFixed.h"
+#include "LanderSnapshot.h"
 
 class LanderGame {
 public:
   // Constructor
   LanderGame();
 
-  // Main game loop
-  void update();
+  // Advance the game one tick using only the given inputs.  now is the tick
+  // time in milliseconds and only feeds the approach timer.
+  void update(const InputFrame& input, unsigned long now);
 
   // Game state getters
   APPROACH_STATE getApproachState() const { return approach_state; }
   GEAR_STATE getGearState() const { return gear_state; }
-  int getLanderDistance() const { return lander_distance; }
-  int getLanderSpeed() const { return lander_speed; }
+  int getLanderDistance() const { return lander_distance.ceil(); }  // Only 0 once landed
+  int getLanderSpeed() const { return lander_speed.floor(); }
+  LanderDistance getLanderDistanceFixed() const { return lander_distance; }
+  LanderSpeed getLanderSpeedFixed() const { return lander_speed; }
   int getMotherShipXOffset() const { return mother_ship_x_offset; }
   int getMotherShipYOffset() const { return mother_ship_y_offset; }
   int getCurrentGearBitmapIndex() const { return current_gear_bitmap_index; }
   unsigned long getApproachStartTime() const { return approachStartTime; }
 
   // Game state checkers
-  bool isGameOver() const { return lander_distance <= 0; }
+  bool isGameOver() const { return approach_state == APPROACH_ENDING; }
+  bool isShowingEndingSplash() const;  // Time and outcome rather than the radar
+  ENDING_OUTCOME getOutcome() const;
   const unsigned char* getEndingBitmap() const;
   unsigned long getElapsedTime() const;
 
+  // Pack the state after the latest update() into 8 bytes
+  LanderSnapshot save() const;
+
+  // Go back to a saved state.  now is the current tick time, as for
+  // update(), and the approach timer keeps the elapsed time it had.
+  void restore(const LanderSnapshot& snapshot, unsigned long now);
+
 private:
   // Game state variables
   APPROACH_STATE approach_state;
   GEAR_STATE gear_state;
 
   unsigned long approachStartTime;
+  unsigned long lastUpdateTime;
   int current_gear_bitmap_index;
 
-  int lander_distance;
-  int lander_speed;
+  LanderDistance lander_distance;
+  LanderSpeed lander_speed;
   int mother_ship_x_offset;
   int mother_ship_y_offset;
 
+  uint8_t ending_tick;  // Ticks into the current pair of ending views
+  bool restart_armed;   // A lever has been seen on since touchdown
+
   // State processing functions
-  void processApproachInit();
-  void processApproachPreflight();
-  void processApproachInFlight();
+  void processApproachInit(const InputFrame& input);
+  void processApproachPreflight(const InputFrame& input);
+  void processApproachInFlight(const InputFrame& input);
   static void processApproachFinal();
+  void processApproachEnding(const InputFrame& input);
 
-  void processInflightState();
+  void processInflightState(const InputFrame& input);
+  void processKey(LANDER_CONTROLS currentKey);
   bool processSpeedState(LANDER_CONTROLS action);
   bool processGearState(LANDER_CONTROLS action);
   void processSteeringState(LANDER_CONTROLS action);
-  static int getRandomDrift();
 
   void updateGearAnimation();
-  void updateMotherShipDrift();
+  void updateMotherShipDrift(int drift_x, int drift_y);
   void updateDistance();
 };
 
@@ -0,0 +1,92 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_GHOST_H
+#define LANDER_GHOST_H
+
+#include "Arduino.h"
+#include "LanderConfig.h"
+#include "LanderFixed.h"
+#include "LanderGame.h"
+#include "LanderGhostRecord.h"
+
+// Fastest successful approach, kept in EEPROM and flown again as a second
+// marker on the radar (see LanderGhostRecord.h for the format).
+//
+// Every approach is recorded from its first thrust straight into the spare
+// EEPROM slot, a byte at a time with EEPROM.update(), and becomes the new
+// best at touchdown if it beat the old one.  Recording stops for good once
+// the run is slower than the best or is rewound, so losing runs cost few
+// writes.  The ghost starts with the first thrust of each later approach
+// and is decoded from EEPROM a tick at a time, so neither side holds the
+// run in SRAM.  Speeds are recorded as whole units and the distance is
+// worked out from them, which matches the game exactly only while
+// THRUST_STEP is a whole number and DRAG is 0; LanderGhost.cpp checks
+// both at compile time.  Turned on by GHOST in LanderConfig.h.
+class LanderGhost {
+public:
+  // Find the best run in EEPROM
+  static void begin();
+
+  // After every tick, with whether it was a rewind step
+  static void update(const LanderGame& game, bool rewound);
+
+  // The ghost's mother ship for the radar, while it's flying
+  static bool isVisible() { return playing; }
+  static int getLanderDistance() { return distance.ceil(); }
+  static int getMotherShipXOffset() { return x_offset; }
+  static int getMotherShipYOffset() { return y_offset; }
+
+  // Elapsed time of the best run, 0 with none yet
+  static unsigned long getBestTime() { return bestTime; }
+
+private:
+  enum RECORDING {
+    RECORDING_IDLE,      // Waiting for the first thrust
+    RECORDING_ON,
+    RECORDING_STOPPED    // Can't be a new best, or already saved
+  };
+
+  static constexpr uint16_t SLOT_SIZE = (GHOST_EEPROM_SIZE - LanderGhostRecord::HEADER_SIZE) / 2;
+  static constexpr uint8_t NO_SLOT = 0xFF;
+  static constexpr uint8_t NO_NIBBLE = 0xFF;
+
+  static uint8_t activeSlot;       // Slot with the best run, or NO_SLOT
+  static unsigned long bestTime;
+
+  // Recorder
+  static RECORDING recording;
+  static uint16_t writeAt;         // EEPROM address of the next whole byte
+  static uint16_t writeEnd;
+  static uint8_t pendingNibble;    // Low nibble waiting for its high one, or NO_NIBBLE
+  static int8_t recordedX;
+  static int8_t recordedY;
+  static int8_t recordedSpeed;
+
+  // Player
+  static bool playing;
+  static uint16_t readAt;
+  static uint16_t readEnd;
+  static bool readHigh;            // Next nibble is the high one of readAt
+  static int8_t x_offset;
+  static int8_t y_offset;
+  static int8_t speed;
+  static LanderDistance distance;
+
+  static uint16_t slotAddress(uint8_t slot);
+
+  static void startRecording(const LanderGame& game);
+  static void recordTick(const LanderGame& game);
+  static void finishRecording(const LanderGame& game);
+  static void writeNibble(uint8_t nibble);
+  static void writeVarint(int value);
+
+  static void startPlaying();
+  static void playTick();
+  static uint8_t readNibble();
+  static int readVarint();
+  static void move(int8_t speed_now);
+};
+
+#endif // LANDER_GHOST_H
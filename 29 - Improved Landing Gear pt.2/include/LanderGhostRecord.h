@@ -0,0 +1,75 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_GHOST_RECORD_H
+#define LANDER_GHOST_RECORD_H
+
+#include <stdint.h>
+
+// Ghost run format in EEPROM, see LanderGhost.h.
+//
+// Header (4 bytes): 'G' 'R' version active
+//   active is the slot holding the best run, 0 or 1, or anything else for
+//   none yet.  Blank EEPROM reads 0xFF, so a new board has no ghost.
+// Then two slots of the same size.  A run is always written into the slot
+// that isn't active, and only becomes the best once the active byte is
+// written, so losing power part way keeps the old best whole.
+//
+// Slot: elapsed_ms(uint32 LE) start_x(int8) start_y(int8) start_speed(int8)
+// holding the state after the tick the approach started, then a stream of
+// 4-bit symbols, low nibble first, one per tick after that:
+//   0-8   the mother ship moved by (symbol / 3 - 1, symbol % 3 - 1), the
+//         speed stayed the same
+//   9     long form: x, y and speed changes follow as nibble varints
+//   10    speed went up by one, a move symbol 0-8 follows
+//   11    speed went down by one, a move symbol 0-8 follows
+//   15    end of the run
+// A nibble varint is the zigzag value 3 bits at a time, low bits first,
+// with bit 3 set on every nibble but the last.  Drift and steering move
+// the mother ship a pixel a tick and the speed changes by one at most, so
+// a tick takes half a byte, or a byte while speeding up or slowing down.
+class LanderGhostRecord {
+public:
+  static constexpr uint8_t MAGIC_0 = 'G';
+  static constexpr uint8_t MAGIC_1 = 'R';
+  static constexpr uint8_t VERSION = 1;
+  static constexpr uint8_t HEADER_SIZE = 4;
+  static constexpr uint8_t ACTIVE_OFFSET = 3;
+  static constexpr uint8_t SLOT_HEADER_SIZE = 7;
+
+  static constexpr uint8_t SYMBOL_MOVES = 9;  // 0-8
+  static constexpr uint8_t SYMBOL_LONG = 9;
+  static constexpr uint8_t SYMBOL_FASTER = 10;
+  static constexpr uint8_t SYMBOL_SLOWER = 11;
+  static constexpr uint8_t SYMBOL_END = 15;
+
+  // Longest long form: a symbol and three varints of up to 16 bits
+  static constexpr uint8_t MAX_TICK_NIBBLES = 1 + 3 * 6;
+
+  static uint16_t zigzag(const int16_t value) {
+    return static_cast<uint16_t>((static_cast<uint16_t>(value) << 1) ^ static_cast<uint16_t>(value >> 15));
+  }
+
+  static int16_t unzigzag(const uint16_t value) {
+    return static_cast<int16_t>((value >> 1) ^ (0U - (value & 1)));
+  }
+
+  // Move symbol for a tick, or SYMBOL_LONG when the move doesn't fit in one
+  static uint8_t moveSymbol(const int dx, const int dy) {
+    if (dx < -1 || dx > 1 || dy < -1 || dy > 1) {
+      return SYMBOL_LONG;
+    }
+    return static_cast<uint8_t>((dx + 1) * 3 + (dy + 1));
+  }
+
+  // Prefix for a speed change, or SYMBOL_LONG when it needs the long form
+  static uint8_t speedSymbol(const int dspeed) {
+    return dspeed == 1 ? SYMBOL_FASTER : dspeed == -1 ? SYMBOL_SLOWER : SYMBOL_LONG;
+  }
+
+  static int8_t moveX(const uint8_t symbol) { return static_cast<int8_t>(symbol / 3 - 1); }
+  static int8_t moveY(const uint8_t symbol) { return static_cast<int8_t>(symbol % 3 - 1); }
+};
+
+#endif // LANDER_GHOST_RECORD_H
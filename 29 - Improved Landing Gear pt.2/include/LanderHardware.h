@@ -6,11 +6,22 @@
 #define LANDER_HARDWARE_H
 
 #include "Arduino.h"
-#include <U8g2lib.h>
 #include <TM1637Display.h>
-#include <Keypad.h>
+#include <StaticKeypad.h>
 #include "LanderConfig.h"
 #include "LanderTypes.h"
+#include "LanderRandom.h"
+#include "LanderKeyQueue.h"
+#include "LanderOled.h"
+
+// Keypad with the pins and keymap built in (see StaticKeypad.h), so neither
+// takes SRAM and the scan reads the ports directly
+extern const char control_buttons[CONTROL_ROW_COUNT][CONTROL_COLUMN_COUNT];
+typedef StaticKeypad<
+  KeypadPins<ROW_PINS[0], ROW_PINS[1], ROW_PINS[2], ROW_PINS[3]>,
+  KeypadPins<COLUMN_PINS[0], COLUMN_PINS[1], COLUMN_PINS[2], COLUMN_PINS[3]>,
+  control_buttons
+> LanderKeypad;
 
 class LanderHardware {
 public:
@@ -23,22 +34,41 @@ public:
   static void showDistance(int distance);
 
   // Input functions
-  static bool getThrustLever();
-  static bool getSystemsLever();
-  static bool getConfirmLever();
-  static LANDER_CONTROLS getControlButtonPressed();
+  // Scan the keypad and queue any press or release.  Runs from the Timer0
+  // compare interrupt on the AVR, so quick taps between ticks still arrive.
+  static void sampleKeypad();
+
+  // Gather every input the game needs for one tick, the levers in one read
+  static InputFrame readInputFrame();
+
+  // Print dropped key events and the slowest event-to-tick delay
+  static void reportKeyStats(Print& out);
 
-  // Random utilities
-  static int getRandomDrift();
+  // Bytes between the top of the heap and the stack, 0 when not on an AVR
+  // (the host sim included), so free RAM can only be read on the board
+  static int freeMemory();
+
+  // Seed the drift generator from analog noise, called by init()
   static void seedRandom();
 
 private:
-  static LANDER_CONTROLS lastKey;
+  static LANDER_CONTROLS heldKey;
+  static uint16_t heldKeys;  // Bit per LANDER_CONTROLS, for the rewind chord
+  static LanderKeyQueue keyQueue;
+  static uint16_t maxKeyLatency;
+
+  // Thrust, systems and confirm levers as bits 0-2
+  static byte readLevers();
+
+  // Turn the queued events since the last tick into the held key, a tap
+  // and the rewind chord
+  static void drainKeyEvents(InputFrame& frame);
+  static LanderRandom driftRandom;
 };
 
 // External hardware objects (defined in LanderHardware.cpp)
-extern U8G2_SH1106_128X64_NONAME_2_HW_I2C landerDisplay;
+extern LanderScreen::Display landerDisplay;
 extern TM1637Display distanceDisplay;
-extern Keypad lander_controls;
+extern LanderKeypad lander_controls;
 
 #endif // LANDER_HARDWARE_H
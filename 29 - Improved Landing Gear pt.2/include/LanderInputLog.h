@@ -0,0 +1,53 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_INPUT_LOG_H
+#define LANDER_INPUT_LOG_H
+
+#include "Arduino.h"
+#include "LanderConfig.h"
+#include "LanderGame.h"
+#include "LanderTypes.h"
+
+// Records the InputFrame of every simulation tick so a game can be replayed
+// exactly on the host (see host/replay.cpp).  Where the log goes is chosen
+// by INPUT_LOG in LanderConfig.h.
+//
+// The RAM ring is kept in two halves, with a snapshot of the game before
+// each.  When it fills, the older half is dropped and the log starts from
+// the snapshot before the newer one, so a dump always holds the last half
+// to all of the ring and the replayer can restore the game it starts from.
+class LanderInputLog {
+public:
+  // Send the stream header when logging straight to Serial
+  static void begin(const LanderGame& game);
+
+  // Log the inputs of the tick about to run on game
+  static void record(const InputFrame& frame, const LanderGame& game);
+
+  // The game restarted in place.  The ring starts over with the new game;
+  // a Serial stream carries on, and the replayer follows it through the
+  // restart.
+  static void restart();
+
+  // Write the RAM ring as a complete log, oldest tick first
+  static void dump(Print& out);
+
+private:
+  static constexpr byte RING_SIZE = INPUT_LOG == INPUT_LOG_RING ? INPUT_LOG_RING_TICKS : 2;
+  static constexpr byte HALF_RING = RING_SIZE / 2;
+
+  static_assert(RING_SIZE % 2 == 0, "INPUT_LOG_RING_TICKS must be even");
+
+  static uint16_t ring[RING_SIZE];
+  static byte oldest;
+  static byte stored;
+  static uint16_t tickCount;
+  static LanderSnapshot base;    // Game before the oldest record
+  static LanderSnapshot middle;  // Game before the record HALF_RING after it
+
+  static void writeHeader(Print& out, uint16_t first_tick, const LanderSnapshot& snapshot);
+};
+
+#endif // LANDER_INPUT_LOG_H
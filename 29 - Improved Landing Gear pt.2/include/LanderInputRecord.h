@@ -0,0 +1,93 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_INPUT_RECORD_H
+#define LANDER_INPUT_RECORD_H
+
+#include "LanderTypes.h"
+#include "LanderSnapshot.h"
+
+// Binary input log format, shared by the on-device recorder and the host
+// replayer.
+//
+// Header (6 bytes): 'L' 'I' version tick_ms first_tick(uint16 LE)
+// Version 4 follows it with the LanderSnapshot of the game before the
+// first record (8 bytes: distance_raw, speed_raw, packed, all LE), so a
+// log that starts mid-game replays from where the device was.
+// Then one 16-bit little endian record per tick:
+//   bits 0-2   thrust, systems, confirm levers
+//   bits 3-6   LANDER_CONTROLS key
+//   bits 7-8   drift_x + 1
+//   bits 9-10  drift_y + 1
+//   bits 11-14 LANDER_CONTROLS tap (version 2, always 0 in version 1)
+//   bit  15    rewind chord (version 3, always 0 before)
+class LanderInputRecord {
+public:
+  static constexpr uint8_t MAGIC_0 = 'L';
+  static constexpr uint8_t MAGIC_1 = 'I';
+  static constexpr uint8_t VERSION = 4;
+  static constexpr uint8_t HEADER_SIZE = 6;
+  static constexpr uint8_t SNAPSHOT_SIZE = 8;
+  static constexpr uint8_t RECORD_SIZE = 2;
+
+  static uint16_t pack(const InputFrame& frame) {
+    return static_cast<uint16_t>(
+        (frame.thrust_lever ? 0x001 : 0) |
+        (frame.systems_lever ? 0x002 : 0) |
+        (frame.confirm_lever ? 0x004 : 0) |
+        ((frame.key & 0x0F) << 3) |
+        ((frame.drift_x + 1) << 7) |
+        ((frame.drift_y + 1) << 9) |
+        ((frame.tap & 0x0F) << 11) |
+        (frame.rewind ? 0x8000 : 0)
+    );
+  }
+
+  static InputFrame unpack(const uint16_t record) {
+    InputFrame frame;
+    frame.thrust_lever = record & 0x001;
+    frame.systems_lever = record & 0x002;
+    frame.confirm_lever = record & 0x004;
+    frame.key = static_cast<LANDER_CONTROLS>((record >> 3) & 0x0F);
+    frame.drift_x = static_cast<int8_t>(((record >> 7) & 0x03) - 1);
+    frame.drift_y = static_cast<int8_t>(((record >> 9) & 0x03) - 1);
+    frame.tap = static_cast<LANDER_CONTROLS>((record >> 11) & 0x0F);
+    frame.rewind = record & 0x8000;
+    return frame;
+  }
+
+  static void writeHeader(uint8_t* out, const uint8_t tick_ms, const uint16_t first_tick) {
+    out[0] = MAGIC_0;
+    out[1] = MAGIC_1;
+    out[2] = VERSION;
+    out[3] = tick_ms;
+    out[4] = first_tick & 0xFF;
+    out[5] = first_tick >> 8;
+  }
+
+  static void writeSnapshot(uint8_t* out, const LanderSnapshot& snapshot) {
+    const uint16_t distance = snapshot.distance_raw;
+    const uint16_t speed = snapshot.speed_raw;
+    out[0] = distance & 0xFF;
+    out[1] = distance >> 8;
+    out[2] = speed & 0xFF;
+    out[3] = speed >> 8;
+    for (uint8_t i = 0; i < 4; i++) {
+      out[4 + i] = (snapshot.packed >> (8 * i)) & 0xFF;
+    }
+  }
+
+  static LanderSnapshot readSnapshot(const uint8_t* in) {
+    LanderSnapshot snapshot;
+    snapshot.distance_raw = static_cast<int16_t>(in[0] | static_cast<uint16_t>(in[1]) << 8);
+    snapshot.speed_raw = static_cast<int16_t>(in[2] | static_cast<uint16_t>(in[3]) << 8);
+    snapshot.packed = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+      snapshot.packed |= static_cast<uint32_t>(in[4 + i]) << (8 * i);
+    }
+    return snapshot;
+  }
+};
+
+#endif // LANDER_INPUT_RECORD_H
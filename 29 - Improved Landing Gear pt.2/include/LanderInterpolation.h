@@ -0,0 +1,50 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_INTERPOLATION_H
+#define LANDER_INTERPOLATION_H
+
+#include "Arduino.h"
+#include "LanderFixed.h"
+#include "LanderGame.h"
+#include "LanderSnapshot.h"
+
+// What the OLED draws in flight.  The radar and gear can sit part way
+// between two ticks; the speed readout is text and always shows the latest.
+struct LanderView {
+  int lander_distance;
+  int lander_speed;
+  int mother_ship_x_offset;
+  int mother_ship_y_offset;
+  int gear_bitmap_index;
+  int previous_gear_bitmap_index;
+  LanderRatio gear_blend;  // 0 shows the previous gear bitmap, 1 the current one
+
+  // Best run's mother ship (see LanderGhost.h), a tick at a time
+  bool ghost_visible;
+  int ghost_distance;
+  int ghost_x_offset;
+  int ghost_y_offset;
+};
+
+// Render interpolation for INTERPOLATE in LanderConfig.h.  Each frame
+// draws the game its share of the way from the state before the latest
+// tick to the state after it, so the mother ship glides a pixel at a time
+// and the gear wipes from one bitmap to the next while the OLED refreshes
+// faster than the game ticks.  The picture runs up to a tick behind the
+// game, which never reads any of it back, so the rules don't change.
+// Fixed point throughout.
+class LanderInterpolation {
+public:
+  // Share of a tick that has passed since_us after it, at most 1
+  static LanderRatio blend(unsigned long since_us);
+
+  // previous is the state before the latest tick, current the game now
+  static LanderView between(const LanderSnapshot& previous, const LanderGame& current, LanderRatio blend);
+
+  // The latest state as it is
+  static LanderView at(const LanderGame& game);
+};
+
+#endif // LANDER_INTERPOLATION_H
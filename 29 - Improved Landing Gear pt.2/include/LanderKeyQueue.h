@@ -0,0 +1,70 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_KEY_QUEUE_H
+#define LANDER_KEY_QUEUE_H
+
+#include "Arduino.h"
+#include "LanderConfig.h"
+#include "LanderTypes.h"
+
+// One keypad press or release as seen by the sampler
+struct KeyEvent {
+  LANDER_CONTROLS key;
+  bool pressed;
+  uint16_t time;  // Low 16 bits of millis() when sampled
+};
+
+// Lock-free ring of key events from the keypad sampler interrupt to the
+// simulation tick.  The interrupt is the only writer of head and the tick
+// the only writer of tail, and each is a single byte, so neither side has
+// to turn interrupts off.  A full ring drops the new event and counts it.
+class LanderKeyQueue {
+public:
+  static_assert(KEY_QUEUE_SIZE > 0 && (KEY_QUEUE_SIZE & (KEY_QUEUE_SIZE - 1)) == 0,
+                "KEY_QUEUE_SIZE must be a power of two");
+
+  // Producer side, from the interrupt
+  bool push(const KeyEvent& event) {
+    const byte position = head;
+    if (static_cast<byte>(position - tail) == KEY_QUEUE_SIZE) {
+      if (overflows != 0xFF) {
+        overflows++;
+      }
+      return false;
+    }
+    events[position & MASK] = event;
+    __atomic_signal_fence(__ATOMIC_RELEASE);  // Event is stored before head moves on
+    head = position + 1;
+    return true;
+  }
+
+  // Consumer side, from the tick.  peek() then pop() so the tick can leave
+  // an event for the next one.
+  bool peek(KeyEvent& event) const {
+    const byte position = tail;
+    if (position == head) {
+      return false;
+    }
+    __atomic_signal_fence(__ATOMIC_ACQUIRE);  // Event is read after head
+    event = events[position & MASK];
+    return true;
+  }
+
+  void pop() { tail = tail + 1; }
+
+  // Events dropped on a full ring since power-up, saturating at 255 so a
+  // read is a single byte
+  byte getOverflows() const { return overflows; }
+
+private:
+  static constexpr byte MASK = KEY_QUEUE_SIZE - 1;
+
+  KeyEvent events[KEY_QUEUE_SIZE];
+  volatile byte head = 0;
+  volatile byte tail = 0;
+  volatile byte overflows = 0;
+};
+
+#endif // LANDER_KEY_QUEUE_H
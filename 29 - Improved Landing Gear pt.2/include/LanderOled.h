@@ -0,0 +1,82 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_OLED_H
+#define LANDER_OLED_H
+
+#include "Arduino.h"
+#include <U8g2lib.h>
+#include "LanderConfig.h"
+#include "LanderTypes.h"
+#include "LanderProfiler.h"
+
+// The U8g2 constructor for each OLED_BUFFER_MODE.  They all draw through
+// the same U8G2 interface; only the buffer and the passes differ.
+template <OLED_BUFFER_MODE MODE>
+struct LanderOledBuffer;
+
+template <>
+struct LanderOledBuffer<OLED_BUFFER_1_PAGE> {
+  typedef U8G2_SH1106_128X64_NONAME_1_HW_I2C Display;
+  static constexpr byte PASSES = 8;
+};
+
+template <>
+struct LanderOledBuffer<OLED_BUFFER_2_PAGE> {
+  typedef U8G2_SH1106_128X64_NONAME_2_HW_I2C Display;
+  static constexpr byte PASSES = 4;
+};
+
+template <>
+struct LanderOledBuffer<OLED_BUFFER_FULL> {
+  typedef U8G2_SH1106_128X64_NONAME_F_HW_I2C Display;
+  static constexpr byte PASSES = 1;
+};
+
+// Buffer-mode policy.  render() runs a draw function once per pass,
+// through firstPage()/nextPage() in the page modes or clearBuffer()/
+// sendBuffer() with the full buffer, so the same screen code builds in
+// any mode.  Drawing and sending are timed separately for LanderProfiler.
+template <OLED_BUFFER_MODE MODE>
+class LanderOled {
+public:
+  typedef typename LanderOledBuffer<MODE>::Display Display;
+
+  static constexpr byte PASSES = LanderOledBuffer<MODE>::PASSES;
+  static constexpr uint16_t BUFFER_BYTES = 1024 / PASSES;  // 128x64 at 1 bit per pixel
+
+  template <typename Draw>
+  static void render(Display& display, const Draw& draw) {
+    if (MODE == OLED_BUFFER_FULL) {
+      const unsigned long drawStarted = LanderProfiler::start();
+      display.clearBuffer();
+      draw();
+      LanderProfiler::stop(PROFILE_DRAW, drawStarted);
+
+      const unsigned long sendStarted = LanderProfiler::start();
+      display.sendBuffer();
+      LanderProfiler::stop(PROFILE_SEND, sendStarted);
+      return;
+    }
+
+    // Draw the exact SAME frame on every pass, each one only keeps its page
+    display.firstPage();
+    bool morePages;
+    do {
+      const unsigned long drawStarted = LanderProfiler::start();
+      draw();
+      LanderProfiler::stop(PROFILE_DRAW, drawStarted);
+
+      // nextPage() sends the finished page over I2C
+      const unsigned long sendStarted = LanderProfiler::start();
+      morePages = display.nextPage();
+      LanderProfiler::stop(PROFILE_SEND, sendStarted);
+    } while (morePages);
+  }
+};
+
+// The policy and display type this build uses, from LanderConfig.h
+typedef LanderOled<OLED_BUFFER> LanderScreen;
+
+#endif // LANDER_OLED_H
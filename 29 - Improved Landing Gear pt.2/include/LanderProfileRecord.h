@@ -0,0 +1,53 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_PROFILE_RECORD_H
+#define LANDER_PROFILE_RECORD_H
+
+#include <stdint.h>
+#include "LanderTypes.h"
+
+// Binary profiler dump format, shared by LanderProfiler and the host
+// decoder.
+//
+// Header (5 bytes): 'L' 'P' version stage_count bucket_count
+// Then for each PROFILE_STAGE in order:
+//   bucket_count uint16 LE sample counts, saturating
+//   uint16 LE longest sample in microseconds, saturating
+//
+// Bucket b counts durations whose bit length is b: 0 us, 1 us, 2-3 us,
+// 4-7 us and so on, with the last bucket taking everything longer.
+class LanderProfileRecord {
+public:
+  static constexpr uint8_t MAGIC_0 = 'L';
+  static constexpr uint8_t MAGIC_1 = 'P';
+  static constexpr uint8_t VERSION = 1;
+  static constexpr uint8_t HEADER_SIZE = 5;
+  static constexpr uint8_t BUCKET_COUNT = 16;
+  static constexpr uint16_t STAGE_SIZE = (BUCKET_COUNT + 1) * 2;
+
+  static uint8_t bucket(uint32_t micros) {
+    uint8_t bucket = 0;
+    while (micros != 0 && bucket < BUCKET_COUNT - 1) {
+      micros >>= 1;
+      bucket++;
+    }
+    return bucket;
+  }
+
+  // Shortest duration counted in a bucket
+  static uint32_t bucketStart(const uint8_t bucket) {
+    return bucket == 0 ? 0 : 1UL << (bucket - 1);
+  }
+
+  static void writeHeader(uint8_t* out) {
+    out[0] = MAGIC_0;
+    out[1] = MAGIC_1;
+    out[2] = VERSION;
+    out[3] = PROFILE_STAGE_COUNT;
+    out[4] = BUCKET_COUNT;
+  }
+};
+
+#endif // LANDER_PROFILE_RECORD_H
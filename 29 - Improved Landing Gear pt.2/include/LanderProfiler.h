@@ -0,0 +1,45 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_PROFILER_H
+#define LANDER_PROFILER_H
+
+#include "Arduino.h"
+#include "LanderConfig.h"
+#include "LanderTypes.h"
+#include "LanderProfileRecord.h"
+
+// Per-stage frame timing.  Each stage keeps a log2 histogram of its
+// micros() durations, so a long run still fits in a few bytes per stage
+// and the host can work out percentiles (see LanderProfileRecord.h).
+// Everything compiles away when PROFILER is off in LanderConfig.h.
+class LanderProfiler {
+public:
+  // Time a stage: start() before it, stop() after it
+  static unsigned long start() { return PROFILER ? micros() : 0; }
+
+  static void stop(const PROFILE_STAGE stage, const unsigned long started) {
+    if (PROFILER) {
+      record(stage, micros() - started);
+    }
+  }
+
+  static void record(PROFILE_STAGE stage, unsigned long duration);
+
+  // Dump and clear the histograms once PROFILER_DUMP_COMMAND arrives
+  static void poll(Stream& serial);
+
+  static void dump(Print& out);
+  static void clear();
+
+private:
+  static constexpr byte STAGE_SLOTS = PROFILER ? PROFILE_STAGE_COUNT : 1;
+
+  static uint16_t counts[STAGE_SLOTS][LanderProfileRecord::BUCKET_COUNT];
+  static uint16_t longest[STAGE_SLOTS];
+
+  static void writeWord(Print& out, uint16_t value);
+};
+
+#endif // LANDER_PROFILER_H
@@ -0,0 +1,140 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_RADAR_LAYOUT_H
+#define LANDER_RADAR_LAYOUT_H
+
+#include "LanderConfig.h"
+#include "radarArrows.h"
+
+// Radar geometry for LanderDisplay::displayInFlight(), worked out by the
+// compiler from LanderConfig.h and kept in PROGMEM, so drawing a page only
+// reads a few bytes back.  Change the constants there and the tables and
+// the checks below follow.  Only included by LanderDisplay.cpp.
+
+// Mother ship initially appears as a single dot, but expands into a rectangle
+// as we get closer.  Scaled based on the maximum width, from 1 to MAX.
+constexpr unsigned int SEGMENT_SIZE = INITIAL_DISTANCE / (MAX_MOTHER_SHIP_WIDTH - 1);
+constexpr byte RADAR_SIZE_COUNT = INITIAL_DISTANCE / SEGMENT_SIZE + 1;
+
+// Radar sits in the centre of the left half, the right half is text and gear
+constexpr byte RADAR_AREA_WIDTH = DISPLAY_WIDTH / 2;
+constexpr byte RADAR_CENTER_X = RADAR_AREA_WIDTH / 2;
+constexpr byte RADAR_CENTER_Y = DISPLAY_HEIGHT / 2;
+
+// Arrows are centred just outside the circle, diagonals at radius / sqrt(2)
+constexpr int RADAR_ARROW_REACH = RADAR_RADIUS + 1;
+constexpr int RADAR_ARROW_DIAGONAL_REACH = RADAR_ARROW_REACH * 181 / 256;
+
+// Mother ship frame for one distance bucket, placed for offsets of 0
+struct RadarShipSize {
+  byte left;
+  byte top;
+  byte width;
+  byte height;
+};
+
+// Drift arrow for one pair of offset signs, no bitmap when centred
+struct RadarArrow {
+  const unsigned char* bitmap;
+  byte x;
+  byte y;
+};
+
+struct RadarShipSizes {
+  RadarShipSize sizes[RADAR_SIZE_COUNT];
+};
+
+struct RadarArrows {
+  RadarArrow arrows[9];
+};
+
+// Subtract the bucket from the full size, always at least 1 pixel
+constexpr int radarShipExtent(const int full, const int bucket) {
+  return full - bucket < 1 ? 1 : full - bucket;
+}
+
+constexpr RadarShipSize radarShipSize(const int bucket) {
+  return {
+    static_cast<byte>(RADAR_CENTER_X - radarShipExtent(MAX_MOTHER_SHIP_WIDTH, bucket) / 2),
+    static_cast<byte>(RADAR_CENTER_Y - radarShipExtent(MAX_MOTHER_SHIP_HEIGHT, bucket) / 2),
+    static_cast<byte>(radarShipExtent(MAX_MOTHER_SHIP_WIDTH, bucket)),
+    static_cast<byte>(radarShipExtent(MAX_MOTHER_SHIP_HEIGHT, bucket)),
+  };
+}
+
+// -1, 0 or 1 for each offset, as in the mother ship offsets
+constexpr int radarArrowIndex(const int x_sign, const int y_sign) {
+  return (x_sign + 1) * 3 + (y_sign + 1);
+}
+
+constexpr int radarArrowReach(const int x_sign, const int y_sign) {
+  return x_sign != 0 && y_sign != 0 ? RADAR_ARROW_DIAGONAL_REACH : RADAR_ARROW_REACH;
+}
+
+constexpr int radarArrowX(const int x_sign, const int y_sign) {
+  return RADAR_CENTER_X + x_sign * radarArrowReach(x_sign, y_sign) - ARROW_SIZE_X / 2;
+}
+
+constexpr int radarArrowY(const int x_sign, const int y_sign) {
+  return RADAR_CENTER_Y + y_sign * radarArrowReach(x_sign, y_sign) - ARROW_SIZE_Y / 2;
+}
+
+constexpr const unsigned char* radarArrowBitmap(const int x_sign, const int y_sign) {
+  return x_sign < 0 ? (y_sign < 0 ? ARROW_UP_LEFT : y_sign > 0 ? ARROW_DOWN_LEFT : ARROW_LEFT)
+       : x_sign > 0 ? (y_sign < 0 ? ARROW_UP_RIGHT : y_sign > 0 ? ARROW_DOWN_RIGHT : ARROW_RIGHT)
+       : (y_sign < 0 ? ARROW_UP : y_sign > 0 ? ARROW_DOWN : nullptr);
+}
+
+constexpr RadarShipSizes makeRadarShipSizes() {
+  RadarShipSizes table = {};
+  for (int bucket = 0; bucket < RADAR_SIZE_COUNT; bucket++) {
+    table.sizes[bucket] = radarShipSize(bucket);
+  }
+  return table;
+}
+
+constexpr RadarArrows makeRadarArrows() {
+  RadarArrows table = {};
+  for (int x_sign = -1; x_sign <= 1; x_sign++) {
+    for (int y_sign = -1; y_sign <= 1; y_sign++) {
+      table.arrows[radarArrowIndex(x_sign, y_sign)] = {
+        radarArrowBitmap(x_sign, y_sign),
+        static_cast<byte>(radarArrowX(x_sign, y_sign)),
+        static_cast<byte>(radarArrowY(x_sign, y_sign)),
+      };
+    }
+  }
+  return table;
+}
+
+// Layout checks
+constexpr bool radarArrowsOnScreen() {
+  for (int x_sign = -1; x_sign <= 1; x_sign++) {
+    for (int y_sign = -1; y_sign <= 1; y_sign++) {
+      const int x = radarArrowX(x_sign, y_sign);
+      const int y = radarArrowY(x_sign, y_sign);
+      if (x < 0 || x + ARROW_SIZE_X > RADAR_AREA_WIDTH || y < 0 || y + ARROW_SIZE_Y > DISPLAY_HEIGHT) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static_assert(RADAR_SIZE_COUNT >= MAX_MOTHER_SHIP_WIDTH,
+              "Every mother ship width needs a distance bucket");
+static_assert(RADAR_CENTER_X >= RADAR_RADIUS && RADAR_CENTER_X + RADAR_RADIUS < RADAR_AREA_WIDTH,
+              "Radar circle runs out of the left half of the display");
+static_assert(RADAR_CENTER_Y >= RADAR_RADIUS && RADAR_CENTER_Y + RADAR_RADIUS < DISPLAY_HEIGHT,
+              "Radar circle runs off the top or bottom of the display");
+static_assert(RADAR_CENTER_X - MAX_DRIFT - MAX_MOTHER_SHIP_WIDTH / 2 >= 0 &&
+              RADAR_CENTER_X + MAX_DRIFT + (MAX_MOTHER_SHIP_WIDTH + 1) / 2 <= RADAR_AREA_WIDTH,
+              "Mother ship drifts out of the left half of the display");
+static_assert(RADAR_CENTER_Y - MAX_DRIFT - MAX_MOTHER_SHIP_HEIGHT / 2 >= 0 &&
+              RADAR_CENTER_Y + MAX_DRIFT + (MAX_MOTHER_SHIP_HEIGHT + 1) / 2 <= DISPLAY_HEIGHT,
+              "Mother ship drifts off the top or bottom of the display");
+static_assert(radarArrowsOnScreen(), "Drift arrows run off the radar half of the display");
+
+#endif // LANDER_RADAR_LAYOUT_H
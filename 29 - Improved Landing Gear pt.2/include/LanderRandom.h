@@ -0,0 +1,77 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_RANDOM_H
+#define LANDER_RANDOM_H
+
+#include <stdint.h>
+
+// Counter-based random numbers for the mother ship drift, in the style of
+// SplitMix: a Weyl sequence (state += gamma every draw) run through a
+// 32-bit hash.  Draw n only depends on state + n * gamma, so jumping ahead
+// is a single multiply, and each odd gamma walks its own stream, so
+// simulations can hand every run or lane an independent reproducible
+// stream.  A draw is two 32-bit multiplies and some shifts, where the AVR
+// random(min, max) needs two 32-bit software divisions per value.
+class LanderRandom {
+public:
+  explicit LanderRandom(const uint32_t seed = 0, const uint32_t stream = 0) :
+      state(mix(seed)), gamma(makeGamma(seed, stream)) {}
+
+  uint32_t next() {
+    state += gamma;
+    return mix(state);
+  }
+
+  // Skip ahead as if next() had been called steps times
+  void jump(const uint32_t steps) { state += steps * gamma; }
+
+  // A new generator independent of this one, which moves on two draws
+  LanderRandom split() {
+    const uint32_t seed = next();
+    return LanderRandom(seed, next());
+  }
+
+  // Both drifts for a tick from one draw
+  void nextDrift(const uint8_t drift_control, int8_t& drift_x, int8_t& drift_y) {
+    const uint32_t bits = next();
+    drift_x = drift(static_cast<uint16_t>(bits), drift_control);
+    drift_y = drift(static_cast<uint16_t>(bits >> 16), drift_control);
+  }
+
+  // -1, 0 or 1 with the odds of random(-1, drift_control) with anything
+  // over 1 folded to 0, from 16 random bits and without branches.  The top
+  // bits pick one of drift_control + 1 values, and only the first and third
+  // of those drift.  For the default 3 that is simply bit 15 - bit 14.
+  static int8_t drift(const uint16_t bits, const uint8_t drift_control) {
+    if (drift_control == 3) {
+      return static_cast<int8_t>((bits >> 15) - ((bits >> 14) & 1));
+    }
+    const uint8_t value = static_cast<uint8_t>((static_cast<uint32_t>(bits) * (drift_control + 1)) >> 16);
+    return static_cast<int8_t>((value == 2) - (value == 0));
+  }
+
+  // Chris Wellons' lowbias32 hash
+  static uint32_t mix(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352DUL;
+    x ^= x >> 15;
+    x *= 0x846CA68BUL;
+    x ^= x >> 16;
+    return x;
+  }
+
+  uint32_t getState() const { return state; }
+  uint32_t getGamma() const { return gamma; }
+
+private:
+  uint32_t state;
+  uint32_t gamma;  // Always odd, so the sequence visits every state
+
+  static uint32_t makeGamma(const uint32_t seed, const uint32_t stream) {
+    return mix(mix(stream + 0x9E3779B9UL) ^ seed) | 1;
+  }
+};
+
+#endif // LANDER_RANDOM_H
@@ -0,0 +1,57 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_REWIND_H
+#define LANDER_REWIND_H
+
+#include "LanderConfig.h"
+#include "LanderGame.h"
+
+// Ring of LanderGame snapshots, one per tick, for the last REWIND_TICKS
+// ticks.  Holding the rewind chord steps the game back a tick at a time
+// for as long as the ring reaches.  Costs 8 bytes a tick when REWIND is
+// on in LanderConfig.h, 8 bytes in all when off.
+class LanderRewind {
+public:
+  static constexpr byte SLOTS = REWIND ? REWIND_TICKS : 1;
+
+  // Keep the state after this tick's update()
+  void save(const LanderGame& game) {
+    ring[head] = game.save();
+    head = next(head);
+    if (count < SLOTS) {
+      count++;
+    }
+  }
+
+  // Drop the newest snapshot and put the game back to the one before it.
+  // The oldest snapshot is never dropped, so holding the chord stops there.
+  // Returns false once nothing older is left.
+  bool stepBack(LanderGame& game, const unsigned long now) {
+    if (count < 2) {
+      return false;
+    }
+    head = previous(head);
+    count--;
+    game.restore(ring[previous(head)], now);
+    return true;
+  }
+
+  void clear() {
+    head = 0;
+    count = 0;
+  }
+
+  byte getCount() const { return count; }
+
+private:
+  LanderSnapshot ring[SLOTS];
+  byte head = 0;   // Where the next snapshot goes
+  byte count = 0;
+
+  static byte next(const byte slot) { return slot + 1 == SLOTS ? 0 : slot + 1; }
+  static byte previous(const byte slot) { return slot == 0 ? SLOTS - 1 : slot - 1; }
+};
+
+#endif // LANDER_REWIND_H
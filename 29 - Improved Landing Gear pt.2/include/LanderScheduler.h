@@ -0,0 +1,61 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_SCHEDULER_H
+#define LANDER_SCHEDULER_H
+
+#include "Arduino.h"
+
+// A periodic task run by the scheduler.  Deadlines are tracked in micros()
+// so they stay correct across the ~70 minute wrap.
+struct LanderTask {
+  const __FlashStringHelper* name;
+  void (*callback)();
+  unsigned long period;       // Microseconds between releases
+  unsigned long nextRelease;  // micros() value the task is next due at
+  bool catchUp;               // Re-run missed releases (fixed timestep) instead of skipping them
+
+  // Statistics for the current report window
+  unsigned int runs;
+  unsigned int missed;       // Releases that finished after their deadline or were skipped
+  long minSlack;             // Smallest time left before the deadline, negative when missed
+  unsigned long maxRunTime;  // Longest single run
+};
+
+// Cooperative fixed-period scheduler.  Each task is released every period
+// and must finish before its next release; anything left over is slack.
+class LanderScheduler {
+public:
+  static constexpr byte MAX_TASKS = 4;
+  static constexpr byte MAX_CATCH_UP = 4;  // Cap on back-to-back catch-up runs per task
+
+  // Register a task.  The first release happens one period after start().
+  static bool addTask(
+      const __FlashStringHelper* name,
+      void (*callback)(),
+      unsigned long period_ms,
+      bool catchUp
+  );
+
+  static void start();
+
+  // Run every task that is due.  Call as often as possible from loop().
+  // True when at least one task ran.
+  static bool runPending();
+
+  // Print per-task runs, missed deadlines, slack and load, then reset the window.
+  static void report(Print& out);
+
+private:
+  static LanderTask tasks[MAX_TASKS];
+  static byte taskCount;
+
+  static unsigned long windowStart;
+  static unsigned long busyTime;
+
+  static void runTask(LanderTask& task, unsigned long now);
+  static void resetStatistics();
+};
+
+#endif // LANDER_SCHEDULER_H
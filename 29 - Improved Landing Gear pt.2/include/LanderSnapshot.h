@@ -0,0 +1,43 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_SNAPSHOT_H
+#define LANDER_SNAPSHOT_H
+
+#include <stdint.h>
+
+// The whole LanderGame state in 8 bytes, for the rewind ring and for
+// cloning games in host simulations (see LanderGame::save() and restore()).
+// LanderGame itself takes 24 bytes on the AVR, where its enums are ints and
+// both times are 32-bit, so a snapshot is 3 times smaller.  Only the ending
+// screen's view timer is left out; a restored ending starts on the splash.
+//
+// Distance and speed keep their raw fixed-point values, everything else
+// shares one word:
+//   bits 0-5   mother ship x offset + MAX_DRIFT
+//   bits 6-11  mother ship y offset + MAX_DRIFT
+//   bits 12-14 APPROACH_STATE
+//   bits 15-16 gear bitmap index
+//   bits 17-18 GEAR_STATE + 1
+//   bits 19-31 ticks since the approach started + 1, or 0 before the first
+//              thrust.  Saturates after about 13 minutes at 100 ms ticks.
+// The time of the snapshot itself is not kept; restore() is given the
+// current time and moves the approach start to keep the elapsed time.
+struct LanderSnapshot {
+  int16_t distance_raw;
+  int16_t speed_raw;
+  uint32_t packed;
+
+  static constexpr uint8_t OFFSET_BITS = 6;
+  static constexpr uint8_t Y_OFFSET_SHIFT = 6;
+  static constexpr uint8_t APPROACH_SHIFT = 12;
+  static constexpr uint8_t GEAR_INDEX_SHIFT = 15;
+  static constexpr uint8_t GEAR_STATE_SHIFT = 17;
+  static constexpr uint8_t ELAPSED_SHIFT = 19;
+  static constexpr uint32_t ELAPSED_MAX = (1UL << (32 - ELAPSED_SHIFT)) - 1;
+};
+
+static_assert(sizeof(LanderSnapshot) == 8, "LanderSnapshot should pack into 8 bytes");
+
+#endif // LANDER_SNAPSHOT_H
@@ -0,0 +1,39 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_TELEMETRY_H
+#define LANDER_TELEMETRY_H
+
+#include "Arduino.h"
+#include "LanderConfig.h"
+#include "LanderGame.h"
+#include "LanderTelemetryRecord.h"
+
+// Streams a framed record of the game state every simulation tick (see
+// LanderTelemetryRecord.h and host/telemetry_cli.cpp).  Frames are encoded
+// into one of two buffers while the other is still going out, and pump()
+// only ever hands Serial as many bytes as its transmit buffer has room
+// for, so a slow link costs frames instead of stalling the tick.  The host
+// sees lost frames as gaps in the tick count.  Turned on by TELEMETRY in
+// LanderConfig.h.
+class LanderTelemetry {
+public:
+  // Queue the state after a tick that took tick_us to run
+  static void record(const LanderGame& game, unsigned long tick_us);
+
+  // Move what fits of the current frame into the Serial transmit buffer
+  static void pump();
+
+private:
+  static constexpr byte BUFFER_SIZE = TELEMETRY ? LanderTelemetryRecord::FRAME_SIZE : 1;
+
+  static byte frames[2][BUFFER_SIZE];
+  static byte frameLength[2];
+  static byte sending;     // Buffer going out, the other one is filled
+  static byte sent;        // Bytes of the sending buffer already written
+  static bool queued;      // A full frame waits in the other buffer
+  static uint16_t tick;
+};
+
+#endif // LANDER_TELEMETRY_H
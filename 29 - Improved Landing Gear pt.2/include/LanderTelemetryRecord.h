@@ -0,0 +1,120 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_TELEMETRY_RECORD_H
+#define LANDER_TELEMETRY_RECORD_H
+
+#include <stdint.h>
+#include "LanderTypes.h"
+
+// Game state after one simulation tick
+struct TelemetryFrame {
+  uint16_t tick;             // Wraps, so the host can spot lost frames
+  APPROACH_STATE approach_state;
+  uint8_t gear_index;
+  int16_t distance_raw;      // LanderDistance::toRaw(), Q12.4
+  int16_t speed_raw;         // LanderSpeed::toRaw(), Q8.8
+  int8_t x_offset;
+  int8_t y_offset;
+  uint16_t tick_us;          // Time the tick took on the device, saturating
+};
+
+// Telemetry wire format, shared by LanderTelemetry and the host decoder.
+//
+// Record (11 bytes, little endian):
+//   tick(uint16) state/gear(uint8: state in bits 0-2, gear index in bits 3-4)
+//   distance(int16) speed(int16) x_offset(int8) y_offset(int8) tick_us(uint16)
+// followed by a CRC-8 (polynomial 0x07) of those bytes.  The 12 bytes are
+// COBS encoded and ended with a 0x00, so a receiver can pick up at any
+// frame boundary and a bad frame never costs more than itself.
+class LanderTelemetryRecord {
+public:
+  static constexpr uint8_t RECORD_SIZE = 11;
+  static constexpr uint8_t PAYLOAD_SIZE = RECORD_SIZE + 1;     // With the CRC
+  static constexpr uint8_t FRAME_SIZE = PAYLOAD_SIZE + 2;      // COBS overhead byte and delimiter
+
+  static void pack(uint8_t* out, const TelemetryFrame& frame) {
+    out[0] = frame.tick & 0xFF;
+    out[1] = frame.tick >> 8;
+    out[2] = static_cast<uint8_t>((frame.approach_state & 0x07) | ((frame.gear_index & 0x03) << 3));
+    out[3] = static_cast<uint16_t>(frame.distance_raw) & 0xFF;
+    out[4] = static_cast<uint16_t>(frame.distance_raw) >> 8;
+    out[5] = static_cast<uint16_t>(frame.speed_raw) & 0xFF;
+    out[6] = static_cast<uint16_t>(frame.speed_raw) >> 8;
+    out[7] = static_cast<uint8_t>(frame.x_offset);
+    out[8] = static_cast<uint8_t>(frame.y_offset);
+    out[9] = frame.tick_us & 0xFF;
+    out[10] = frame.tick_us >> 8;
+  }
+
+  static TelemetryFrame unpack(const uint8_t* in) {
+    TelemetryFrame frame;
+    frame.tick = static_cast<uint16_t>(in[0] | (in[1] << 8));
+    frame.approach_state = static_cast<APPROACH_STATE>(in[2] & 0x07);
+    frame.gear_index = (in[2] >> 3) & 0x03;
+    frame.distance_raw = static_cast<int16_t>(in[3] | (in[4] << 8));
+    frame.speed_raw = static_cast<int16_t>(in[5] | (in[6] << 8));
+    frame.x_offset = static_cast<int8_t>(in[7]);
+    frame.y_offset = static_cast<int8_t>(in[8]);
+    frame.tick_us = static_cast<uint16_t>(in[9] | (in[10] << 8));
+    return frame;
+  }
+
+  static uint8_t crc8(const uint8_t* data, const uint8_t length) {
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < length; i++) {
+      crc ^= data[i];
+      for (uint8_t bit = 0; bit < 8; bit++) {
+        crc = crc & 0x80 ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+      }
+    }
+    return crc;
+  }
+
+  // COBS encode length bytes (at most 254) into out, adding the 0x00
+  // delimiter.  Returns the frame length, length + 2.
+  static uint8_t encode(const uint8_t* in, const uint8_t length, uint8_t* out) {
+    uint8_t code_index = 0;
+    uint8_t code = 1;
+    uint8_t written = 1;
+
+    for (uint8_t i = 0; i < length; i++) {
+      if (in[i] == 0) {
+        out[code_index] = code;
+        code_index = written++;
+        code = 1;
+      } else {
+        out[written++] = in[i];
+        code++;
+      }
+    }
+
+    out[code_index] = code;
+    out[written++] = 0;
+    return written;
+  }
+
+  // Undo encode() on a frame without its delimiter.  Returns the decoded
+  // length, or 0 when the frame is malformed.
+  static uint8_t decode(const uint8_t* in, const uint8_t length, uint8_t* out) {
+    uint8_t read = 0;
+    uint8_t written = 0;
+
+    while (read < length) {
+      const uint8_t code = in[read++];
+      if (code == 0 || read + code - 1 > length) {
+        return 0;
+      }
+      for (uint8_t i = 1; i < code; i++) {
+        out[written++] = in[read++];
+      }
+      if (code < 0xFF && read < length) {
+        out[written++] = 0;
+      }
+    }
+    return written;
+  }
+};
+
+#endif // LANDER_TELEMETRY_RECORD_H
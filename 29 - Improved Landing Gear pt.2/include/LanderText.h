@@ -0,0 +1,72 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#ifndef LANDER_TEXT_H
+#define LANDER_TEXT_H
+
+#include "Arduino.h"
+
+// A line of text built on the stack for drawStr(), in place of String.
+// Labels are copied straight out of flash (F()), numbers are formatted
+// without printf, and nothing touches the heap.  Text past CAPACITY is
+// cut off.
+template <byte CAPACITY>
+class LanderText {
+public:
+  LanderText() : length(0) { text[0] = '\0'; }
+
+  LanderText& add(const __FlashStringHelper* string) {
+    const char* next = reinterpret_cast<const char*>(string);
+    char c;
+    while (length < CAPACITY && (c = static_cast<char>(pgm_read_byte(next++))) != '\0') {
+      text[length++] = c;
+    }
+    text[length] = '\0';
+    return *this;
+  }
+
+  // Decimal value right aligned in at least width characters, as printf's
+  // %*ld or, with a fill of '0', %0*ld
+  LanderText& addNumber(const long value, const byte width = 0, const char fill = ' ') {
+    unsigned long magnitude = value < 0 ? 0UL - static_cast<unsigned long>(value) : value;
+
+    char digits[10];
+    byte count = 0;
+    do {
+      digits[count++] = static_cast<char>('0' + magnitude % 10);
+      magnitude /= 10;
+    } while (magnitude != 0);
+
+    const byte used = count + (value < 0);
+    if (value < 0 && fill == '0') {
+      addChar('-');
+    }
+    for (byte i = used; i < width; i++) {
+      addChar(fill);
+    }
+    if (value < 0 && fill != '0') {
+      addChar('-');
+    }
+    while (count > 0) {
+      addChar(digits[--count]);
+    }
+
+    text[length] = '\0';
+    return *this;
+  }
+
+  const char* c_str() const { return text; }
+
+private:
+  char text[CAPACITY + 1];
+  byte length;
+
+  void addChar(const char c) {
+    if (length < CAPACITY) {
+      text[length++] = c;
+    }
+  }
+};
+
+#endif // LANDER_TEXT_H
@@ -5,6 +5,8 @@
 #ifndef LANDER_TYPES_H
 #define LANDER_TYPES_H
 
+#include <stdint.h>
+
 // Gear states with defined values used to change bitmap index.
 enum GEAR_STATE {
   GEAR_IDLE = 0,      // Landing gear idle.  Don't change index when added to current
@@ -38,7 +40,54 @@ enum APPROACH_STATE {
   APPROACH_INIT,       // Ensure all switches are off to begin
   APPROACH_PREFLIGHT,  // Wait for all switches to be enabled
   APPROACH_IN_FLIGHT,  // Begin to approach mother ship
-  APPROACH_FINAL       // Lower landing gear!
+  APPROACH_FINAL,      // Lower landing gear!
+  APPROACH_ENDING      // Touched down, show the outcome until the levers restart
+};
+
+// How the approach ended.  Each outcome has its own ending bitmap.
+enum ENDING_OUTCOME {
+  ENDING_SUCCESS,             // Slow enough, on target, gear down
+  ENDING_NO_GEAR,             // Landed with the gear up
+  ENDING_TOO_FAST,            // Hit the bay above the safe landing speed
+  ENDING_MISSED_MOTHER_SHIP   // Drifted outside the landing bay
+};
+
+// Where the per-tick input log goes.
+enum INPUT_LOG_MODE {
+  INPUT_LOG_OFF,
+  INPUT_LOG_SERIAL,  // Stream each tick over Serial as it happens
+  INPUT_LOG_RING     // Keep the last ticks in RAM, dumped over Serial at game over
+};
+
+// How much of the OLED the U8g2 buffer holds, see LanderOled.h.
+enum OLED_BUFFER_MODE {
+  OLED_BUFFER_1_PAGE,  // 128 bytes, 8 passes per frame
+  OLED_BUFFER_2_PAGE,  // 256 bytes, 4 passes per frame
+  OLED_BUFFER_FULL     // 1 KB, one pass per frame
+};
+
+// Frame stages timed by LanderProfiler, in dump order.
+enum PROFILE_STAGE {
+  PROFILE_INPUT,     // LanderHardware::readInputFrame()
+  PROFILE_UPDATE,    // LanderGame::update()
+  PROFILE_DRAW,      // Drawing one OLED page into the page buffer
+  PROFILE_SEND,      // Sending that page over I2C, inside nextPage()
+  PROFILE_DISTANCE,  // LanderHardware::showDistance(), the TM1637 bit-bang
+  PROFILE_IDLE,      // Waiting in loop() with no task due
+  PROFILE_STAGE_COUNT
+};
+
+// Everything LanderGame reads from the outside world during one tick.  Feeding
+// the same frames back into LanderGame::update() replays a game exactly.
+struct InputFrame {
+  bool thrust_lever;
+  bool systems_lever;
+  bool confirm_lever;
+  LANDER_CONTROLS key;  // Key held down at the tick
+  LANDER_CONTROLS tap;  // Key pressed and released since the last tick, acted on first
+  int8_t drift_x;  // Mother ship drift this tick: -1, 0 or 1
+  int8_t drift_y;
+  bool rewind;  // Rewind chord held, the tick steps back instead of updating
 };
 
 #endif // LANDER_TYPES_H
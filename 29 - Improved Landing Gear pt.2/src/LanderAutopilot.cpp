@@ -0,0 +1,83 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#include "LanderAutopilot.h"
+#include "LanderAutopilotPolicy.h"
+#include "LanderGame.h"
+
+LANDER_CONTROLS LanderAutopilot::toControl(const byte action, const int x_offset, const int y_offset) {
+    switch (action) {
+        case ACTION_NONE:
+            return UNUSED;
+        case ACTION_RAISE_SPEED:
+            return RAISE_SPEED;
+        case ACTION_LOWER_SPEED:
+            return LOWER_SPEED;
+        case ACTION_LOWER_GEAR:
+            return LOWER_GEAR;
+        default:
+            break;
+    }
+
+    // Back to the cell of steerAction() and then to the signed offsets
+    byte cell = action - ACTION_STEER_FIRST;
+    if (cell >= 4) {
+        cell++;
+    }
+    const int sx = (x_offset < 0 ? -1 : 1) * (cell / 3 - 1);
+    const int sy = (y_offset < 0 ? -1 : 1) * (cell % 3 - 1);
+
+    // STEER_LEFT and STEER_UP raise the offsets, see processSteeringState()
+    if (sy > 0) {
+        return sx > 0 ? STEER_UP_LEFT : sx < 0 ? STEER_UP_RIGHT : STEER_UP;
+    }
+    if (sy < 0) {
+        return sx > 0 ? STEER_DOWN_LEFT : sx < 0 ? STEER_DOWN_RIGHT : STEER_DOWN;
+    }
+    return sx > 0 ? STEER_LEFT : STEER_RIGHT;
+}
+
+byte LanderAutopilot::lookup(
+    const uint8_t* cells, const uint16_t* runStarts, const uint16_t runStartCount,
+    const uint8_t* patterns, const uint8_t* rows, const uint16_t cell, const byte offset
+) {
+    // Last indexed run starting at or before the cell, runStarts[0] is 0
+    uint16_t low = 0;
+    uint16_t high = runStartCount;
+    while (high - low > 1) {
+        const uint16_t middle = (low + high) / 2;
+        if (pgm_read_word(&runStarts[middle]) <= cell) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    // Then walk at most RUN_STRIDE runs to the one holding the cell
+    cells += low * RUN_STRIDE * 2;
+    uint16_t position = pgm_read_word(&runStarts[low]);
+    byte pattern;
+    do {
+        pattern = pgm_read_byte(cells++);
+        position += pgm_read_byte(cells++);
+    } while (position <= cell);
+
+    const byte x = offset / OFFSET_CLASSES;
+    const byte y = offset % OFFSET_CLASSES;
+    const byte row = pgm_read_byte(&patterns[pattern * OFFSET_CLASSES + x]);
+    const byte packed = pgm_read_byte(&rows[row * ROW_BYTES + y / 2]);
+    return y & 1 ? packed & 0x0F : packed >> 4;
+}
+
+LANDER_CONTROLS LanderAutopilot::choose(const LanderGame& game) {
+    const int x = game.getMotherShipXOffset();
+    const int y = game.getMotherShipYOffset();
+    const byte phase = gearPhase(game.getCurrentGearBitmapIndex(), game.getApproachState() == APPROACH_FINAL);
+    const uint16_t cell = cellIndex(game.getLanderDistance(), game.getLanderSpeed(), phase);
+
+    const byte action = lookup(AUTOPILOT_CELLS, AUTOPILOT_RUN_STARTS,
+                               sizeof(AUTOPILOT_RUN_STARTS) / sizeof(AUTOPILOT_RUN_STARTS[0]),
+                               AUTOPILOT_PATTERNS, AUTOPILOT_ROWS, cell, offsetIndex(x, y));
+    return toControl(action, x, y);
+}
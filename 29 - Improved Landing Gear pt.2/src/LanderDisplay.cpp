@@ -5,7 +5,8 @@
 #include "LanderDisplay.h"
 #include "LanderHardware.h"
 #include "LanderConfig.h"
-#include "radarArrows.h"
+#include "LanderRadarLayout.h"
+#include "LanderText.h"
 #include "smallLandingGearBitmaps.h"
 #include "endingBitmaps.h"
 
@@ -19,29 +20,125 @@ const static unsigned char* GEAR_BITMAPS[] = {
 
 constexpr int GEAR_BITMAP_COUNT = sizeof(GEAR_BITMAPS) / sizeof(GEAR_BITMAPS[0]);
 
+// Characters across the display in u8g2_font_6x10_tr
+constexpr byte LINE_CHARS = DISPLAY_WIDTH / 6;
+
+// Radar layout, see LanderRadarLayout.h
+constexpr RadarShipSizes RADAR_SHIP_SIZES PROGMEM = makeRadarShipSizes();
+constexpr RadarArrows RADAR_ARROWS PROGMEM = makeRadarArrows();
+
+// Static member initialization
+uint16_t LanderDisplay::lastFrameHash = 0;
+LanderRenderKey LanderDisplay::lastFrameKey = {};
+bool LanderDisplay::lastFrameValid = false;
+unsigned int LanderDisplay::framesRendered = 0;
+unsigned int LanderDisplay::framesElided = 0;
+unsigned long LanderDisplay::statsStarted = 0;
+
+LanderRenderKey LanderDisplay::makeRenderKey(
+    const APPROACH_STATE approach_state,
+    const InputFrame& input,
+    const LanderView& view,
+    const bool ending_splash
+) {
+    // The radar half of the ending screen draws just what the final approach
+    // does, so it shares its key.
+    const APPROACH_STATE screen =
+        approach_state == APPROACH_ENDING && !ending_splash ? APPROACH_FINAL : approach_state;
+
+    // Only keep the fields the current screen actually draws, so a change to
+    // something off screen doesn't force a redraw.
+    LanderRenderKey key = {};
+    key.approach_state = screen;
+
+    switch (screen) {
+        case APPROACH_INIT:
+        case APPROACH_PREFLIGHT:
+            key.levers = input.thrust_lever | (input.systems_lever << 1) | (input.confirm_lever << 2);
+            break;
+
+        case APPROACH_FINAL:
+            key.gear_index = view.gear_bitmap_index;
+            key.previous_gear_index = view.previous_gear_bitmap_index;
+            key.gear_wipe = gearWipe(view.gear_bitmap_index, view.previous_gear_bitmap_index, view.gear_blend);
+            [[fallthrough]];
+
+        case APPROACH_IN_FLIGHT:
+            key.distance_bucket = distanceBucket(view.lander_distance);
+            key.speed = view.lander_speed;
+            key.x_offset = view.mother_ship_x_offset;
+            key.y_offset = view.mother_ship_y_offset;
+            if (view.ghost_visible) {
+                key.ghost_visible = true;
+                key.ghost_bucket = distanceBucket(view.ghost_distance);
+                key.ghost_x_offset = view.ghost_x_offset;
+                key.ghost_y_offset = view.ghost_y_offset;
+            }
+            break;
+
+        case APPROACH_ENDING:
+            // Time and outcome are fixed from touchdown to restart
+            break;
+    }
+
+    return key;
+}
+
+bool LanderDisplay::shouldRender(const LanderRenderKey& key) {
+    const uint16_t hash = hashRenderKey(key);
+
+    // Compare the hash first; the full key only settles the rare collision.
+    if (lastFrameValid && hash == lastFrameHash &&
+        memcmp(&key, &lastFrameKey, sizeof(key)) == 0) {
+        framesElided++;
+        return false;
+    }
+
+    lastFrameHash = hash;
+    lastFrameKey = key;
+    lastFrameValid = true;
+    framesRendered++;
+    return true;
+}
+
+void LanderDisplay::reportRenderStats(Print& out) {
+    const unsigned long now = millis();
+    const unsigned long window = now - statsStarted;
+
+    out.print(F("  frames drawn "));
+    out.print(framesRendered);
+    out.print(F(" elided "));
+    out.print(framesElided);
+    out.print(F(", "));
+    out.print(window ? framesRendered * 1000UL / window : 0UL);
+    out.println(F(" fps"));
+
+    framesRendered = 0;
+    framesElided = 0;
+    statsStarted = now;
+}
+
 void LanderDisplay::displayPreFlight(
     const APPROACH_STATE approach_state,
-    const bool thrusterLever,
-    const bool systemsLever,
-    const bool confirmLever
+    const InputFrame& input
 ) {
     // Display all text referenced from upper left bit X, Y
     landerDisplay.setFontPosTop();
 
     // Draw title lines at top of display, updating y_offset afterward
-    byte yOffset = drawString(0, 0, "Exploration Lander");
-    drawString(0, yOffset, "Approach Sequence");
+    byte yOffset = drawString(0, 0, F("Exploration Lander"));
+    drawString(0, yOffset, F("Approach Sequence"));
 
     // Set y_offset to point four lines above bottom of display
     yOffset = landerDisplay.getDisplayHeight() - (4 * landerDisplay.getMaxCharHeight());
 
     // Display status of each switch
-    yOffset = displayLeverSetting("Thrusters: ", thrusterLever, yOffset);
-    yOffset = displayLeverSetting("Systems  : ", systemsLever, yOffset);
-    yOffset = displayLeverSetting("Confirm  : ", confirmLever, yOffset);
+    yOffset = displayLeverSetting(F("Thrusters: "), input.thrust_lever, yOffset);
+    yOffset = displayLeverSetting(F("Systems  : "), input.systems_lever, yOffset);
+    yOffset = displayLeverSetting(F("Confirm  : "), input.confirm_lever, yOffset);
 
     // Display final status line
-    drawString(0, yOffset, (String("Countdown ") + liftoffStateToString(approach_state)).c_str());
+    drawString(0, yOffset, F("Countdown "), liftoffStateToString(approach_state));
 }
 
 void LanderDisplay::displayInFlight(
@@ -50,22 +147,8 @@ void LanderDisplay::displayInFlight(
     const int mother_ship_x_offset,
     const int mother_ship_y_offset
 ) {
-    // Mother ship initially appears as a single dot, but expands into a rectangle
-    // as we get closer.  Scaled based on the maximum width, from 1 to MAX.
-    constexpr unsigned int SEGMENT_SIZE = INITIAL_DISTANCE / (MAX_MOTHER_SHIP_WIDTH - 1);
-    const byte segment_number = lander_distance / SEGMENT_SIZE;
-
-    // subtract segment number from width/height to get visible width (minimum 1)
-    const int mother_ship_width = MAX_MOTHER_SHIP_WIDTH - segment_number;
-    int mother_ship_height = MAX_MOTHER_SHIP_HEIGHT - segment_number;
-
-    if (mother_ship_height < 1) {
-        mother_ship_height = 1;  // Always at least 1 pixel high
-    }
-
-    // coordinates of the center of our radar display
-    const byte RADAR_CENTER_X = (landerDisplay.getDisplayWidth() / 2 / 2);  // center of left half
-    const byte RADAR_CENTER_Y = (landerDisplay.getDisplayHeight() / 2);     // Vertical center
+    RadarShipSize size;
+    memcpy_P(&size, &RADAR_SHIP_SIZES.sizes[distanceBucket(lander_distance)], sizeof(size));
 
     // Display bitmaps with 0 bits set to transparent.
     landerDisplay.setBitmapMode(1);
@@ -74,45 +157,51 @@ void LanderDisplay::displayInFlight(
     landerDisplay.drawCircle(RADAR_CENTER_X, RADAR_CENTER_Y, RADAR_RADIUS);
     landerDisplay.drawPixel(RADAR_CENTER_X, RADAR_CENTER_Y);
 
-    // Draw directional arrows based on drift
-    if (mother_ship_x_offset < -DRIFT_BEFORE_ARROW_X) {  // Left of center
-        if (mother_ship_y_offset < -DRIFT_BEFORE_ARROW_Y) {
-            landerDisplay.drawXBMP(9, 9, ARROW_SIZE_X, ARROW_SIZE_Y, ARROW_UP_LEFT);
-        } else if (mother_ship_y_offset > DRIFT_BEFORE_ARROW_Y) {
-            landerDisplay.drawXBMP(8, 45, ARROW_SIZE_X, ARROW_SIZE_Y, ARROW_DOWN_LEFT);
-        } else {
-            landerDisplay.drawXBMP(1, 27, ARROW_SIZE_X, ARROW_SIZE_Y, ARROW_LEFT);
-        }
-    } else if (mother_ship_x_offset > DRIFT_BEFORE_ARROW_X) {  // Right of center
-        if (mother_ship_y_offset < -DRIFT_BEFORE_ARROW_Y) {
-            landerDisplay.drawXBMP(45, 8, ARROW_SIZE_X, ARROW_SIZE_Y, ARROW_UP_RIGHT);
-        } else if (mother_ship_y_offset > DRIFT_BEFORE_ARROW_Y) {
-            landerDisplay.drawXBMP(45, 45, ARROW_SIZE_X, ARROW_SIZE_Y, ARROW_DOWN_RIGHT);
-        } else {
-            landerDisplay.drawXBMP(53, 27, ARROW_SIZE_X, ARROW_SIZE_Y, ARROW_RIGHT);
-        }
-    } else {  // close to center in X direction
-        if (mother_ship_y_offset < -DRIFT_BEFORE_ARROW_Y) {
-            landerDisplay.drawXBMP(27, 1, ARROW_SIZE_X, ARROW_SIZE_Y, ARROW_UP);
-        } else if (mother_ship_y_offset > DRIFT_BEFORE_ARROW_Y) {
-            landerDisplay.drawXBMP(27, 53, ARROW_SIZE_X, ARROW_SIZE_Y, ARROW_DOWN);
-        }
+    // Draw directional arrow based on drift, none while close to center
+    const int x_sign = mother_ship_x_offset < -DRIFT_BEFORE_ARROW_X ? -1 : mother_ship_x_offset > DRIFT_BEFORE_ARROW_X;
+    const int y_sign = mother_ship_y_offset < -DRIFT_BEFORE_ARROW_Y ? -1 : mother_ship_y_offset > DRIFT_BEFORE_ARROW_Y;
+    RadarArrow arrow;
+    memcpy_P(&arrow, &RADAR_ARROWS.arrows[radarArrowIndex(x_sign, y_sign)], sizeof(arrow));
+    if (arrow.bitmap != nullptr) {
+        landerDisplay.drawXBMP(arrow.x, arrow.y, ARROW_SIZE_X, ARROW_SIZE_Y, arrow.bitmap);
     }
 
     // Display speed in upper right
-    char buffer[9];
-    sprintf(buffer, "SPD: %2d", lander_speed);
-    const u8g2_uint_t width = landerDisplay.getStrWidth(buffer);
-    landerDisplay.drawStr(landerDisplay.getDisplayWidth() - width, 0, buffer);
+    LanderText<8> speed;
+    speed.add(F("SPD: ")).addNumber(lander_speed, 2);
+    const u8g2_uint_t width = landerDisplay.getStrWidth(speed.c_str());
+    landerDisplay.drawStr(landerDisplay.getDisplayWidth() - width, 0, speed.c_str());
 
     // Draw the mother ship as a rectangle
-    const byte x_offset = RADAR_CENTER_X + mother_ship_x_offset - (mother_ship_width / 2);
-    const byte y_offset = RADAR_CENTER_Y + mother_ship_y_offset - (mother_ship_height / 2);
-    landerDisplay.drawFrame(x_offset, y_offset, mother_ship_width, mother_ship_height);
+    landerDisplay.drawFrame(
+        size.left + mother_ship_x_offset, size.top + mother_ship_y_offset,
+        size.width, size.height
+    );
+}
+
+void LanderDisplay::displayGhost(
+    const int ghost_distance,
+    const int ghost_x_offset,
+    const int ghost_y_offset
+) {
+    RadarShipSize size;
+    memcpy_P(&size, &RADAR_SHIP_SIZES.sizes[distanceBucket(ghost_distance)], sizeof(size));
+
+    // Just the corners, so it never hides the real mother ship
+    const byte left = size.left + ghost_x_offset;
+    const byte top = size.top + ghost_y_offset;
+    const byte right = left + size.width - 1;
+    const byte bottom = top + size.height - 1;
+    landerDisplay.drawPixel(left, top);
+    landerDisplay.drawPixel(right, top);
+    landerDisplay.drawPixel(left, bottom);
+    landerDisplay.drawPixel(right, bottom);
 }
 
 void LanderDisplay::displayFinal(
-    const int current_gear_bitmap_index
+    const int current_gear_bitmap_index,
+    const int previous_gear_bitmap_index,
+    const LanderRatio gear_blend
 ) {
     constexpr int gear_down_index = GEAR_BITMAP_COUNT - 1;
 
@@ -121,11 +210,11 @@ void LanderDisplay::displayFinal(
     byte y_offset = landerDisplay.getMaxCharHeight() * 2;
 
     if (current_gear_bitmap_index == 0) {
-        landerDisplay.drawStr(x_offset, y_offset, "Drop gear");
+        drawString(x_offset, y_offset, F("Drop gear"));
     } else if (current_gear_bitmap_index < gear_down_index) {
-        landerDisplay.drawStr(x_offset, y_offset, "Lowering");
+        drawString(x_offset, y_offset, F("Lowering"));
     } else {
-        landerDisplay.drawStr(x_offset, y_offset, "Gear OK");
+        drawString(x_offset, y_offset, F("Gear OK"));
     }
 
     // Calculate position for gear bitmap
@@ -134,80 +223,127 @@ void LanderDisplay::displayFinal(
     y_offset = landerDisplay.getDisplayHeight() - (landerDisplay.getMaxCharHeight() * 3);
     y_offset += ((landerDisplay.getDisplayHeight() - y_offset) - LANDING_GEAR_BITMAP_HEIGHT) / 2;
 
+    const byte wipe = gearWipe(current_gear_bitmap_index, previous_gear_bitmap_index, gear_blend);
+
     // Draw current bitmap centered in lower right quadrant
+    if (wipe >= LANDING_GEAR_BITMAP_HEIGHT) {
+        landerDisplay.drawXBMP(
+            x_offset, y_offset,
+            LANDING_GEAR_BITMAP_WIDTH, LANDING_GEAR_BITMAP_HEIGHT,
+            GEAR_BITMAPS[current_gear_bitmap_index]
+        );
+        return;
+    }
+
+    // Mid-wipe, the current bitmap above the wipe line and the previous one
+    // below it while lowering, the other way round while raising
+    const bool lowering = current_gear_bitmap_index > previous_gear_bitmap_index;
+    const byte split = y_offset + (lowering ? wipe : LANDING_GEAR_BITMAP_HEIGHT - wipe);
+    const byte right = x_offset + LANDING_GEAR_BITMAP_WIDTH;
+
+    landerDisplay.setClipWindow(x_offset, y_offset, right, split);
     landerDisplay.drawXBMP(
         x_offset, y_offset,
         LANDING_GEAR_BITMAP_WIDTH, LANDING_GEAR_BITMAP_HEIGHT,
-        GEAR_BITMAPS[current_gear_bitmap_index]
+        GEAR_BITMAPS[lowering ? current_gear_bitmap_index : previous_gear_bitmap_index]
     );
+    landerDisplay.setClipWindow(x_offset, split, right, y_offset + LANDING_GEAR_BITMAP_HEIGHT);
+    landerDisplay.drawXBMP(
+        x_offset, y_offset,
+        LANDING_GEAR_BITMAP_WIDTH, LANDING_GEAR_BITMAP_HEIGHT,
+        GEAR_BITMAPS[lowering ? previous_gear_bitmap_index : current_gear_bitmap_index]
+    );
+    landerDisplay.setMaxClipWindow();
 }
 
-[[noreturn]] void LanderDisplay::displayEndingScreen(
-    unsigned long elapsed_time,
-    const unsigned char* endingBitmap,
-    int current_gear_bitmap_index,
-    int lander_distance,
-    int lander_speed,
-    int mother_ship_x_offset,
-    int mother_ship_y_offset
+void LanderDisplay::displayEnding(
+    const char* time,
+    const unsigned char* endingBitmap
 ) {
-    char buffer[20];
-    sprintf(buffer, "%4lu.%03lu Sec", elapsed_time / 1000, elapsed_time % 1000);
+    landerDisplay.drawStr(0, 0, time);
+    landerDisplay.drawXBMP(0, 10, ENDING_BITMAP_WIDTH, ENDING_BITMAP_HEIGHT, endingBitmap);
+}
 
-    // Alternate between splash screen with time and final radar view
-    do {
-        landerDisplay.firstPage();
-        do {
-            landerDisplay.drawStr(0, 0, buffer);
-            landerDisplay.drawXBMP(0, 10, ENDING_BITMAP_WIDTH, ENDING_BITMAP_HEIGHT, endingBitmap);
-        } while (landerDisplay.nextPage());
+void LanderDisplay::displayEnding(
+    const unsigned long elapsed_time,
+    const unsigned char* endingBitmap
+) {
+    LanderText<LINE_CHARS> time;
+    time.addNumber(elapsed_time / 1000, 4).add(F(".")).addNumber(elapsed_time % 1000, 3, '0').add(F(" Sec"));
+    displayEnding(time.c_str(), endingBitmap);
+}
 
-        delay(2000);
+// Helper functions
+uint16_t LanderDisplay::hashRenderKey(const LanderRenderKey& key) {
+    // djb2 over the key bytes; cheap on the AVR's 8-bit ALU
+    const auto* bytes = reinterpret_cast<const byte*>(&key);
+    uint16_t hash = 5381;
 
-        landerDisplay.firstPage();
-        do {
-            displayFinal(current_gear_bitmap_index);
-            displayInFlight(lander_distance, lander_speed, mother_ship_x_offset, mother_ship_y_offset);
-        } while (landerDisplay.nextPage());
+    for (byte i = 0; i < sizeof(key); i++) {
+        hash = (hash << 5) + hash + bytes[i];
+    }
 
-        delay(2000);
-    } while (true);
+    return hash;
+}
+
+byte LanderDisplay::distanceBucket(const int lander_distance) {
+    // The ending screen can show a distance just past either end
+    if (lander_distance <= 0) {
+        return 0;
+    }
+    const unsigned int bucket = lander_distance / SEGMENT_SIZE;
+    return bucket < RADAR_SIZE_COUNT ? bucket : RADAR_SIZE_COUNT - 1;
+}
+
+byte LanderDisplay::gearWipe(
+    const int current_gear_bitmap_index,
+    const int previous_gear_bitmap_index,
+    const LanderRatio gear_blend
+) {
+    // Rows of the current bitmap showing, all of them once the wipe is done
+    if (current_gear_bitmap_index == previous_gear_bitmap_index) {
+        return LANDING_GEAR_BITMAP_HEIGHT;
+    }
+    return (LanderRatio::fromInt(LANDING_GEAR_BITMAP_HEIGHT) * gear_blend).floor();
 }
 
-// Helper functions
 byte LanderDisplay::drawString(
     const byte x, const byte y,
-    const char* string
+    const __FlashStringHelper* label,
+    const __FlashStringHelper* value
 ) {
-    landerDisplay.drawStr(x, y, string);
+    // drawStr() wants the text in RAM, so join the two on the stack
+    LanderText<LINE_CHARS> line;
+    line.add(label);
+    if (value != nullptr) {
+        line.add(value);
+    }
+
+    landerDisplay.drawStr(x, y, line.c_str());
     return (y + landerDisplay.getMaxCharHeight());
 }
 
 byte LanderDisplay::displayLeverSetting(
-    const String& leverName,
+    const __FlashStringHelper* leverName,
     const bool leverVal,
     const byte yOffset
 ) {
-    return drawString(
-        0,
-        yOffset,
-        (leverName + onOff(leverVal)).c_str()
-    );
+    return drawString(0, yOffset, leverName, onOff(leverVal));
 }
 
-String LanderDisplay::onOff(const bool val) {
-    return val ? "ON" : "OFF";
+const __FlashStringHelper* LanderDisplay::onOff(const bool val) {
+    return val ? F("ON") : F("OFF");
 }
 
-String LanderDisplay::liftoffStateToString(
+const __FlashStringHelper* LanderDisplay::liftoffStateToString(
     const APPROACH_STATE approach_state
 ) {
     switch (approach_state) {
         case APPROACH_INIT:
-            return ("Init");
+            return F("Init");
         case APPROACH_PREFLIGHT:
-            return ("Preflight");
+            return F("Preflight");
         default:
-            return ("");
+            return F("");
     }
 }
@@ -7,38 +7,49 @@
 //
 
 #include "LanderGame.h"
-#include "LanderHardware.h"
 #include "LanderConfig.h"
 #include "endingBitmaps.h"
 
 constexpr int GEAR_BITMAP_COUNT = 4;  // Number of gear animation frames
+constexpr LanderRatio TICK_DRAG = DRAG * TICK_SCALE;  // Share of speed lost per tick
+constexpr uint8_t ENDING_VIEW_TICKS = ENDING_VIEW_MS / SIMULATION_TICK_MS;
+
+static_assert(ENDING_VIEW_TICKS > 0 && ENDING_VIEW_TICKS < 128,
+              "ENDING_VIEW_MS must be from one tick to 127 ticks");
 
 LanderGame::LanderGame() :
     approach_state(APPROACH_INIT),
     gear_state(GEAR_IDLE),
     approachStartTime(0),
+    lastUpdateTime(0),
     current_gear_bitmap_index(0),
-    lander_distance(INITIAL_DISTANCE),
-    lander_speed(0),
+    lander_distance(LanderDistance::fromInt(INITIAL_DISTANCE)),
+    lander_speed(),
     mother_ship_x_offset(0),
-    mother_ship_y_offset(0)
+    mother_ship_y_offset(0),
+    ending_tick(0),
+    restart_armed(false)
 {
 }
 
-void LanderGame::update() {
-    // Read current values of all switches
-    const bool thrust_lever = LanderHardware::getThrustLever();
-    const bool systems_lever = LanderHardware::getSystemsLever();
-    const bool confirm_lever = LanderHardware::getConfirmLever();
+void LanderGame::update(const InputFrame& input, const unsigned long now) {
+    // The ending keeps the state and time of touchdown for the outcome and
+    // the ending screen, until the levers restart the game
+    if (approach_state == APPROACH_ENDING) {
+        processApproachEnding(input);
+        return;
+    }
+
+    lastUpdateTime = now;
 
     // Primary control state machine
     switch (approach_state) {
         case APPROACH_INIT:
-            processApproachInit();
+            processApproachInit(input);
             break;
 
         case APPROACH_PREFLIGHT:
-            processApproachPreflight();
+            processApproachPreflight(input);
             break;
 
         case APPROACH_FINAL:
@@ -46,42 +57,42 @@ void LanderGame::update() {
             [[fallthrough]];  // Intentional fallthrough
 
         case APPROACH_IN_FLIGHT:
-            processApproachInFlight();
+            processApproachInFlight(input);
+            break;
+
+        case APPROACH_ENDING:
             break;
     }
 
     updateGearAnimation();
-    updateMotherShipDrift();
+    updateMotherShipDrift(input.drift_x, input.drift_y);
     updateDistance();
-}
 
-void LanderGame::processApproachInit() {
-    const bool thrust_lever = LanderHardware::getThrustLever();
-    const bool systems_lever = LanderHardware::getSystemsLever();
-    const bool confirm_lever = LanderHardware::getConfirmLever();
+    // Touchdown, whatever the outcome
+    if (lander_distance <= LanderDistance()) {
+        approach_state = APPROACH_ENDING;
+    }
+}
 
+void LanderGame::processApproachInit(const InputFrame& input) {
     // All levers off
-    if (!thrust_lever && !systems_lever && !confirm_lever) {
+    if (!input.thrust_lever && !input.systems_lever && !input.confirm_lever) {
         approach_state = APPROACH_PREFLIGHT;
     }
 }
 
-void LanderGame::processApproachPreflight() {
-    const bool thrust_lever = LanderHardware::getThrustLever();
-    const bool systems_lever = LanderHardware::getSystemsLever();
-    const bool confirm_lever = LanderHardware::getConfirmLever();
-
+void LanderGame::processApproachPreflight(const InputFrame& input) {
     // All levers on
-    if (thrust_lever && systems_lever && confirm_lever) {
+    if (input.thrust_lever && input.systems_lever && input.confirm_lever) {
         approach_state = APPROACH_IN_FLIGHT;
     }
 }
 
-void LanderGame::processApproachInFlight() {
-    processInflightState();
+void LanderGame::processApproachInFlight(const InputFrame& input) {
+    processInflightState(input);
 
     // Prepare for landing on final approach
-    if (lander_distance < (INITIAL_DISTANCE / 10)) {
+    if (lander_distance < LanderDistance::fromInt(INITIAL_DISTANCE / 10)) {
         approach_state = APPROACH_FINAL;
     }
 }
@@ -91,8 +102,29 @@ void LanderGame::processApproachFinal() {
     // Process gear control in the inflight state processing
 }
 
-void LanderGame::processInflightState() {
-    const auto currentKey = LanderHardware::getControlButtonPressed();
+void LanderGame::processApproachEnding(const InputFrame& input) {
+    ending_tick = ending_tick + 1 == 2 * ENDING_VIEW_TICKS ? 0 : ending_tick + 1;
+
+    // The levers are still on from the flight.  Turning them all off starts
+    // a new game at preflight, which only waits for all of them on again.
+    // Levers already off at touchdown have to go on and off once more, so
+    // the ending is never skipped.
+    if (input.thrust_lever || input.systems_lever || input.confirm_lever) {
+        restart_armed = true;
+    } else if (restart_armed) {
+        *this = LanderGame();
+        approach_state = APPROACH_PREFLIGHT;
+    }
+}
+
+void LanderGame::processInflightState(const InputFrame& input) {
+    // A tap came and went before this tick, so it happened before the key
+    // that is held now
+    processKey(input.tap);
+    processKey(input.key);
+}
+
+void LanderGame::processKey(const LANDER_CONTROLS currentKey) {
     bool actionCompleted = processSpeedState(currentKey);
 
     if (actionCompleted) {
@@ -114,19 +146,17 @@ bool LanderGame::processSpeedState(const LANDER_CONTROLS action) {
     switch (action) {
         case RAISE_SPEED:
             actionCompleted = true;
-            lander_speed++;
+            lander_speed += THRUST_STEP;
             // If this is first time increasing speed then save the start time
             if (approachStartTime == 0) {
-                approachStartTime = millis();
+                approachStartTime = lastUpdateTime;
             }
             break;
 
         case LOWER_SPEED:
             actionCompleted = true;
             // lower speed unless stopped
-            if (lander_speed > 0) {
-                lander_speed--;
-            }
+            lander_speed = lander_speed > THRUST_STEP ? lander_speed - THRUST_STEP : LanderSpeed();
             break;
 
         default:
@@ -202,17 +232,6 @@ void LanderGame::processSteeringState(const LANDER_CONTROLS action) {
     }
 }
 
-int LanderGame::getRandomDrift() {
-    constexpr byte DRIFT_CONTROL = 3;  // Must be > 1. Higher numbers slow drift rate.
-    int drift = static_cast<int>(random(-1, DRIFT_CONTROL));
-
-    if (drift > 1) {  // Values over 1 are changed to 0
-        drift = 0;
-    }
-
-    return drift;
-}
-
 void LanderGame::updateGearAnimation() {
     // Because we specified our gear states as 0, 1 or -1 we can change bitmaps by
     // simply adding the gear state to our current gear bitmap index.
@@ -225,14 +244,12 @@ void LanderGame::updateGearAnimation() {
     }
 }
 
-void LanderGame::updateMotherShipDrift() {
-    // Here we compute the drift of the mother ship using random numbers.
+void LanderGame::updateMotherShipDrift(const int drift_x, const int drift_y) {
+    // Here we apply the random drift of the mother ship for this tick.
     // The mother ship cannot drift off the display, done by setting a
-    // maximum drift.
-    constexpr byte MAX_DRIFT = 18;
-
-    mother_ship_x_offset += getRandomDrift();  // returns -1, 0 or 1
-    mother_ship_y_offset += getRandomDrift();  // returns -1, 0 or 1
+    // maximum drift (MAX_DRIFT).
+    mother_ship_x_offset += drift_x;  // -1, 0 or 1
+    mother_ship_y_offset += drift_y;  // -1, 0 or 1
 
     // Ensure mother ship doesn't drift off our radar display
     if (mother_ship_x_offset > MAX_DRIFT) mother_ship_x_offset = MAX_DRIFT;
@@ -242,10 +259,12 @@ void LanderGame::updateMotherShipDrift() {
 }
 
 void LanderGame::updateDistance() {
-    lander_distance -= lander_speed;  // Adjust distance by current speed
+    // Move this tick's share of the speed, then lose some of it to drag
+    lander_distance -= (lander_speed * TICK_SCALE).to<LanderDistance>();
+    lander_speed -= lander_speed * TICK_DRAG;
 }
 
-const unsigned char* LanderGame::getEndingBitmap() const {
+ENDING_OUTCOME LanderGame::getOutcome() const {
     constexpr byte MAX_MOTHER_SHIP_WIDTH = 21;
     constexpr byte MAX_MOTHER_SHIP_HEIGHT = 15;
 
@@ -256,26 +275,89 @@ const unsigned char* LanderGame::getEndingBitmap() const {
 
     if (missedMotherShip) {
         // Missed the mother ship. No fuel for another try. Bye!
-        return ENDING_BITMAP_MISSED_MOTHER_SHIP;
+        return ENDING_MISSED_MOTHER_SHIP;
     }
 
     // Check speed to see if we were slow enough.
-    if (lander_speed > 2) {
-        // Max safe landing speed is 2
+    if (lander_speed > MAX_LANDING_SPEED) {
+        // Max safe landing speed is MAX_LANDING_SPEED
         // Speed is too fast! Lander AND mother ship destroyed. (Ouch!)
-        return ENDING_BITMAP_TOO_FAST;
+        return ENDING_TOO_FAST;
     }
 
     // Did we remember to lower the landing gear?
     if (current_gear_bitmap_index == GEAR_BITMAP_COUNT - 1) {
         // Gear is down! Success.
-        return ENDING_BITMAP_SUCCESS;
+        return ENDING_SUCCESS;
     }
 
     // Gear is up; damage to lander, but we survived.
-    return ENDING_BITMAP_NO_GEAR;
+    return ENDING_NO_GEAR;
+}
+
+const unsigned char* LanderGame::getEndingBitmap() const {
+    switch (getOutcome()) {
+        case ENDING_SUCCESS:
+            return ENDING_BITMAP_SUCCESS;
+        case ENDING_TOO_FAST:
+            return ENDING_BITMAP_TOO_FAST;
+        case ENDING_MISSED_MOTHER_SHIP:
+            return ENDING_BITMAP_MISSED_MOTHER_SHIP;
+        default:
+            return ENDING_BITMAP_NO_GEAR;
+    }
+}
+
+bool LanderGame::isShowingEndingSplash() const {
+    return ending_tick < ENDING_VIEW_TICKS;
 }
 
 unsigned long LanderGame::getElapsedTime() const {
-    return millis() - approachStartTime;
+    return lastUpdateTime - approachStartTime;
+}
+
+static_assert(2 * MAX_DRIFT < (1 << LanderSnapshot::OFFSET_BITS),
+              "Mother ship offsets don't fit in a LanderSnapshot");
+
+LanderSnapshot LanderGame::save() const {
+    // Offsets are back inside MAX_DRIFT once update() has run
+    uint32_t elapsed = 0;
+    if (approachStartTime != 0) {
+        elapsed = (lastUpdateTime - approachStartTime) / SIMULATION_TICK_MS + 1;
+        if (elapsed > LanderSnapshot::ELAPSED_MAX) {
+            elapsed = LanderSnapshot::ELAPSED_MAX;
+        }
+    }
+
+    LanderSnapshot snapshot;
+    snapshot.distance_raw = lander_distance.toRaw();
+    snapshot.speed_raw = lander_speed.toRaw();
+    snapshot.packed =
+        static_cast<uint32_t>(mother_ship_x_offset + MAX_DRIFT) |
+        static_cast<uint32_t>(mother_ship_y_offset + MAX_DRIFT) << LanderSnapshot::Y_OFFSET_SHIFT |
+        static_cast<uint32_t>(approach_state) << LanderSnapshot::APPROACH_SHIFT |
+        static_cast<uint32_t>(current_gear_bitmap_index) << LanderSnapshot::GEAR_INDEX_SHIFT |
+        static_cast<uint32_t>(gear_state + 1) << LanderSnapshot::GEAR_STATE_SHIFT |
+        elapsed << LanderSnapshot::ELAPSED_SHIFT;
+    return snapshot;
+}
+
+void LanderGame::restore(const LanderSnapshot& snapshot, const unsigned long now) {
+    constexpr uint32_t OFFSET_MASK = (1UL << LanderSnapshot::OFFSET_BITS) - 1;
+    const uint32_t packed = snapshot.packed;
+
+    lander_distance = LanderDistance::fromRaw(snapshot.distance_raw);
+    lander_speed = LanderSpeed::fromRaw(snapshot.speed_raw);
+    mother_ship_x_offset = static_cast<int>(packed & OFFSET_MASK) - MAX_DRIFT;
+    mother_ship_y_offset = static_cast<int>(packed >> LanderSnapshot::Y_OFFSET_SHIFT & OFFSET_MASK) - MAX_DRIFT;
+    approach_state = static_cast<APPROACH_STATE>(packed >> LanderSnapshot::APPROACH_SHIFT & 0x07);
+    current_gear_bitmap_index = static_cast<int>(packed >> LanderSnapshot::GEAR_INDEX_SHIFT & 0x03);
+    gear_state = static_cast<GEAR_STATE>(static_cast<int>(packed >> LanderSnapshot::GEAR_STATE_SHIFT & 0x03) - 1);
+
+    ending_tick = 0;
+    restart_armed = false;
+
+    const uint32_t elapsed = packed >> LanderSnapshot::ELAPSED_SHIFT;
+    lastUpdateTime = now;
+    approachStartTime = elapsed == 0 ? 0 : now - (elapsed - 1) * SIMULATION_TICK_MS;
 }
@@ -0,0 +1,290 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#include <EEPROM.h>
+#include "LanderGhost.h"
+
+#ifdef E2END
+static_assert(GHOST_EEPROM_ADDRESS + GHOST_EEPROM_SIZE <= E2END + 1UL,
+              "Ghost runs past the end of the EEPROM");
+#endif
+static_assert((GHOST_EEPROM_SIZE - LanderGhostRecord::HEADER_SIZE) / 2 > LanderGhostRecord::SLOT_HEADER_SIZE + 16,
+              "GHOST_EEPROM_SIZE leaves no room for a run");
+
+// Static member initialization
+uint8_t LanderGhost::activeSlot = NO_SLOT;
+unsigned long LanderGhost::bestTime = 0;
+
+LanderGhost::RECORDING LanderGhost::recording = RECORDING_IDLE;
+uint16_t LanderGhost::writeAt = 0;
+uint16_t LanderGhost::writeEnd = 0;
+uint8_t LanderGhost::pendingNibble = NO_NIBBLE;
+int8_t LanderGhost::recordedX = 0;
+int8_t LanderGhost::recordedY = 0;
+int8_t LanderGhost::recordedSpeed = 0;
+
+bool LanderGhost::playing = false;
+uint16_t LanderGhost::readAt = 0;
+uint16_t LanderGhost::readEnd = 0;
+bool LanderGhost::readHigh = false;
+int8_t LanderGhost::x_offset = 0;
+int8_t LanderGhost::y_offset = 0;
+int8_t LanderGhost::speed = 0;
+LanderDistance LanderGhost::distance;
+
+void LanderGhost::begin() {
+    if (!GHOST) {
+        return;
+    }
+
+    activeSlot = NO_SLOT;
+    bestTime = 0;
+
+    const uint8_t active = EEPROM.read(GHOST_EEPROM_ADDRESS + LanderGhostRecord::ACTIVE_OFFSET);
+    if (EEPROM.read(GHOST_EEPROM_ADDRESS) != LanderGhostRecord::MAGIC_0 ||
+        EEPROM.read(GHOST_EEPROM_ADDRESS + 1) != LanderGhostRecord::MAGIC_1 ||
+        EEPROM.read(GHOST_EEPROM_ADDRESS + 2) != LanderGhostRecord::VERSION ||
+        active > 1) {
+        return;
+    }
+
+    const uint16_t slot = slotAddress(active);
+    for (byte i = 0; i < 4; i++) {
+        bestTime |= static_cast<unsigned long>(EEPROM.read(slot + i)) << (8 * i);
+    }
+    activeSlot = active;
+}
+
+void LanderGhost::update(const LanderGame& game, const bool rewound) {
+    if (!GHOST) {
+        return;
+    }
+
+    switch (game.getApproachState()) {
+        // A new game, or one restarted from the ending
+        case APPROACH_INIT:
+        case APPROACH_PREFLIGHT:
+            recording = RECORDING_IDLE;
+            playing = false;
+            return;
+
+        // The touchdown tick still moved, so record it before saving
+        case APPROACH_ENDING:
+            if (recording == RECORDING_ON) {
+                recordTick(game);
+                finishRecording(game);
+            }
+            recording = RECORDING_STOPPED;
+            playing = false;
+            return;
+
+        case APPROACH_IN_FLIGHT:
+        case APPROACH_FINAL:
+            break;
+    }
+
+    // Both the run and the ghost start with the first thrust
+    if (game.getApproachStartTime() == 0) {
+        return;
+    }
+    if (recording == RECORDING_IDLE) {
+        startRecording(game);
+        startPlaying();
+        return;
+    }
+
+    if (rewound) {
+        recording = RECORDING_STOPPED;
+    }
+    if (recording == RECORDING_ON) {
+        recordTick(game);
+    }
+    if (playing) {
+        playTick();
+    }
+}
+
+uint16_t LanderGhost::slotAddress(const uint8_t slot) {
+    return GHOST_EEPROM_ADDRESS + LanderGhostRecord::HEADER_SIZE + slot * SLOT_SIZE;
+}
+
+void LanderGhost::startRecording(const LanderGame& game) {
+    // Into whichever slot doesn't hold the best run
+    const uint16_t slot = slotAddress(activeSlot == 0 ? 1 : 0);
+
+    recordedX = game.getMotherShipXOffset();
+    recordedY = game.getMotherShipYOffset();
+    recordedSpeed = game.getLanderSpeed();
+
+    // Elapsed time goes in at touchdown
+    EEPROM.update(slot + 4, static_cast<uint8_t>(recordedX));
+    EEPROM.update(slot + 5, static_cast<uint8_t>(recordedY));
+    EEPROM.update(slot + 6, static_cast<uint8_t>(recordedSpeed));
+
+    writeAt = slot + LanderGhostRecord::SLOT_HEADER_SIZE;
+    writeEnd = slot + SLOT_SIZE;
+    pendingNibble = NO_NIBBLE;
+    recording = RECORDING_ON;
+}
+
+void LanderGhost::recordTick(const LanderGame& game) {
+    // Already slower than the best, or no room left for this tick and the
+    // end symbol
+    const uint16_t room = 2 * (writeEnd - writeAt) - (pendingNibble != NO_NIBBLE);
+    if ((bestTime != 0 && game.getElapsedTime() >= bestTime) ||
+        room < LanderGhostRecord::MAX_TICK_NIBBLES + 1) {
+        recording = RECORDING_STOPPED;
+        return;
+    }
+
+    const int dx = game.getMotherShipXOffset() - recordedX;
+    const int dy = game.getMotherShipYOffset() - recordedY;
+    const int dspeed = game.getLanderSpeed() - recordedSpeed;
+
+    const uint8_t move = LanderGhostRecord::moveSymbol(dx, dy);
+    const uint8_t change = dspeed == 0 ? move : LanderGhostRecord::speedSymbol(dspeed);
+    if (move == LanderGhostRecord::SYMBOL_LONG || change == LanderGhostRecord::SYMBOL_LONG) {
+        writeNibble(LanderGhostRecord::SYMBOL_LONG);
+        writeVarint(dx);
+        writeVarint(dy);
+        writeVarint(dspeed);
+    } else {
+        writeNibble(change);
+        if (change != move) {
+            writeNibble(move);
+        }
+    }
+
+    recordedX = game.getMotherShipXOffset();
+    recordedY = game.getMotherShipYOffset();
+    recordedSpeed = game.getLanderSpeed();
+}
+
+void LanderGhost::finishRecording(const LanderGame& game) {
+    const unsigned long elapsed = game.getElapsedTime();
+    if (recording != RECORDING_ON || game.getOutcome() != ENDING_SUCCESS ||
+        (bestTime != 0 && elapsed >= bestTime)) {
+        return;
+    }
+
+    writeNibble(LanderGhostRecord::SYMBOL_END);
+    if (pendingNibble != NO_NIBBLE) {
+        writeNibble(LanderGhostRecord::SYMBOL_END);
+    }
+
+    const uint8_t slot = activeSlot == 0 ? 1 : 0;
+    const uint16_t address = slotAddress(slot);
+    for (byte i = 0; i < 4; i++) {
+        EEPROM.update(address + i, static_cast<uint8_t>(elapsed >> (8 * i)));
+    }
+
+    // The run is whole before the single byte that makes it the best
+    EEPROM.update(GHOST_EEPROM_ADDRESS, LanderGhostRecord::MAGIC_0);
+    EEPROM.update(GHOST_EEPROM_ADDRESS + 1, LanderGhostRecord::MAGIC_1);
+    EEPROM.update(GHOST_EEPROM_ADDRESS + 2, LanderGhostRecord::VERSION);
+    EEPROM.update(GHOST_EEPROM_ADDRESS + LanderGhostRecord::ACTIVE_OFFSET, slot);
+
+    activeSlot = slot;
+    bestTime = elapsed;
+}
+
+void LanderGhost::writeNibble(const uint8_t nibble) {
+    // recordTick() checked there is room
+    if (pendingNibble == NO_NIBBLE) {
+        pendingNibble = nibble;
+        return;
+    }
+    EEPROM.update(writeAt++, static_cast<uint8_t>(pendingNibble | nibble << 4));
+    pendingNibble = NO_NIBBLE;
+}
+
+void LanderGhost::writeVarint(const int value) {
+    uint16_t bits = LanderGhostRecord::zigzag(static_cast<int16_t>(value));
+    while (bits > 0x07) {
+        writeNibble(static_cast<uint8_t>(0x08 | (bits & 0x07)));
+        bits >>= 3;
+    }
+    writeNibble(static_cast<uint8_t>(bits));
+}
+
+void LanderGhost::startPlaying() {
+    if (activeSlot == NO_SLOT) {
+        return;
+    }
+
+    const uint16_t slot = slotAddress(activeSlot);
+    x_offset = static_cast<int8_t>(EEPROM.read(slot + 4));
+    y_offset = static_cast<int8_t>(EEPROM.read(slot + 5));
+    speed = static_cast<int8_t>(EEPROM.read(slot + 6));
+
+    // The first thrust tick has already moved
+    distance = LanderDistance::fromInt(INITIAL_DISTANCE);
+    move(speed);
+
+    readAt = slot + LanderGhostRecord::SLOT_HEADER_SIZE;
+    readEnd = slot + SLOT_SIZE;
+    readHigh = false;
+    playing = true;
+}
+
+void LanderGhost::playTick() {
+    uint8_t symbol = readNibble();
+
+    if (symbol == LanderGhostRecord::SYMBOL_FASTER || symbol == LanderGhostRecord::SYMBOL_SLOWER) {
+        speed += symbol == LanderGhostRecord::SYMBOL_FASTER ? 1 : -1;
+        symbol = readNibble();
+    }
+
+    if (symbol < LanderGhostRecord::SYMBOL_MOVES) {
+        x_offset += LanderGhostRecord::moveX(symbol);
+        y_offset += LanderGhostRecord::moveY(symbol);
+    } else if (symbol == LanderGhostRecord::SYMBOL_LONG) {
+        x_offset += readVarint();
+        y_offset += readVarint();
+        speed += readVarint();
+    } else {
+        // Landed, or a symbol this version doesn't know
+        playing = false;
+        return;
+    }
+
+    move(speed);
+}
+
+uint8_t LanderGhost::readNibble() {
+    if (readAt >= readEnd) {
+        return LanderGhostRecord::SYMBOL_END;
+    }
+
+    const uint8_t packed = EEPROM.read(readAt);
+    if (readHigh) {
+        readAt++;
+        readHigh = false;
+        return packed >> 4;
+    }
+    readHigh = true;
+    return packed & 0x0F;
+}
+
+int LanderGhost::readVarint() {
+    uint16_t bits = 0;
+    for (byte shift = 0; shift < 16; shift += 3) {
+        const uint8_t nibble = readNibble();
+        bits |= static_cast<uint16_t>(nibble & 0x07) << shift;
+        if (!(nibble & 0x08)) {
+            break;
+        }
+    }
+    return LanderGhostRecord::unzigzag(bits);
+}
+
+// The recording keeps whole speeds from getLanderSpeed(), so the ghost
+// only flies the same distances as the game while speed never has a
+// fraction.  Record raw LanderSpeed changes before relaxing this.
+static_assert(DRAG.toRaw() == 0 && THRUST_STEP.toRaw() % LanderSpeed::ONE == 0,
+              "LanderGhost needs whole-unit THRUST_STEP and no DRAG");
+
+void LanderGhost::move(const int8_t speed_now) {
+    distance -= (LanderSpeed::fromInt(speed_now) * TICK_SCALE).to<LanderDistance>();
+}
@@ -5,11 +5,11 @@
 #include "LanderHardware.h"
 
 // Hardware object definitions
-U8G2_SH1106_128X64_NONAME_2_HW_I2C landerDisplay(U8G2_R0, /* reset=*/U8X8_PIN_NONE);
+LanderScreen::Display landerDisplay(U8G2_R0, /* reset=*/U8X8_PIN_NONE);
 TM1637Display distanceDisplay(DISTANCE_DISPLAY_CLK, DISTANCE_DISPLAY_DIO);
 
 // Define our button array using constants to be returned for each button
-char control_buttons[CONTROL_ROW_COUNT][CONTROL_COLUMN_COUNT] = {
+const char control_buttons[CONTROL_ROW_COUNT][CONTROL_COLUMN_COUNT] PROGMEM = {
   { STEER_UP_LEFT, STEER_UP, STEER_UP_RIGHT, LOWER_GEAR },         // 1st row
   { STEER_LEFT, UNUSED, STEER_RIGHT, RAISE_GEAR },                 // 2nd row
   { STEER_DOWN_LEFT, STEER_DOWN, STEER_DOWN_RIGHT, RAISE_SPEED },  // 3rd row
@@ -17,16 +17,26 @@ char control_buttons[CONTROL_ROW_COUNT][CONTROL_COLUMN_COUNT] = {
 };
 
 // Create lander button control object.
-auto lander_controls = Keypad(
-  makeKeymap(control_buttons),
-  const_cast<byte*>(ROW_PINS),
-  const_cast<byte*>(COLUMN_PINS),
-  CONTROL_ROW_COUNT,
-  CONTROL_COLUMN_COUNT
-);
+LanderKeypad lander_controls;
+
+// Keys held together to rewind, two opposite commands nobody flies with
+constexpr uint16_t REWIND_CHORD = 1U << LOWER_GEAR | 1U << RAISE_GEAR;
 
 // Static member initialization
-LANDER_CONTROLS LanderHardware::lastKey = UNUSED;
+LANDER_CONTROLS LanderHardware::heldKey = UNUSED;
+uint16_t LanderHardware::heldKeys = 0;
+LanderKeyQueue LanderHardware::keyQueue;
+uint16_t LanderHardware::maxKeyLatency = 0;
+
+#if defined(__AVR__)
+// Timer0 already runs every 1.024 ms for millis(), and its compare A
+// interrupt is free.  getKeys() only scans once its debounce time
+// has passed, so most of these return straight away.
+ISR(TIMER0_COMPA_vect) {
+    LanderHardware::sampleKeypad();
+}
+#endif
+LanderRandom LanderHardware::driftRandom;
 
 void LanderHardware::init() {
     // Configure OLED display
@@ -43,6 +53,14 @@ void LanderHardware::init() {
     pinMode(CONFIRM_LEVER, INPUT);
     pinMode(SYSTEMS_LEVER, INPUT);
     pinMode(THRUST_LEVER, INPUT);
+
+    seedRandom();
+
+#if defined(__AVR__)
+    // Start the keypad sampler, halfway between millis() overflows
+    OCR0A = 0x80;
+    TIMSK0 |= _BV(OCIE0A);
+#endif
 }
 
 void LanderHardware::setDisplayBrightness(int brightness) {
@@ -57,46 +75,121 @@ void LanderHardware::showDistance(int distance) {
     distanceDisplay.showNumberDec(distance);
 }
 
-bool LanderHardware::getThrustLever() {
-    return digitalRead(THRUST_LEVER);
+byte LanderHardware::readLevers() {
+#if defined(__AVR_ATmega328P__)
+    // A0-A2 are PC0-PC2 on the Uno, so a single PINC read samples all three
+    // levers at the same instant without three trips through digitalRead().
+    static_assert(THRUST_LEVER == A0 && SYSTEMS_LEVER == A1 && CONFIRM_LEVER == A2,
+                  "readLevers() expects the levers on A0-A2");
+    return PINC & 0x07;
+#else
+    return digitalRead(THRUST_LEVER) | (digitalRead(SYSTEMS_LEVER) << 1) | (digitalRead(CONFIRM_LEVER) << 2);
+#endif
 }
 
-bool LanderHardware::getSystemsLever() {
-    return digitalRead(SYSTEMS_LEVER);
-}
+void LanderHardware::sampleKeypad() {
+    if (!lander_controls.getKeys()) {
+        return;
+    }
 
-bool LanderHardware::getConfirmLever() {
-    return digitalRead(CONFIRM_LEVER);
+    const uint16_t now = millis();
+    for (const Key& key : lander_controls.key) {
+        if (!key.stateChanged || (key.kstate != PRESSED && key.kstate != RELEASED)) {
+            continue;
+        }
+        keyQueue.push({static_cast<LANDER_CONTROLS>(key.kchar), key.kstate == PRESSED, now});
+    }
 }
 
-LANDER_CONTROLS LanderHardware::getControlButtonPressed() {
-    char current_key = lander_controls.getKey();
-
-    if (current_key != NO_KEY) {
-        lastKey = static_cast<LANDER_CONTROLS>(current_key);
+void LanderHardware::drainKeyEvents(InputFrame& frame) {
+    const uint16_t now = millis();
+    LANDER_CONTROLS pressedKey = UNUSED;  // Latest key pressed since the last tick
+    frame.tap = UNUSED;
+
+    KeyEvent event;
+    while (keyQueue.peek(event)) {
+        if (event.pressed) {
+            // One press per tick.  A later press waits for the next tick,
+            // so it can't take over the first key's tap or hold.
+            if (pressedKey != UNUSED) {
+                break;
+            }
+            heldKey = event.key;
+            pressedKey = event.key;
+            heldKeys |= 1U << event.key;
+        } else {
+            heldKeys &= ~(1U << event.key);
+            if (event.key == heldKey) {
+                if (event.key == pressedKey) {
+                    frame.tap = event.key;
+                }
+                // Fall back to a key that's still down, lowest first, so
+                // letting go of the later of two keys keeps the first going
+                const uint16_t stillHeld = heldKeys & ~(1U << UNUSED);
+                heldKey = stillHeld != 0 ? static_cast<LANDER_CONTROLS>(__builtin_ctz(stillHeld)) : UNUSED;
+            }
+        }
+
+        const uint16_t latency = now - event.time;
+        if (latency > maxKeyLatency) {
+            maxKeyLatency = latency;
+        }
+        keyQueue.pop();
     }
 
-    // If the button is released reset to NO_KEY
-    if (lander_controls.getState() == RELEASED) {
-        lastKey = UNUSED;
-        current_key = NO_KEY;
-    } else {
-        current_key = static_cast<char>(lastKey);
+    frame.key = heldKey;
+
+    // The chord keys only rewind, they don't also move the gear
+    frame.rewind = REWIND && (heldKeys & REWIND_CHORD) == REWIND_CHORD;
+    if (frame.rewind) {
+        frame.key = UNUSED;
+        frame.tap = UNUSED;
     }
+}
+
+InputFrame LanderHardware::readInputFrame() {
+    const byte levers = readLevers();
+
+    InputFrame frame;
+    frame.thrust_lever = levers & 0x01;
+    frame.systems_lever = levers & 0x02;
+    frame.confirm_lever = levers & 0x04;
 
-    return static_cast<LANDER_CONTROLS>(current_key);
+#if !defined(__AVR__) && !defined(LANDER_SIM)
+    sampleKeypad();  // No sampler interrupt, so poll once per tick
+#endif
+    drainKeyEvents(frame);
+    driftRandom.nextDrift(DRIFT_CONTROL, frame.drift_x, frame.drift_y);
+    return frame;
 }
 
-int LanderHardware::getRandomDrift() {
-    int drift = static_cast<int>(random(-1, DRIFT_CONTROL));
+void LanderHardware::reportKeyStats(Print& out) {
+    out.print(F("  keys dropped "));
+    out.print(keyQueue.getOverflows());
+    out.print(F(" max delay "));
+    out.print(maxKeyLatency);
+    out.println(F("ms"));
 
-    if (drift > 1) {
-        drift = 0;
-    }
+    maxKeyLatency = 0;
+}
 
-    return drift;
+int LanderHardware::freeMemory() {
+#if defined(__AVR__)
+    extern char __heap_start;
+    extern char* __brkval;
+    char top;
+    return &top - (__brkval != nullptr ? __brkval : &__heap_start);
+#else
+    return 0;
+#endif
 }
 
 void LanderHardware::seedRandom() {
-    randomSeed(analogRead(A3));
+    // The unconnected A3 only gives a few noisy bits per read, so fold in
+    // several reads along with the time since power-up.
+    uint32_t seed = micros();
+    for (byte i = 0; i < 8; i++) {
+        seed = (seed << 5 | seed >> 27) ^ analogRead(A3);
+    }
+    driftRandom = LanderRandom(seed);
 }
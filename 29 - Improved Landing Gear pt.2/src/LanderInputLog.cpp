@@ -0,0 +1,91 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#include "LanderInputLog.h"
+#include "LanderInputRecord.h"
+
+// Static member initialization
+uint16_t LanderInputLog::ring[RING_SIZE];
+byte LanderInputLog::oldest = 0;
+byte LanderInputLog::stored = 0;
+uint16_t LanderInputLog::tickCount = 0;
+LanderSnapshot LanderInputLog::base;
+LanderSnapshot LanderInputLog::middle;
+
+void LanderInputLog::begin(const LanderGame& game) {
+    oldest = 0;
+    stored = 0;
+    tickCount = 0;
+
+    if (INPUT_LOG == INPUT_LOG_SERIAL) {
+        writeHeader(Serial, 0, game.save());
+    }
+}
+
+void LanderInputLog::record(const InputFrame& frame, const LanderGame& game) {
+    const uint16_t record = LanderInputRecord::pack(frame);
+
+    switch (INPUT_LOG) {
+        case INPUT_LOG_SERIAL:
+            Serial.write(record & 0xFF);
+            Serial.write(record >> 8);
+            break;
+
+        case INPUT_LOG_RING:
+            // Full, so the newer half becomes the older one
+            if (stored == RING_SIZE) {
+                oldest = (oldest + HALF_RING) % RING_SIZE;
+                stored = HALF_RING;
+                base = middle;
+            }
+
+            // The game hasn't run this tick yet, so it is the state the
+            // replayer has to start from to reach the same one
+            if (stored == 0) {
+                base = game.save();
+            } else if (stored == HALF_RING) {
+                middle = game.save();
+            }
+
+            ring[(oldest + stored) % RING_SIZE] = record;
+            stored++;
+            break;
+
+        default:
+            return;
+    }
+
+    tickCount++;
+}
+
+void LanderInputLog::restart() {
+    if (INPUT_LOG != INPUT_LOG_RING) {
+        return;
+    }
+
+    oldest = 0;
+    stored = 0;
+    tickCount = 0;
+}
+
+void LanderInputLog::dump(Print& out) {
+    if (INPUT_LOG != INPUT_LOG_RING) {
+        return;
+    }
+
+    writeHeader(out, tickCount - stored, base);
+
+    for (byte i = 0; i < stored; i++) {
+        const uint16_t record = ring[(oldest + i) % RING_SIZE];
+        out.write(record & 0xFF);
+        out.write(record >> 8);
+    }
+}
+
+void LanderInputLog::writeHeader(Print& out, const uint16_t first_tick, const LanderSnapshot& snapshot) {
+    uint8_t header[LanderInputRecord::HEADER_SIZE + LanderInputRecord::SNAPSHOT_SIZE];
+    LanderInputRecord::writeHeader(header, SIMULATION_TICK_MS, first_tick);
+    LanderInputRecord::writeSnapshot(header + LanderInputRecord::HEADER_SIZE, snapshot);
+    out.write(header, sizeof(header));
+}
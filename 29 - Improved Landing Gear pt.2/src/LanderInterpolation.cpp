@@ -0,0 +1,71 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#include "LanderInterpolation.h"
+#include "LanderConfig.h"
+#include "LanderGhost.h"
+
+constexpr unsigned long TICK_US = SIMULATION_TICK_MS * 1000UL;
+
+static_assert(TICK_US * LanderRatio::ONE < 0x80000000UL,
+              "SIMULATION_TICK_MS is too long to blend in a long");
+
+// from + (to - from) * blend, to the nearest whole unit
+static int lerp(const int from, const int to, const LanderRatio blend) {
+    return (LanderRatio::fromInt(from) + LanderRatio::fromInt(to - from) * blend).round();
+}
+
+// The ghost moves on whole ticks, it only has the latest
+static void addGhost(LanderView& view) {
+    view.ghost_visible = GHOST && LanderGhost::isVisible();
+    view.ghost_distance = LanderGhost::getLanderDistance();
+    view.ghost_x_offset = LanderGhost::getMotherShipXOffset();
+    view.ghost_y_offset = LanderGhost::getMotherShipYOffset();
+}
+
+LanderRatio LanderInterpolation::blend(const unsigned long since_us) {
+    // A late tick holds the latest state rather than running ahead of it
+    if (since_us >= TICK_US) {
+        return LanderRatio::fromInt(1);
+    }
+    return LanderRatio::fromRatio(since_us, TICK_US);
+}
+
+LanderView LanderInterpolation::between(
+    const LanderSnapshot& previous,
+    const LanderGame& current,
+    const LanderRatio blend
+) {
+    LanderGame before;
+    before.restore(previous, 0);
+
+    // Distance stays in Q12.4 so the mother ship grows between size steps
+    // at the same point it would without interpolation
+    const LanderDistance from = before.getLanderDistanceFixed();
+    const LanderDistance distance = from + (current.getLanderDistanceFixed() - from) * blend;
+
+    LanderView view;
+    view.lander_distance = distance.ceil();
+    view.lander_speed = current.getLanderSpeed();
+    view.mother_ship_x_offset = lerp(before.getMotherShipXOffset(), current.getMotherShipXOffset(), blend);
+    view.mother_ship_y_offset = lerp(before.getMotherShipYOffset(), current.getMotherShipYOffset(), blend);
+    view.gear_bitmap_index = current.getCurrentGearBitmapIndex();
+    view.previous_gear_bitmap_index = before.getCurrentGearBitmapIndex();
+    view.gear_blend = blend;
+    addGhost(view);
+    return view;
+}
+
+LanderView LanderInterpolation::at(const LanderGame& game) {
+    LanderView view;
+    view.lander_distance = game.getLanderDistance();
+    view.lander_speed = game.getLanderSpeed();
+    view.mother_ship_x_offset = game.getMotherShipXOffset();
+    view.mother_ship_y_offset = game.getMotherShipYOffset();
+    view.gear_bitmap_index = game.getCurrentGearBitmapIndex();
+    view.previous_gear_bitmap_index = view.gear_bitmap_index;
+    view.gear_blend = LanderRatio::fromInt(1);
+    addGhost(view);
+    return view;
+}
@@ -0,0 +1,65 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#include "LanderProfiler.h"
+
+// Static member initialization
+uint16_t LanderProfiler::counts[STAGE_SLOTS][LanderProfileRecord::BUCKET_COUNT];
+uint16_t LanderProfiler::longest[STAGE_SLOTS];
+
+void LanderProfiler::record(const PROFILE_STAGE stage, const unsigned long duration) {
+    if (!PROFILER) {
+        return;
+    }
+
+    uint16_t& count = counts[stage][LanderProfileRecord::bucket(duration)];
+    if (count != 0xFFFF) {
+        count++;
+    }
+
+    const uint16_t clipped = duration > 0xFFFF ? 0xFFFF : duration;
+    if (clipped > longest[stage]) {
+        longest[stage] = clipped;
+    }
+}
+
+void LanderProfiler::poll(Stream& serial) {
+    if (!PROFILER) {
+        return;
+    }
+
+    while (serial.available() > 0) {
+        if (serial.read() == PROFILER_DUMP_COMMAND) {
+            dump(serial);
+            clear();
+        }
+    }
+}
+
+void LanderProfiler::dump(Print& out) {
+    if (!PROFILER) {
+        return;
+    }
+
+    uint8_t header[LanderProfileRecord::HEADER_SIZE];
+    LanderProfileRecord::writeHeader(header);
+    out.write(header, sizeof(header));
+
+    for (byte stage = 0; stage < STAGE_SLOTS; stage++) {
+        for (byte bucket = 0; bucket < LanderProfileRecord::BUCKET_COUNT; bucket++) {
+            writeWord(out, counts[stage][bucket]);
+        }
+        writeWord(out, longest[stage]);
+    }
+}
+
+void LanderProfiler::clear() {
+    memset(counts, 0, sizeof(counts));
+    memset(longest, 0, sizeof(longest));
+}
+
+void LanderProfiler::writeWord(Print& out, const uint16_t value) {
+    out.write(value & 0xFF);
+    out.write(value >> 8);
+}
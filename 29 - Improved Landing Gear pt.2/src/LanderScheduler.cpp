@@ -0,0 +1,144 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#include "LanderScheduler.h"
+
+// Static member initialization
+LanderTask LanderScheduler::tasks[MAX_TASKS];
+byte LanderScheduler::taskCount = 0;
+unsigned long LanderScheduler::windowStart = 0;
+unsigned long LanderScheduler::busyTime = 0;
+
+bool LanderScheduler::addTask(
+    const __FlashStringHelper* name,
+    void (*callback)(),
+    const unsigned long period_ms,
+    const bool catchUp
+) {
+    if (taskCount >= MAX_TASKS) {
+        return false;
+    }
+
+    LanderTask& task = tasks[taskCount++];
+    task.name = name;
+    task.callback = callback;
+    task.period = period_ms * 1000UL;
+    task.nextRelease = 0;
+    task.catchUp = catchUp;
+
+    return true;
+}
+
+void LanderScheduler::start() {
+    const unsigned long now = micros();
+
+    for (byte i = 0; i < taskCount; i++) {
+        tasks[i].nextRelease = now + tasks[i].period;
+    }
+
+    windowStart = now;
+    resetStatistics();
+}
+
+bool LanderScheduler::runPending() {
+    bool ran = false;
+
+    for (byte i = 0; i < taskCount; i++) {
+        LanderTask& task = tasks[i];
+        byte catchUpRuns = 0;
+
+        // Signed difference keeps the comparison valid when micros() wraps
+        while (static_cast<long>(micros() - task.nextRelease) >= 0) {
+            runTask(task, micros());
+            ran = true;
+
+            const unsigned long behind = micros() - task.nextRelease;
+
+            if (static_cast<long>(behind) < 0) {
+                break;  // Back on schedule
+            }
+
+            // Fixed timestep tasks replay missed releases so the simulation rate
+            // never changes, up to a cap so a slow frame can't spiral.
+            if (task.catchUp && ++catchUpRuns < MAX_CATCH_UP) {
+                continue;
+            }
+
+            // Drop the releases we fell behind on and count them as missed
+            const unsigned long skipped = behind / task.period + 1;
+            task.missed += skipped;
+            task.nextRelease += skipped * task.period;
+        }
+    }
+
+    return ran;
+}
+
+void LanderScheduler::runTask(LanderTask& task, const unsigned long now) {
+    const unsigned long deadline = task.nextRelease + task.period;
+
+    task.callback();
+
+    const unsigned long end = micros();
+    const unsigned long runTime = end - now;
+    const long slack = static_cast<long>(deadline - end);
+
+    task.runs++;
+    busyTime += runTime;
+
+    if (slack < 0) {
+        task.missed++;
+    }
+
+    if (slack < task.minSlack) {
+        task.minSlack = slack;
+    }
+
+    if (runTime > task.maxRunTime) {
+        task.maxRunTime = runTime;
+    }
+
+    task.nextRelease = deadline;
+}
+
+void LanderScheduler::report(Print& out) {
+    const unsigned long now = micros();
+    const unsigned long window = now - windowStart;
+
+    out.print(F("sched "));
+    out.print(window / 1000UL);
+    out.print(F("ms load "));
+    out.print(window ? (busyTime / (window / 100UL + 1)) : 0UL);
+    out.println(F("%"));
+
+    for (byte i = 0; i < taskCount; i++) {
+        const LanderTask& task = tasks[i];
+
+        out.print(F("  "));
+        out.print(task.name);
+        out.print(F(" runs "));
+        out.print(task.runs);
+        out.print(F(" missed "));
+        out.print(task.missed);
+        out.print(F(" slack "));
+        out.print(task.runs ? task.minSlack : 0L);
+        out.print(F("us max "));
+        out.print(task.maxRunTime);
+        out.println(F("us"));
+    }
+
+    windowStart = now;
+    resetStatistics();
+}
+
+void LanderScheduler::resetStatistics() {
+    busyTime = 0;
+
+    for (byte i = 0; i < taskCount; i++) {
+        tasks[i].runs = 0;
+        tasks[i].missed = 0;
+        tasks[i].minSlack = tasks[i].period;
+        tasks[i].maxRunTime = 0;
+    }
+}
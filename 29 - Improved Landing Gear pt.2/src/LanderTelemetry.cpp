@@ -0,0 +1,63 @@
+//
+// Created by ash on 6/15/25.
+//
+
+#include "LanderTelemetry.h"
+
+// Static member initialization
+byte LanderTelemetry::frames[2][BUFFER_SIZE];
+byte LanderTelemetry::frameLength[2] = {0, 0};
+byte LanderTelemetry::sending = 0;
+byte LanderTelemetry::sent = 0;
+bool LanderTelemetry::queued = false;
+uint16_t LanderTelemetry::tick = 0;
+
+void LanderTelemetry::record(const LanderGame& game, const unsigned long tick_us) {
+    if (!TELEMETRY) {
+        return;
+    }
+
+    TelemetryFrame frame;
+    frame.tick = tick++;
+    frame.approach_state = game.getApproachState();
+    frame.gear_index = game.getCurrentGearBitmapIndex();
+    frame.distance_raw = game.getLanderDistanceFixed().toRaw();
+    frame.speed_raw = game.getLanderSpeedFixed().toRaw();
+    frame.x_offset = game.getMotherShipXOffset();
+    frame.y_offset = game.getMotherShipYOffset();
+    frame.tick_us = tick_us > 0xFFFF ? 0xFFFF : tick_us;
+
+    byte payload[LanderTelemetryRecord::PAYLOAD_SIZE];
+    LanderTelemetryRecord::pack(payload, frame);
+    payload[LanderTelemetryRecord::RECORD_SIZE] = LanderTelemetryRecord::crc8(payload, LanderTelemetryRecord::RECORD_SIZE);
+
+    // An older frame still waiting its turn is stale now and is replaced
+    const byte filling = sending ^ 1;
+    frameLength[filling] = LanderTelemetryRecord::encode(payload, sizeof(payload), frames[filling]);
+    queued = true;
+
+    pump();
+}
+
+void LanderTelemetry::pump() {
+    if (!TELEMETRY) {
+        return;
+    }
+
+    if (sent == frameLength[sending]) {
+        if (!queued) {
+            return;
+        }
+        sending ^= 1;
+        sent = 0;
+        queued = false;
+    }
+
+    // The USART interrupt drains Serial's buffer, never block on it here
+    const int room = Serial.availableForWrite();
+    const byte remaining = frameLength[sending] - sent;
+    const byte count = room < remaining ? room : remaining;
+    if (count > 0) {
+        sent += Serial.write(frames[sending] + sent, count);
+    }
+}
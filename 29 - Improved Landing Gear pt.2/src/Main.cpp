@@ -3,78 +3,195 @@
 
 // Classes
 #include "LanderTypes.h"
+#include "LanderConfig.h"
 #include "LanderHardware.h"
 #include "LanderGame.h"
 #include "LanderDisplay.h"
+#include "LanderScheduler.h"
+#include "LanderInputLog.h"
+#include "LanderAutopilot.h"
+#include "LanderProfiler.h"
+#include "LanderTelemetry.h"
+#include "LanderRewind.h"
+#include "LanderInterpolation.h"
+#include "LanderGhost.h"
 
 // Game objects
 LanderGame game;
+LanderRewind rewind_ring;
 
-void setup() {
-  Serial.begin(9600);
-  LanderHardware::init();
+// Game time advances exactly one tick per update, so a replayed log times
+// the approach the same way the device did.
+unsigned long simulation_time = 0;
+
+// Inputs of the latest tick.  The OLED draws the same lever state the game
+// acted on instead of reading the pins again.
+InputFrame input_frame = {};
+
+// State before the latest tick and when that tick finished, so the OLED
+// can draw between the two when INTERPOLATE is on
+LanderSnapshot previous_state = {};
+unsigned long tick_finished = 0;
+
+// When loop() last finished running a task, for the idle time profile
+unsigned long idle_since = 0;
+
+// Advance the game by one fixed simulation tick.
+void simulationTask() {
+  const unsigned long tick_started = TELEMETRY ? micros() : 0;
+  unsigned long started = LanderProfiler::start();
+  input_frame = LanderHardware::readInputFrame();
+  LanderProfiler::stop(PROFILE_INPUT, started);
+
+  // A pressed key always wins over the autopilot.  Logged after, so a
+  // replay flies the autopilot's keys too.
+  if (AUTOPILOT && input_frame.key == UNUSED && input_frame.tap == UNUSED && !input_frame.rewind) {
+    input_frame.key = LanderAutopilot::choose(game);
+  }
+  LanderInputLog::record(input_frame, game);
+
+  simulation_time += SIMULATION_TICK_MS;
+  if (INTERPOLATE) {
+    previous_state = game.save();
+  }
+  const bool was_over = game.isGameOver();
+  started = LanderProfiler::start();
+  if (input_frame.rewind) {
+    rewind_ring.stepBack(game, simulation_time);
+  } else {
+    game.update(input_frame, simulation_time);
+    // Keep the touchdown tick, so rewinding from the ending goes straight
+    // back into the flight
+    if (REWIND && !was_over) {
+      rewind_ring.save(game);
+    }
+  }
+  LanderProfiler::stop(PROFILE_UPDATE, started);
+  LanderGhost::update(game, input_frame.rewind);
+  if (INTERPOLATE) {
+    tick_finished = micros();
+  }
+
+  LanderTelemetry::record(game, TELEMETRY ? micros() - tick_started : 0);
+
+  if (!was_over && game.isGameOver()) {
+    LanderInputLog::dump(Serial);
+  } else if (was_over && !game.isGameOver() && game.getApproachState() == APPROACH_PREFLIGHT) {
+    // Restarted in place, so the last game is out of rewind's reach and
+    // the next dump starts with the new game
+    rewind_ring.clear();
+    LanderInputLog::restart();
+  }
 }
 
-[[noreturn]] void loop() {
-  // Read current values of all of our switches as booleans ("on" is true, "off" is false)
-  const bool thrust_lever = LanderHardware::getThrustLever();
-  const bool systems_lever = LanderHardware::getSystemsLever();
-  const bool confirm_lever = LanderHardware::getConfirmLever();
+// Draw the current game state on the OLED.
+void renderTask() {
+  const LanderView view = INTERPOLATE
+      ? LanderInterpolation::between(previous_state, game, LanderInterpolation::blend(micros() - tick_finished))
+      : LanderInterpolation::at(game);
+
+  // Skip the whole page transfer when nothing visible changed since the last frame
+  const LanderRenderKey key = LanderDisplay::makeRenderKey(
+      game.getApproachState(), input_frame, view, game.isShowingEndingSplash());
 
-  game.update();
+  if (!LanderDisplay::shouldRender(key)) {
+    return;
+  }
 
-  // Update our lander display (OLED) using firstPage()/nextPage() methods which
-  // use a smaller buffer to save memory.  Draw the exact SAME display each time
-  // through this loop!
-  landerDisplay.firstPage();
-  do {
+  // Draw the screen for the current state, once per buffer pass (see LanderOled.h)
+  LanderScreen::render(landerDisplay, [&view] {
     switch (game.getApproachState()) {
       // Display switch status for INIT and PREFLIGHT states.
       case APPROACH_INIT:
       case APPROACH_PREFLIGHT:
-        LanderDisplay::displayPreFlight(
-            game.getApproachState(),
-            thrust_lever,
-            systems_lever,
-            confirm_lever
-        );
+        LanderDisplay::displayPreFlight(game.getApproachState(), input_frame);
         break;
 
+      // Ending screen swaps between the time and outcome splash and the
+      // final radar view, on a timer kept by the game
+      case APPROACH_ENDING:
+        if (game.isShowingEndingSplash()) {
+          LanderDisplay::displayEnding(game.getElapsedTime(), game.getEndingBitmap());
+          break;
+        }
+        [[fallthrough]];
+
       case APPROACH_FINAL:
-        LanderDisplay::displayFinal(game.getCurrentGearBitmapIndex());
-        // FALLTHROUGH to APPROACH_IN_FLIGHT to also display in-flight data
+        LanderDisplay::displayFinal(view.gear_bitmap_index, view.previous_gear_bitmap_index, view.gear_blend);
+        [[fallthrough]];  // Also display in-flight data
 
       case APPROACH_IN_FLIGHT:
         LanderDisplay::displayInFlight(
-            game.getLanderDistance(),
-            game.getLanderSpeed(),
-            game.getMotherShipXOffset(),
-            game.getMotherShipYOffset()
+            view.lander_distance,
+            view.lander_speed,
+            view.mother_ship_x_offset,
+            view.mother_ship_y_offset
         );
+        if (view.ghost_visible) {
+          LanderDisplay::displayGhost(view.ghost_distance, view.ghost_x_offset, view.ghost_y_offset);
+        }
         break;
     }
-  } while (landerDisplay.nextPage());
-
-  LanderHardware::showDistance(game.getLanderDistance());
+  });
+}
 
-  // Determines outcome image
+// Refresh the 7-segment distance counter.
+void distanceTask() {
+  const unsigned long started = LanderProfiler::start();
   if (game.isGameOver()) {
-    LanderHardware::clearDistanceDisplay(); // Show 0 on 7-segment display
-
-    // Calculate elapsed time (in ms) from first thrust.
-    const unsigned long elapsed_time = millis() - game.getApproachStartTime();
-    const unsigned char* endingBitmap = game.getEndingBitmap();
-
-    LanderDisplay::displayEndingScreen(
-        elapsed_time,
-        endingBitmap,
-        game.getCurrentGearBitmapIndex(),
-        game.getLanderDistance(),
-        game.getLanderSpeed(),
-        game.getMotherShipXOffset(),
-        game.getMotherShipYOffset()
-    );
+    LanderHardware::clearDistanceDisplay();
+  } else {
+    LanderHardware::showDistance(game.getLanderDistance());
+  }
+  LanderProfiler::stop(PROFILE_DISTANCE, started);
+}
+
+// Print missed deadlines, per-task slack, how many frames were skipped and
+// how much RAM is left.
+void reportTask() {
+  LanderScheduler::report(Serial);
+  LanderDisplay::reportRenderStats(Serial);
+  LanderHardware::reportKeyStats(Serial);
+  if (REWIND) {
+    Serial.print(F("  rewind "));
+    Serial.print(rewind_ring.getCount());
+    Serial.print(F(" ticks in "));
+    Serial.print(sizeof(rewind_ring));
+    Serial.println(F(" bytes"));
+  }
+  Serial.print(F("  free ram "));
+  Serial.println(LanderHardware::freeMemory());
+}
+
+void setup() {
+  Serial.begin(SERIAL_BAUD);
+  LanderHardware::init();
+
+  // The simulation catches up on missed ticks so the game speed never depends
+  // on render time; the displays just skip frames when they fall behind.
+  LanderScheduler::addTask(F("sim"), simulationTask, SIMULATION_TICK_MS, true);
+  LanderScheduler::addTask(F("oled"), renderTask, RENDER_PERIOD_MS, false);
+  LanderScheduler::addTask(F("7seg"), distanceTask, DISTANCE_PERIOD_MS, false);
+
+  // A text report would corrupt a binary input log or telemetry on Serial
+  if (SCHEDULER_REPORT_MS > 0 && INPUT_LOG != INPUT_LOG_SERIAL && !TELEMETRY) {
+    LanderScheduler::addTask(F("report"), reportTask, SCHEDULER_REPORT_MS, false);
+  }
+
+  LanderInputLog::begin(game);
+  LanderGhost::begin();
+  LanderScheduler::start();
+  idle_since = micros();
+}
+
+void loop() {
+  const unsigned long now = micros();
+
+  if (LanderScheduler::runPending()) {
+    LanderProfiler::record(PROFILE_IDLE, now - idle_since);
+    idle_since = micros();
   }
 
-  delay(100);  // Delay before next loop
+  LanderProfiler::poll(Serial);
+  LanderTelemetry::pump();
 }